@@ -0,0 +1,49 @@
+//------------------------------------------------------------------------------
+//
+// File Name:	Benchmark.h
+// Author(s):	Jonathan Bourim (j.bourim)
+// Date:        10/19/2026
+//
+//------------------------------------------------------------------------------
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+namespace bench
+{
+
+/// \brief Time func over runs, calling reset untimed before each run
+/// \return Median run time in milliseconds
+template <class Reset, class Func>
+double Median(uint32_t runs, Reset&& reset, Func&& func)
+{
+    std::vector<double> times(runs);
+    for (double& time : times)
+    {
+        reset();
+        const auto start = std::chrono::steady_clock::now();
+        func();
+        time = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    std::nth_element(times.begin(), times.begin() + runs / 2, times.end());
+    return times[runs / 2];
+}
+
+inline void PrintHeader(const char* name, const char* countName, uint32_t threads)
+{
+    std::printf("%s, %u threads with the pool\n", name, threads);
+    std::printf("%10s  %-32s %12s %10s\n", countName, "", "median ms", "speedup");
+}
+
+/// \param baseline Time the speedup is relative to
+inline void PrintRow(size_t count, const char* name, double milliseconds, double baseline)
+{
+    std::printf("%10zu  %-32s %12.3f %9.2fx\n", count, name, milliseconds, baseline / milliseconds);
+}
+
+}
@@ -0,0 +1,97 @@
+//------------------------------------------------------------------------------
+//
+// File Name:	FrustumCullingBenchmark.cpp
+// Author(s):	Jonathan Bourim (j.bourim)
+// Date:        10/19/2026
+//
+//------------------------------------------------------------------------------
+#include "Damascus.hpp"
+#include <glm/gtc/matrix_transform.hpp>
+#include "Benchmark.h"
+
+using namespace dm;
+
+int main()
+{
+    constexpr uint32_t counts[] = { 100000, 1000000 };
+    constexpr uint32_t runs = 15;
+
+    ThreadPool pool;
+    pool.Create();
+    std::mt19937 random(1234);
+
+    // Objects fill a cube around the camera, most fall outside its view
+    const glm::mat4 projection = glm::perspective(glm::radians(90.0f), 16.0f / 9.0f, 0.1f, 500.0f);
+    const glm::mat4 view = glm::lookAt(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    const Frustum frustum = Frustum::FromMatrix(projection * view);
+    std::uniform_real_distribution<float> position(-500.0f, 500.0f);
+    std::uniform_real_distribution<float> size(0.5f, 4.0f);
+
+    std::printf("FrustumCullWidth %u\n", FrustumCullWidth());
+    bench::PrintHeader("FrustumCull", "objects", pool.GetConcurrency());
+    for (uint32_t count : counts)
+    {
+        std::vector<primitives::Box> boxes(count);
+        std::vector<primitives::Sphere> spheres(count);
+        BoxBounds boxBounds;
+        SphereBounds sphereBounds;
+        boxBounds.Reserve(count);
+        sphereBounds.Reserve(count);
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            const glm::vec3 center(position(random), position(random), position(random));
+            boxes[i] = { center, glm::vec3(size(random), size(random), size(random)) };
+            spheres[i] = { size(random), center };
+            boxBounds.Add(boxes[i]);
+            sphereBounds.Add(spheres[i]);
+        }
+
+        std::vector<uint32_t> expected;
+        std::vector<uint32_t> visible;
+        bool matches = true;
+        auto reset = []() {};
+
+        const double boxLoop = bench::Median(runs, reset, [&]()
+        {
+            expected.clear();
+            for (uint32_t i = 0; i < count; ++i)
+            {
+                if (frustum.IntersectsBox(boxes[i].position, boxes[i].halfExtent))
+                    expected.push_back(i);
+            }
+        });
+        const double boxCull = bench::Median(runs, reset, [&]() { FrustumCull(frustum, boxBounds, visible); });
+        matches &= visible == expected;
+        const double boxPool = bench::Median(runs, reset, [&]() { FrustumCull(frustum, boxBounds, visible, &pool); });
+        matches &= visible == expected;
+
+        const double sphereLoop = bench::Median(runs, reset, [&]()
+        {
+            expected.clear();
+            for (uint32_t i = 0; i < count; ++i)
+            {
+                if (frustum.IntersectsSphere(spheres[i].position, spheres[i].radius))
+                    expected.push_back(i);
+            }
+        });
+        const double sphereCull = bench::Median(runs, reset, [&]() { FrustumCull(frustum, sphereBounds, visible); });
+        matches &= visible == expected;
+        const double spherePool = bench::Median(runs, reset, [&]() { FrustumCull(frustum, sphereBounds, visible, &pool); });
+        matches &= visible == expected;
+
+        bench::PrintRow(count, "Frustum::IntersectsBox loop", boxLoop, boxLoop);
+        bench::PrintRow(count, "FrustumCull, boxes", boxCull, boxLoop);
+        bench::PrintRow(count, "FrustumCull, boxes, pool", boxPool, boxLoop);
+        bench::PrintRow(count, "Frustum::IntersectsSphere loop", sphereLoop, sphereLoop);
+        bench::PrintRow(count, "FrustumCull, spheres", sphereCull, sphereLoop);
+        bench::PrintRow(count, "FrustumCull, spheres, pool", spherePool, sphereLoop);
+        if (!matches)
+        {
+            std::printf("FrustumCull disagrees with the scalar tests for %u objects\n", count);
+            return 1;
+        }
+    }
+
+    pool.Destroy();
+    return 0;
+}
@@ -0,0 +1,84 @@
+//------------------------------------------------------------------------------
+//
+// File Name:	RadixSortBenchmark.cpp
+// Author(s):	Jonathan Bourim (j.bourim)
+// Date:        10/19/2026
+//
+//------------------------------------------------------------------------------
+#include "Damascus.hpp"
+#include "Benchmark.h"
+
+using namespace dm;
+
+namespace
+{
+
+// Opaque keys spread over a scene's worth of pipelines, materials, meshes and depths
+std::vector<RenderSortEntry> MakeEntries(size_t count, std::mt19937& random)
+{
+    std::uniform_int_distribution<uint32_t> pipeline(0, 31);
+    std::uniform_int_distribution<uint32_t> material(0, 1023);
+    std::uniform_int_distribution<uint32_t> mesh(0, 255);
+    std::uniform_real_distribution<float> depth(0.1f, 1000.0f);
+
+    std::vector<RenderSortEntry> entries(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        entries[i].key = OpaqueSortKey((uint8_t) pipeline(random), (uint16_t) material(random),
+                                       (uint8_t) mesh(random), depth(random));
+        entries[i].index = (uint32_t) i;
+    }
+    return entries;
+}
+
+bool IsSorted(const std::vector<RenderSortEntry>& entries)
+{
+    return std::is_sorted(entries.begin(), entries.end(), [](const RenderSortEntry& a, const RenderSortEntry& b)
+    {
+        return a.key.key < b.key.key;
+    });
+}
+
+}
+
+int main()
+{
+    constexpr size_t counts[] = { 10000, 100000, 1000000 };
+    constexpr uint32_t runs = 15;
+
+    ThreadPool pool;
+    pool.Create();
+    std::mt19937 random(1234);
+
+    bench::PrintHeader("RadixSort", "keys", pool.GetConcurrency());
+    for (size_t count : counts)
+    {
+        const std::vector<RenderSortEntry> source = MakeEntries(count, random);
+        std::vector<RenderSortEntry> entries;
+        std::vector<RenderSortEntry> scratch;
+        bool sorted = true;
+
+        auto reset = [&]() { entries = source; };
+        auto compare = [](const RenderSortEntry& a, const RenderSortEntry& b) { return a.key.key < b.key.key; };
+
+        const double sort = bench::Median(runs, reset, [&]() { std::sort(entries.begin(), entries.end(), compare); });
+        const double stableSort = bench::Median(runs, reset, [&]() { std::stable_sort(entries.begin(), entries.end(), compare); });
+        const double radix = bench::Median(runs, reset, [&]() { RadixSort(entries, scratch, OpaqueSortKeyLayout::usedMask); });
+        sorted &= IsSorted(entries);
+        const double radixPool = bench::Median(runs, reset, [&]() { RadixSort(entries, scratch, OpaqueSortKeyLayout::usedMask, &pool); });
+        sorted &= IsSorted(entries);
+
+        bench::PrintRow(count, "std::sort", sort, sort);
+        bench::PrintRow(count, "std::stable_sort", stableSort, sort);
+        bench::PrintRow(count, "RadixSort", radix, sort);
+        bench::PrintRow(count, "RadixSort, pool", radixPool, sort);
+        if (!sorted)
+        {
+            std::printf("RadixSort produced unsorted output for %zu keys\n", count);
+            return 1;
+        }
+    }
+
+    pool.Destroy();
+    return 0;
+}
@@ -0,0 +1,95 @@
+# Embeds SPIR-V shaders into a target, letting ShaderModule::Load and ReadShader
+# resolve them from memory instead of loose files.
+#
+#   damascus_embed_shaders(<target> [BASE_DIR <dir>] SHADERS <files...>)
+#
+# .spv files are embedded as is, GLSL sources (.vert, .frag, ...) are compiled first.
+# Shaders are registered under their path relative to BASE_DIR (compiled sources gain
+# a .spv suffix), which should match the path passed to Load/ReadShader at runtime.
+#
+# Only the SPIR-V and its stage are baked in. Descriptor set layouts, push constants,
+# vertex inputs and specialization constants are still reflected when the pipeline
+# reads its shaders, from the embedded words rather than from disk.
+
+# Cached so the function can find the script when called from any directory
+set(DAMASCUS_EMBED_SCRIPT ${CMAKE_CURRENT_LIST_DIR}/EmbedSpirv.cmake CACHE INTERNAL "")
+
+find_program(DAMASCUS_GLSL_COMPILER
+    NAMES glslc glslangValidator
+    HINTS $ENV{VULKAN_SDK}/bin $ENV{VULKAN_SDK}/Bin
+    )
+
+function(damascus_embed_shaders TARGET)
+    cmake_parse_arguments(EMBED "" "BASE_DIR" "SHADERS" ${ARGN})
+    if (NOT EMBED_BASE_DIR)
+        set(EMBED_BASE_DIR ${CMAKE_CURRENT_SOURCE_DIR})
+    endif()
+
+    set(OUTPUT_DIR ${CMAKE_CURRENT_BINARY_DIR}/EmbeddedShaders/${TARGET})
+    set(BLOBS "")
+    set(KEYS "")
+
+    foreach(SHADER ${EMBED_SHADERS})
+        get_filename_component(SHADER_PATH ${SHADER} ABSOLUTE BASE_DIR ${EMBED_BASE_DIR})
+        file(RELATIVE_PATH KEY ${EMBED_BASE_DIR} ${SHADER_PATH})
+        get_filename_component(EXTENSION ${SHADER_PATH} EXT)
+
+        if (EXTENSION MATCHES "\\.spv$")
+            set(SPIRV ${SHADER_PATH})
+        else()
+            if (NOT DAMASCUS_GLSL_COMPILER)
+                message(FATAL_ERROR "No GLSL compiler found to compile ${SHADER}, install the Vulkan SDK or embed the .spv")
+            endif()
+
+            set(KEY "${KEY}.spv")
+            set(SPIRV ${OUTPUT_DIR}/${KEY})
+            get_filename_component(SPIRV_DIR ${SPIRV} DIRECTORY)
+            get_filename_component(COMPILER_NAME ${DAMASCUS_GLSL_COMPILER} NAME_WE)
+            if (COMPILER_NAME STREQUAL "glslangValidator")
+                set(COMPILE_FLAGS -V)
+            else()
+                set(COMPILE_FLAGS "")
+            endif()
+
+            # Task and mesh shaders (VK_EXT_mesh_shader) require SPIR-V 1.4
+            if (EXTENSION MATCHES "\\.(task|mesh)$")
+                if (COMPILER_NAME STREQUAL "glslangValidator")
+                    list(APPEND COMPILE_FLAGS --target-env spirv1.4)
+                else()
+                    list(APPEND COMPILE_FLAGS --target-spv=spv1.4)
+                endif()
+            endif()
+
+            add_custom_command(
+                OUTPUT ${SPIRV}
+                COMMAND ${CMAKE_COMMAND} -E make_directory ${SPIRV_DIR}
+                COMMAND ${DAMASCUS_GLSL_COMPILER} ${COMPILE_FLAGS} ${SHADER_PATH} -o ${SPIRV}
+                DEPENDS ${SHADER_PATH}
+                COMMENT "Compiling shader ${KEY}"
+                VERBATIM
+                )
+        endif()
+
+        list(APPEND BLOBS ${SPIRV})
+        list(APPEND KEYS ${KEY})
+    endforeach()
+
+    # Lists are passed through | since ; would split the command arguments
+    string(REPLACE ";" "|" BLOB_ARG "${BLOBS}")
+    string(REPLACE ";" "|" KEY_ARG "${KEYS}")
+
+    set(INL ${OUTPUT_DIR}/EmbeddedShaders.inl)
+    add_custom_command(
+        OUTPUT ${INL}
+        COMMAND ${CMAKE_COMMAND} -DOUTPUT=${INL} -DBLOBS=${BLOB_ARG} -DKEYS=${KEY_ARG} -P ${DAMASCUS_EMBED_SCRIPT}
+        DEPENDS ${BLOBS} ${DAMASCUS_EMBED_SCRIPT}
+        COMMENT "Embedding shaders into ${TARGET}"
+        VERBATIM
+        )
+
+    # Custom command outputs are directory scoped, route them through a target so any target may embed
+    add_custom_target(${TARGET}EmbeddedShaders DEPENDS ${INL})
+    add_dependencies(${TARGET} ${TARGET}EmbeddedShaders)
+    target_include_directories(${TARGET} PRIVATE ${OUTPUT_DIR})
+    target_compile_definitions(${TARGET} PRIVATE DM_EMBEDDED_SHADERS)
+endfunction()
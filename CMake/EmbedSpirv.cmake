@@ -0,0 +1,57 @@
+# Script mode (cmake -P) half of damascus_embed_shaders.
+# Writes OUTPUT, an .inl defining each blob as an aligned constexpr array along with its registration.
+#   OUTPUT  Generated .inl
+#   BLOBS   | separated SPIR-V files
+#   KEYS    | separated paths each blob is registered under
+
+string(REPLACE "|" ";" BLOBS "${BLOBS}")
+string(REPLACE "|" ";" KEYS "${KEYS}")
+
+set(CONTENT "// Generated by EmbedSpirv.cmake, do not edit\n\nnamespace dm::embedded\n{\n\n")
+set(REGISTRATION "")
+
+list(LENGTH BLOBS COUNT)
+math(EXPR LAST "${COUNT} - 1")
+foreach(I RANGE ${LAST})
+    list(GET BLOBS ${I} BLOB)
+    list(GET KEYS ${I} KEY)
+
+    file(READ ${BLOB} HEX HEX)
+    string(LENGTH "${HEX}" HEX_LENGTH)
+    math(EXPR REMAINDER "${HEX_LENGTH} % 8")
+    if (HEX_LENGTH EQUAL 0 OR NOT REMAINDER EQUAL 0)
+        message(FATAL_ERROR "${BLOB} isn't a valid SPIR-V module")
+    endif()
+
+    # SPIR-V is a stream of little endian words
+    string(REGEX REPLACE "([0-9a-f][0-9a-f])([0-9a-f][0-9a-f])([0-9a-f][0-9a-f])([0-9a-f][0-9a-f])" "0x\\4\\3\\2\\1, " WORDS "${HEX}")
+    string(REGEX REPLACE "((0x[0-9a-f]+, ){8})" "\\1\n    " WORDS "${WORDS}")
+    string(REGEX REPLACE " +\n" "\n" WORDS "${WORDS}")
+    string(REGEX REPLACE ", $" "," WORDS "${WORDS}")
+
+    # Stage is known ahead of time from the source extension, otherwise it's left for reflection
+    set(STAGE "{}")
+    if (KEY MATCHES "\\.vert(\\.spv)?$")
+        set(STAGE "vk::ShaderStageFlagBits::eVertex")
+    elseif (KEY MATCHES "\\.frag(\\.spv)?$")
+        set(STAGE "vk::ShaderStageFlagBits::eFragment")
+    elseif (KEY MATCHES "\\.comp(\\.spv)?$")
+        set(STAGE "vk::ShaderStageFlagBits::eCompute")
+    elseif (KEY MATCHES "\\.geom(\\.spv)?$")
+        set(STAGE "vk::ShaderStageFlagBits::eGeometry")
+    elseif (KEY MATCHES "\\.tesc(\\.spv)?$")
+        set(STAGE "vk::ShaderStageFlagBits::eTessellationControl")
+    elseif (KEY MATCHES "\\.tese(\\.spv)?$")
+        set(STAGE "vk::ShaderStageFlagBits::eTessellationEvaluation")
+    endif()
+
+    string(APPEND CONTENT "// ${KEY}\nalignas(16) static constexpr uint32_t shader${I}[] = {\n    ${WORDS}\n};\n\n")
+    string(APPEND REGISTRATION "static const EmbeddedShaderRegistrar registrar${I}(\"${KEY}\", shader${I}, sizeof(shader${I}) / sizeof(uint32_t), ${STAGE});\n")
+endforeach()
+
+string(APPEND CONTENT "${REGISTRATION}\n}\n")
+
+# Only touch the output when it changes, avoiding a rebuild of the unity build
+file(WRITE ${OUTPUT}.tmp "${CONTENT}")
+execute_process(COMMAND ${CMAKE_COMMAND} -E copy_if_different ${OUTPUT}.tmp ${OUTPUT})
+file(REMOVE ${OUTPUT}.tmp)
@@ -17,22 +17,41 @@
 // clang-format off
 #include "Renderer/Renderer.cpp"
 #include "Sorting/RenderSortKey.cpp"
+#include "Sorting/RadixSort.cpp"
+#include "Sorting/DrawBucket.cpp"
+#include "Threading/ThreadPool.cpp"
 #include "Window/Window.cpp"
 #include "InternalStructures/Model.cpp"
 #include "InternalStructures/Vertex.cpp"
 #include "InternalStructures/Mesh.cpp"
 #include "InternalStructures/Buffer.cpp"
+#include "InternalStructures/UploadBatch.cpp"
+#include "Geometry/GeometryPool.cpp"
+#include "Geometry/MeshOptimizer.cpp"
+#include "Geometry/MeshSimplifier.cpp"
+#include "Geometry/Meshlets.cpp"
+#include "Geometry/StaticBatch.cpp"
 #include "InternalStructures/Device.cpp"
 #include "InternalStructures/PhysicalDevice.cpp"
 #include "InternalStructures/Instance.cpp"
 #include "InternalStructures/Swapchain.cpp"
 #include "InternalStructures/ImageView.cpp"
 #include "InternalStructures/RenderPass.cpp"
+#include "InternalStructures/EmbeddedShader.cpp"
 #include "InternalStructures/ShaderModule.cpp"
+#include "InternalStructures/ShaderReflection.cpp"
+#include "InternalStructures/PipelineLibrary.cpp"
 #include "InternalStructures/Pipeline.cpp"
+#include "Culling/Frustum.cpp"
+#include "Culling/FrustumCulling.cpp"
+#include "Culling/OcclusionCulling.cpp"
+#include "Culling/GpuScene.cpp"
+#include "Culling/MeshletCulling.cpp"
 #include "InternalStructures/Texture.cpp"
 #include "InternalStructures/CommandBuffer.cpp"
+#include "InternalStructures/CommandRecorder.cpp"
 #include "InternalStructures/CommandPool.cpp"
+#include "InternalStructures/RecordCache.cpp"
 #include "InternalStructures/Semaphore.cpp"
 #include "InternalStructures/Fence.cpp"
 #include "InternalStructures/Descriptors.cpp"
@@ -40,4 +59,12 @@
 #include "InternalStructures/FrameBufferAttachment.cpp"
 #include "Camera/Camera.cpp"
 #include "Primitives/Primitives.cpp"
+#include "Assets/AssetLoader.cpp"
+// Includes platform headers, kept last
+#include "Geometry/MeshCache.cpp"
 // clang-format on
+
+// Generated by damascus_embed_shaders
+#ifdef DM_EMBEDDED_SHADERS
+#include "EmbeddedShaders.inl"
+#endif
@@ -0,0 +1,118 @@
+//------------------------------------------------------------------------------
+//
+// File Name:	AssetLoader.cpp
+// Author(s):	Jonathan Bourim (j.bourim)
+// Date:        10/19/2026
+//
+//------------------------------------------------------------------------------
+
+#include "AssetLoader.h"
+
+namespace dm
+{
+
+AssetLoader::~AssetLoader() noexcept
+{
+    Destroy();
+}
+
+void AssetLoader::Create(Device* inOwner, ThreadPool& inPool, vk::DeviceSize inUploadBudget)
+{
+    Destroy();
+    IOwned::CreateOwned(inOwner);
+    pool = &inPool;
+    uploadBudget = inUploadBudget;
+
+    const uint8_t white[4] = { 255, 255, 255, 255 };
+    placeholderTexture.Create(white, 1, 1, owner);
+}
+
+void AssetLoader::Destroy()
+{
+    if (!created)
+        return;
+
+    // Workers write into the pending resources, which are released with the entries
+    for (Pending& load : pending)
+        load.decoded.wait();
+    pending.clear();
+
+    // Destroying the batches waits on their fences
+    inFlight.clear();
+
+    placeholderMeshes.clear();
+    placeholderTexture.Destroy();
+    pool = nullptr;
+    created = false;
+}
+
+AssetHandle<Texture> AssetLoader::LoadTexture(const std::string& path)
+{
+    auto slot = std::make_shared<AssetSlot<Texture>>();
+    slot->placeholder = &placeholderTexture;
+
+    Texture* texture = &slot->resource;
+    Device* device = owner;
+    Pending load;
+    load.decoded = pool->Submit([texture, path]() { return texture->Decode(path); });
+    load.upload = [texture, device](UploadBatch& batch) { texture->Create(batch, device); };
+    load.status = slot;
+    pending.push_back(std::move(load));
+    return AssetHandle<Texture>(std::move(slot));
+}
+
+void AssetLoader::Update()
+{
+    for (auto it = inFlight.begin(); it != inFlight.end();)
+    {
+        if (!it->batch->IsComplete())
+        {
+            ++it;
+            continue;
+        }
+
+        for (auto& asset : it->assets)
+            asset->state = AssetState::Ready;
+        it = inFlight.erase(it);
+    }
+
+    // Decoded assets are uploaded in request order until the frame's budget is spent
+    std::unique_ptr<UploadBatch> batch;
+    std::vector<std::shared_ptr<AssetStatus>> uploaded;
+    for (auto it = pending.begin(); it != pending.end();)
+    {
+        if (batch != nullptr && batch->StagedBytes() >= uploadBudget)
+            break;
+        if (it->decoded.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+        {
+            ++it;
+            continue;
+        }
+
+        if (!it->decoded.get())
+        {
+            it->status->state = AssetState::Failed;
+        }
+        // Only the loader holds assets whose handles were all released
+        else if (it->status.use_count() > 1)
+        {
+            if (batch == nullptr)
+            {
+                batch = std::make_unique<UploadBatch>();
+                batch->Create(owner);
+            }
+            it->upload(*batch);
+            it->status->state = AssetState::Uploading;
+            uploaded.push_back(std::move(it->status));
+        }
+        it = pending.erase(it);
+    }
+
+    if (batch != nullptr)
+    {
+        batch->Submit();
+        inFlight.push_back({ std::move(batch), std::move(uploaded) });
+    }
+}
+
+}
@@ -0,0 +1,169 @@
+//------------------------------------------------------------------------------
+//
+// File Name:	AssetLoader.h
+// Author(s):	Jonathan Bourim (j.bourim)
+// Date:        10/19/2026
+//
+//------------------------------------------------------------------------------
+#pragma once
+
+namespace dm
+{
+
+enum class AssetState : uint32_t
+{
+    Loading,        //< Being read and decoded on a worker thread
+    Uploading,      //< Recorded into a submitted upload batch
+    Ready,
+    Failed          //< The source couldn't be read, the placeholder is kept
+};
+
+// Shared by an asset's handles and the loader advancing it
+struct AssetStatus
+{
+    std::atomic<AssetState> state = { AssetState::Loading };
+};
+
+template<class Resource>
+struct AssetSlot : AssetStatus
+{
+    Resource resource;
+    Resource* placeholder = nullptr;
+};
+
+/**
+ * Reference to a resource loading in the background, shared by copies of the handle.
+ * Until the resource's upload completes, Get returns the loader's placeholder,
+ * so handles can be drawn from the frame they are requested.
+ */
+template<class Resource>
+class AssetHandle
+{
+public:
+    AssetHandle() = default;
+    explicit AssetHandle(std::shared_ptr<AssetSlot<Resource>> inSlot) : slot(std::move(inSlot)) {}
+
+    [[nodiscard]] bool IsValid() const { return slot != nullptr; }
+    [[nodiscard]] AssetState GetState() const { return slot->state; }
+    [[nodiscard]] bool IsReady() const { return GetState() == AssetState::Ready; }
+
+    /// \brief The resource once ready, otherwise the placeholder
+    [[nodiscard]] Resource& Get() const { return IsReady() ? slot->resource : *slot->placeholder; }
+    Resource* operator->() const { return &Get(); }
+
+private:
+    std::shared_ptr<AssetSlot<Resource>> slot;
+};
+
+/**
+ * Streams models and textures in without stalling the frame loop.
+ * Files are parsed and decoded on the thread pool; once decoded, Update records their uploads
+ * into an UploadBatch per frame, up to a budget of staged bytes, and marks them ready
+ * when the batch's fence signals. Nothing waits on the GPU along the way.
+ *
+ * Loads are requested and Update is called from the render thread.
+ * Assets whose handles are all released before their upload are dropped.
+ */
+class AssetLoader : public IOwned<Device>
+{
+public:
+DM_TYPE_OWNED_BODY(AssetLoader, IOwned<Device>)
+    ~AssetLoader() noexcept override;
+
+    static constexpr vk::DeviceSize defaultUploadBudget = 32ull * 1024 * 1024;
+
+    /// \param uploadBudget Bytes staged per frame, a single larger asset is still uploaded on its own
+    void Create(Device* inOwner, ThreadPool& inPool, vk::DeviceSize inUploadBudget = defaultUploadBudget);
+
+    /// \brief Wait for outstanding decodes and uploads, then release the placeholders
+    void Destroy();
+
+    /// \brief Load the model at path through its MeshCache file, see MeshCache::LoadModel.
+    ///        Meshes get their own buffers, pooled meshes are created synchronously through MeshCache.
+    template<class VertexType>
+    AssetHandle<Mesh<VertexType>> LoadModel(const std::string& path, uint32_t optimize = MeshOptimizeAll,
+                                            const MeshLodSettings& lodSettings = {})
+    {
+        struct Import
+        {
+            typename Mesh<VertexType>::Data data;
+            std::vector<LodRange> lods;
+        };
+
+        auto slot = std::make_shared<AssetSlot<Mesh<VertexType>>>();
+        slot->placeholder = &GetPlaceholderMesh<VertexType>();
+        auto import = std::make_shared<Import>();
+
+        ThreadPool* workers = pool;
+        Pending load;
+        load.decoded = pool->Submit([import, path, optimize, lodSettings, workers]()
+        {
+            // A missing or unreadable model fails the slot rather than asserting on the worker
+            return MeshCache::Import<VertexType>(path, import->data, import->lods, workers, optimize, lodSettings)
+                   && !import->data.vertices.empty();
+        });
+
+        Mesh<VertexType>* mesh = &slot->resource;
+        load.upload = [mesh, import](UploadBatch& batch)
+        {
+            const typename Mesh<VertexType>::View view = {
+                import->data.vertices.data(), (uint32_t) import->data.vertices.size(),
+                import->data.indices.data(), (uint32_t) import->data.indices.size()
+            };
+            mesh->Create(view, batch);
+            mesh->SetLods(std::move(import->lods));
+        };
+        load.status = slot;
+        pending.push_back(std::move(load));
+        return AssetHandle<Mesh<VertexType>>(std::move(slot));
+    }
+
+    /// \brief Load the image at path as an RGBA8 texture, see Texture::Create
+    AssetHandle<Texture> LoadTexture(const std::string& path);
+
+    /// \brief Advance loads once per frame: complete finished uploads and submit the next batch
+    void Update();
+
+    /// \brief Degenerate mesh drawn in place of loading meshes of VertexType
+    template<class VertexType>
+    Mesh<VertexType>& GetPlaceholderMesh()
+    {
+        std::shared_ptr<void>& placeholder = placeholderMeshes[std::type_index(typeid(VertexType))];
+        if (placeholder == nullptr)
+        {
+            auto mesh = std::make_shared<Mesh<VertexType>>();
+            mesh->Create(std::vector<VertexType>(3), { 0, 1, 2 }, owner);
+            placeholder = mesh;
+        }
+        return *static_cast<Mesh<VertexType>*>(placeholder.get());
+    }
+
+    /// \brief Opaque white texture sampled in place of loading textures
+    Texture& GetPlaceholderTexture() { return placeholderTexture; }
+
+    /// \brief Assets still decoding or waiting for upload budget
+    [[nodiscard]] size_t PendingCount() const { return pending.size(); }
+
+private:
+    struct Pending
+    {
+        std::future<bool> decoded;                      //< False if the source couldn't be read
+        std::function<void(UploadBatch&)> upload;       //< Creates the resource, recording its copies
+        std::shared_ptr<AssetStatus> status;
+    };
+
+    struct InFlight
+    {
+        std::unique_ptr<UploadBatch> batch;
+        std::vector<std::shared_ptr<AssetStatus>> assets;
+    };
+
+    ThreadPool* pool = nullptr;
+    vk::DeviceSize uploadBudget = defaultUploadBudget;
+    std::vector<Pending> pending;                       //< In request order
+    std::vector<InFlight> inFlight;
+    std::unordered_map<std::type_index, std::shared_ptr<void>> placeholderMeshes;
+    Texture placeholderTexture;
+};
+
+}
@@ -0,0 +1,242 @@
+//------------------------------------------------------------------------------
+//
+// File Name:	IndirectDrawBuilder.h
+// Author(s):	Jonathan Bourim (j.bourim)
+// Date:		10/19/2026
+//
+//------------------------------------------------------------------------------
+
+#pragma once
+
+namespace dm
+{
+
+/// \brief Collects indexed mesh draws into persistently mapped indirect buffers, issuing one
+///        multi-draw indirect per run of draws sharing a pipeline, descriptor set and geometry buffers.
+///        Pooled meshes of one vertex type share their buffers, so any number of them form a single batch.
+///
+///        Each draw's DrawData is written to a per-frame storage buffer (GetDrawDataBufferInfo) at the
+///        draw's index, which is passed as firstInstance: the vertex shader reads its data at gl_InstanceIndex.
+///        Without multiDrawIndirect, each batch is issued as a loop of single indirect draws.
+template<class DrawData>
+class IndirectDrawBuilder : public IOwned<Device>
+{
+public:
+DM_TYPE_OWNED_BODY(IndirectDrawBuilder<DrawData>, IOwned<Device>)
+    static_assert(std::is_trivially_copyable<DrawData>::value, "Draw data is copied directly into the draw data buffer");
+
+    /// \brief State a batch is recorded with, draws only batch with others of equal state
+    struct State
+    {
+        vk::Pipeline pipeline = {};             //< Bound before the batch, null if the caller binds it
+        vk::PipelineLayout layout = {};
+        vk::DescriptorSet set = {};             //< Bound at setIndex before the batch, null if the caller binds it
+        std::uint32_t setIndex = 0;
+
+        bool operator==(const State& other) const
+        {
+            return pipeline == other.pipeline && layout == other.layout && set == other.set && setIndex == other.setIndex;
+        }
+    };
+
+    struct Stats
+    {
+        std::uint32_t draws = 0;        //< Draws submitted in the last Record
+        std::uint32_t batches = 0;      //< Runs of draws sharing state and geometry
+        std::uint32_t calls = 0;        //< Indirect draw calls recorded
+    };
+
+    ~IndirectDrawBuilder() noexcept override
+    {
+        Destroy();
+    }
+
+    /// \param inMaxDraws Draws each frame holds, fixed so descriptors written with GetDrawDataBufferInfo stay valid
+    void Create(Device* inOwner, std::uint32_t inMaxDraws)
+    {
+        Destroy();
+        IOwned::CreateOwned(inOwner);
+        maxDraws = inMaxDraws;
+
+        const vk::PhysicalDeviceFeatures& features = OwnerGet<PhysicalDevice>().supportedFeatures;
+        DM_ASSERT_MSG(features.drawIndirectFirstInstance,
+                      "Indirect draw building requires drawIndirectFirstInstance to pass draw indices");
+        useMultiDraw = features.multiDrawIndirect;
+        maxDrawsPerCall = useMultiDraw ? OwnerGet<PhysicalDevice>().properties.limits.maxDrawIndirectCount : 1;
+
+        frames.resize(owner->ImageCount());
+        for (Frame& frame : frames)
+        {
+            CreateBuffer(frame.commands, sizeof(vk::DrawIndexedIndirectCommand) * (vk::DeviceSize) maxDraws,
+                         vk::BufferUsageFlagBits::eIndirectBuffer);
+            CreateBuffer(frame.drawData, sizeof(DrawData) * (vk::DeviceSize) maxDraws,
+                         vk::BufferUsageFlagBits::eStorageBuffer);
+        }
+    }
+
+    void Destroy()
+    {
+        if (!created)
+            return;
+
+        frames.clear();
+        draws.clear();
+        drawData.clear();
+        order.clear();
+        created = false;
+    }
+
+    /// \brief Start a frame, discarding the previous frame's draws.
+    ///        The image's previous submission must have completed, its buffers are rewritten.
+    void Begin(int imageIndex)
+    {
+        DM_ASSERT_MSG(imageIndex >= 0 && imageIndex < (int) frames.size(), "Image index out of range of the indirect buffers");
+        frameIndex = imageIndex;
+        recorded = false;
+        draws.clear();
+        drawData.clear();
+        order.clear();
+    }
+
+    /// \brief Add an indexed draw of mesh.
+    /// \param key Sorts draws before batching, keys grouping equal state and vertex types batch best
+    /// \param lod Detail level drawn, see LodSelector
+    template<class VertexType>
+    void Add(RenderSortKey key, const State& state, const Mesh<VertexType>& mesh, const DrawData& data, uint32_t lod = 0)
+    {
+        DM_ASSERT_MSG(!recorded, "Indirect draw builder must begin a new frame before adding draws");
+        DM_ASSERT_MSG(draws.size() < maxDraws, "Indirect draw builder capacity exceeded");
+        DM_ASSERT_MSG(mesh.GetIndexCount() > 0, "Indirect draws must be indexed");
+
+        Draw draw;
+        draw.state = state;
+        draw.vertexBuffer = mesh.GetVertexBufferHandle();
+        draw.attributeBuffer = mesh.GetAttributeBufferHandle();
+        draw.indexBuffer = mesh.GetIndexBufferHandle();
+        draw.indexType = mesh.GetIndexType();
+        draw.command = vk::DrawIndexedIndirectCommand(mesh.GetLodIndexCount(lod), 1, mesh.GetLodFirstIndex(lod),
+                                                      (std::int32_t) mesh.GetVertexOffset(), 0);
+        draws.push_back(draw);
+        drawData.push_back(data);
+        order.push_back({ key, static_cast<std::uint32_t>(draws.size() - 1) });
+    }
+
+    /// \brief Write the frame's indirect and draw data buffers, then record the batches.
+    ///        Once per frame, inside a render pass.
+    /// \param pool Optional thread pool to sort with
+    void Record(CommandRecorder& recorder, ThreadPool* pool = nullptr)
+    {
+        DM_ASSERT_MSG(!recorded, "Indirect draw builder can only record once per frame");
+        recorded = true;
+
+        stats = {};
+        if (order.empty())
+            return;
+
+        RadixSort(order, sortScratch, ~std::uint64_t(0), pool);
+
+        Frame& frame = frames[frameIndex];
+        auto* commands = static_cast<vk::DrawIndexedIndirectCommand*>(frame.commands.allocationInfo.pMappedData);
+        auto* mappedData = static_cast<DrawData*>(frame.drawData.allocationInfo.pMappedData);
+        const auto count = static_cast<std::uint32_t>(order.size());
+        for (std::uint32_t i = 0; i < count; ++i)
+        {
+            commands[i] = draws[order[i].index].command;
+            commands[i].firstInstance = i;
+            mappedData[i] = drawData[order[i].index];
+        }
+        vmaFlushAllocation(owner->allocator, frame.commands.allocation, 0, sizeof(vk::DrawIndexedIndirectCommand) * count);
+        vmaFlushAllocation(owner->allocator, frame.drawData.allocation, 0, sizeof(DrawData) * count);
+
+        const std::uint32_t stride = sizeof(vk::DrawIndexedIndirectCommand);
+        std::uint32_t first = 0;
+        while (first < count)
+        {
+            const Draw& draw = draws[order[first].index];
+            std::uint32_t last = first + 1;
+            while (last < count
+                   && draws[order[last].index].state == draw.state
+                   && draws[order[last].index].vertexBuffer == draw.vertexBuffer
+                   && draws[order[last].index].attributeBuffer == draw.attributeBuffer
+                   && draws[order[last].index].indexBuffer == draw.indexBuffer)
+            {
+                ++last;
+            }
+
+            if (draw.state.pipeline)
+                recorder.BindPipeline(draw.state.pipeline, draw.state.layout);
+            if (draw.state.set)
+                recorder.BindDescriptorSet(draw.state.layout, draw.state.setIndex, draw.state.set);
+            recorder.BindVertexBuffer(VertexStream, draw.vertexBuffer);
+            if (draw.attributeBuffer)
+                recorder.BindVertexBuffer(AttributeStream, draw.attributeBuffer);
+            recorder.BindIndexBuffer(draw.indexBuffer, 0, draw.indexType);
+
+            for (std::uint32_t call = first; call < last; call += maxDrawsPerCall)
+            {
+                const std::uint32_t callCount = std::min(last - call, maxDrawsPerCall);
+                recorder.DrawIndexedIndirect(frame.commands.VkType(), (vk::DeviceSize) stride * call, callCount, stride);
+                ++stats.calls;
+            }
+
+            ++stats.batches;
+            first = last;
+        }
+
+        stats.draws = count;
+    }
+
+    /// \brief Draw data buffer read by the vertex shader for imageIndex's draws
+    [[nodiscard]] vk::DescriptorBufferInfo GetDrawDataBufferInfo(int imageIndex) const
+    {
+        return { frames[imageIndex].drawData.VkType(), 0, VK_WHOLE_SIZE };
+    }
+
+    [[nodiscard]] std::size_t Size() const { return draws.size(); }
+    [[nodiscard]] bool UsesMultiDraw() const { return useMultiDraw; }
+    [[nodiscard]] const Stats& GetStats() const { return stats; }
+
+private:
+    struct Draw
+    {
+        State state;
+        vk::Buffer vertexBuffer;
+        vk::Buffer attributeBuffer;     //< Null unless the mesh is split
+        vk::Buffer indexBuffer;
+        vk::IndexType indexType;
+        vk::DrawIndexedIndirectCommand command;
+    };
+
+    struct Frame
+    {
+        Buffer commands;    //< Persistently mapped, rewritten each time the image records
+        Buffer drawData;
+    };
+
+    void CreateBuffer(Buffer& buffer, vk::DeviceSize size, vk::BufferUsageFlags usage)
+    {
+        vk::BufferCreateInfo bufferCreateInfo;
+        bufferCreateInfo.usage = usage;
+        bufferCreateInfo.size = size;
+
+        VmaAllocationCreateInfo allocCreateInfo = {};
+        allocCreateInfo.usage = VMA_MEMORY_USAGE_CPU_TO_GPU;
+        allocCreateInfo.flags = VMA_ALLOCATION_CREATE_MAPPED_BIT;
+
+        buffer.Create(bufferCreateInfo, allocCreateInfo, owner);
+    }
+
+    std::vector<Frame> frames;              //< One per swapchain image
+    std::vector<Draw> draws;
+    std::vector<DrawData> drawData;         //< Draw data in submission order
+    std::vector<RenderSortEntry> order;
+    std::vector<RenderSortEntry> sortScratch;
+    Stats stats;
+    std::uint32_t maxDraws = 0;
+    std::uint32_t maxDrawsPerCall = 1;
+    int frameIndex = 0;
+    bool useMultiDraw = false;
+    bool recorded = false;
+};
+
+} // namespace dm
@@ -0,0 +1,152 @@
+//------------------------------------------------------------------------------
+//
+// File Name:	InstanceBatcher.h
+// Author(s):	Jonathan Bourim (j.bourim)
+// Date:		10/19/2026
+//
+//------------------------------------------------------------------------------
+
+#pragma once
+
+namespace dm
+{
+
+/// \brief Turns repeated mesh draws into instanced draws.
+///        Draws are sorted by key, consecutive draws of the same mesh and pipeline are merged,
+///        and their instance data is written to a per-frame InstanceStream buffer.
+///        Keys built without depth (e.g. OpaqueSortKey with a depth of 0) keep equal meshes adjacent.
+template<class InstanceType>
+class InstanceBatcher : public IOwned<Device>
+{
+public:
+DM_TYPE_OWNED_BODY(InstanceBatcher<InstanceType>, IOwned<Device>)
+    static_assert(std::is_trivially_copyable<InstanceType>::value, "Instance data is copied directly into the instance stream");
+
+    struct Stats
+    {
+        std::uint32_t instances = 0;    //< Draws submitted in the last Record
+        std::uint32_t batches = 0;      //< Instanced draws issued in the last Record
+    };
+
+    /// \param initialCapacity Instances each frame's stream holds before growing
+    void Create(Device* inOwner, std::size_t initialCapacity = 1024)
+    {
+        IOwned::CreateOwned(inOwner);
+
+        streams.resize(owner->ImageCount());
+        for (InstanceStreamBuffer<InstanceType>& stream : streams)
+            stream.Create(initialCapacity, owner);
+    }
+
+    void Destroy()
+    {
+        streams.clear();
+    }
+
+    /// \brief Start a frame, discarding the previous frame's draws.
+    ///        The image's previous submission must have completed, its stream is rewritten.
+    void Begin(int imageIndex)
+    {
+        DM_ASSERT_MSG(imageIndex >= 0 && imageIndex < (int) streams.size(), "Image index out of range of the instance streams");
+        frameIndex = imageIndex;
+        recorded = false;
+        draws.clear();
+        instances.clear();
+        order.clear();
+    }
+
+    /// \brief Add a draw of mesh with per-instance data sourced by the shader's i_ prefixed inputs.
+    /// \param pipeline Pipeline bound before the batch, null if the caller binds it
+    /// \param layout Layout of pipeline, lets descriptor sets and push constants stay bound across pipeline changes
+    template<class VertexType>
+    void Add(RenderSortKey key, vk::Pipeline pipeline, const Mesh<VertexType>& mesh, const InstanceType& instance,
+             vk::PipelineLayout layout = {})
+    {
+        DM_ASSERT_MSG(!recorded, "Instance batcher must begin a new frame before adding draws");
+
+        draws.push_back({ &mesh, pipeline, layout, &RecordMesh<VertexType> });
+        instances.push_back(instance);
+        order.push_back({ key, static_cast<std::uint32_t>(draws.size() - 1) });
+    }
+
+    /// \brief Write the frame's instance stream and record one instanced draw per batch.
+    ///        Once per frame, as growing the stream would invalidate earlier recordings.
+    /// \param pool Optional thread pool to sort with
+    void Record(CommandRecorder& recorder, ThreadPool* pool = nullptr)
+    {
+        DM_ASSERT_MSG(!recorded, "Instance batcher can only record once per frame");
+        recorded = true;
+
+        stats = {};
+        if (order.empty())
+            return;
+
+        RadixSort(order, sortScratch, ~std::uint64_t(0), pool);
+
+        InstanceStreamBuffer<InstanceType>& stream = streams[frameIndex];
+        stream.Reserve(order.size());
+        InstanceType* mapped = stream.Data();
+        for (std::size_t i = 0; i < order.size(); ++i)
+            mapped[i] = instances[order[i].index];
+        stream.Flush(order.size());
+        stream.Bind(recorder);
+
+        std::uint32_t first = 0;
+        const auto count = static_cast<std::uint32_t>(order.size());
+        while (first < count)
+        {
+            const Draw& draw = draws[order[first].index];
+            std::uint32_t last = first + 1;
+            while (last < count
+                   && draws[order[last].index].mesh == draw.mesh
+                   && draws[order[last].index].pipeline == draw.pipeline)
+            {
+                ++last;
+            }
+
+            if (draw.pipeline)
+                recorder.BindPipeline(draw.pipeline, draw.layout);
+
+            draw.record(recorder, draw.mesh, last - first, first);
+            ++stats.batches;
+            first = last;
+        }
+
+        stats.instances = count;
+    }
+
+    [[nodiscard]] std::size_t Size() const { return draws.size(); }
+    [[nodiscard]] const Stats& GetStats() const { return stats; }
+
+private:
+    using RecordFunction = void (*)(CommandRecorder& recorder, const void* mesh,
+                                    std::uint32_t instanceCount, std::uint32_t firstInstance);
+
+    struct Draw
+    {
+        const void* mesh;
+        vk::Pipeline pipeline;
+        vk::PipelineLayout layout;
+        RecordFunction record;
+    };
+
+    template<class VertexType>
+    static void RecordMesh(CommandRecorder& recorder, const void* mesh,
+                           std::uint32_t instanceCount, std::uint32_t firstInstance)
+    {
+        const auto& typed = *static_cast<const Mesh<VertexType>*>(mesh);
+        typed.Bind(recorder);
+        typed.DrawInstanced(recorder, instanceCount, firstInstance);
+    }
+
+    std::vector<InstanceStreamBuffer<InstanceType>> streams;   //< One per swapchain image
+    std::vector<Draw> draws;
+    std::vector<InstanceType> instances;                        //< Instance data in submission order
+    std::vector<RenderSortEntry> order;
+    std::vector<RenderSortEntry> sortScratch;
+    Stats stats;
+    int frameIndex = 0;
+    bool recorded = false;
+};
+
+} // namespace dm
@@ -0,0 +1,64 @@
+//------------------------------------------------------------------------------
+//
+// File Name:	Frustum.cpp
+// Author(s):	Jonathan Bourim (j.bourim)
+// Date:        10/19/2026
+//
+//------------------------------------------------------------------------------
+
+#include "Frustum.h"
+#include "Camera/Camera.h"
+
+namespace dm
+{
+
+Frustum Frustum::FromMatrix(const glm::mat4& viewProjection)
+{
+    // Gribb-Hartmann, rows of the column major matrix
+    auto row = [&viewProjection](int i)
+    {
+        return glm::vec4(viewProjection[0][i], viewProjection[1][i], viewProjection[2][i], viewProjection[3][i]);
+    };
+
+    Frustum frustum;
+    frustum.planes[Left] = row(3) + row(0);
+    frustum.planes[Right] = row(3) - row(0);
+    frustum.planes[Bottom] = row(3) + row(1);
+    frustum.planes[Top] = row(3) - row(1);
+    frustum.planes[Near] = row(2);
+    frustum.planes[Far] = row(3) - row(2);
+
+    for (glm::vec4& plane : frustum.planes)
+        plane /= glm::length(glm::vec3(plane));
+
+    return frustum;
+}
+
+Frustum Frustum::FromCamera(const Camera& camera)
+{
+    return FromMatrix(camera.matrices.perspective * camera.matrices.view);
+}
+
+bool Frustum::IntersectsSphere(const glm::vec3& center, float radius) const
+{
+    for (const glm::vec4& plane : planes)
+    {
+        if (glm::dot(glm::vec3(plane), center) + plane.w < -radius)
+            return false;
+    }
+    return true;
+}
+
+bool Frustum::IntersectsBox(const glm::vec3& center, const glm::vec3& halfExtent) const
+{
+    for (const glm::vec4& plane : planes)
+    {
+        // Projected radius of the box onto the plane normal
+        const float radius = glm::dot(halfExtent, glm::abs(glm::vec3(plane)));
+        if (glm::dot(glm::vec3(plane), center) + plane.w < -radius)
+            return false;
+    }
+    return true;
+}
+
+}
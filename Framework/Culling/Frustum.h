@@ -0,0 +1,44 @@
+//------------------------------------------------------------------------------
+//
+// File Name:	Frustum.h
+// Author(s):	Jonathan Bourim (j.bourim)
+// Date:        10/19/2026
+//
+//------------------------------------------------------------------------------
+#pragma once
+
+class Camera;
+
+namespace dm
+{
+
+/**
+ * View frustum as six inward facing planes, (normal, distance) with normalized normals.
+ * A point p is inside a plane when dot(plane.xyz, p) + plane.w >= 0.
+ */
+struct Frustum
+{
+    enum PlaneIndex : uint32_t
+    {
+        Left = 0,
+        Right,
+        Bottom,
+        Top,
+        Near,
+        Far,
+        PlaneCount
+    };
+
+    std::array<glm::vec4, PlaneCount> planes;
+
+    /// \brief Extracts the planes of a projection * view matrix with a [0, 1] depth range
+    static Frustum FromMatrix(const glm::mat4& viewProjection);
+
+    /// \brief Extracts the planes of the camera's perspective * view
+    static Frustum FromCamera(const Camera& camera);
+
+    [[nodiscard]] bool IntersectsSphere(const glm::vec3& center, float radius) const;
+    [[nodiscard]] bool IntersectsBox(const glm::vec3& center, const glm::vec3& halfExtent) const;
+};
+
+}
@@ -0,0 +1,359 @@
+//------------------------------------------------------------------------------
+//
+// File Name:	FrustumCulling.cpp
+// Author(s):	Jonathan Bourim (j.bourim)
+// Date:        10/19/2026
+//
+//------------------------------------------------------------------------------
+
+#include "FrustumCulling.h"
+
+namespace dm
+{
+
+namespace
+{
+
+constexpr uint32_t MinBoundsPerChunk = 16384;   //< Below this per thread, synchronization outweighs the work
+
+// Planes split by component, with absolute normals for projecting box extents
+struct CullPlanes
+{
+    float normalX[Frustum::PlaneCount];
+    float normalY[Frustum::PlaneCount];
+    float normalZ[Frustum::PlaneCount];
+    float distance[Frustum::PlaneCount];
+    float absX[Frustum::PlaneCount];
+    float absY[Frustum::PlaneCount];
+    float absZ[Frustum::PlaneCount];
+};
+
+// Spheres keep their radius in extentX, the other extents are unused
+struct BoundsView
+{
+    const float* centerX;
+    const float* centerY;
+    const float* centerZ;
+    const float* extentX;
+    const float* extentY;
+    const float* extentZ;
+};
+
+CullPlanes SplitPlanes(const Frustum& frustum)
+{
+    CullPlanes planes = {};
+    for (uint32_t i = 0; i < Frustum::PlaneCount; ++i)
+    {
+        const glm::vec4& plane = frustum.planes[i];
+        planes.normalX[i] = plane.x;
+        planes.normalY[i] = plane.y;
+        planes.normalZ[i] = plane.z;
+        planes.distance[i] = plane.w;
+        planes.absX[i] = std::abs(plane.x);
+        planes.absY[i] = std::abs(plane.y);
+        planes.absZ[i] = std::abs(plane.z);
+    }
+    return planes;
+}
+
+uint32_t RoundUp(uint32_t value, uint32_t multiple)
+{
+    return (value + multiple - 1) / multiple * multiple;
+}
+
+void PadBounds(std::initializer_list<std::vector<float>*> arrays, uint32_t count)
+{
+    const size_t padded = RoundUp(count, BoxBounds::boundsPadding);
+    for (std::vector<float>* array : arrays)
+    {
+        if (array->size() < padded)
+            array->resize(padded, 0.0f);
+    }
+}
+
+// Appends base + lane for every set bit of mask without branching on it, writing up to width slots
+template<uint32_t Width>
+inline uint32_t CompactLanes(uint32_t mask, uint32_t base, uint32_t* out, uint32_t written)
+{
+    for (uint32_t lane = 0; lane < Width; ++lane)
+    {
+        out[written] = base + lane;
+        written += (mask >> lane) & 1u;
+    }
+    return written;
+}
+
+// Culls [begin, end) writing visible indices to out, which must have room for the range rounded up to the width
+template<bool IsSphere>
+uint32_t CullRange(const CullPlanes& planes, const BoundsView& bounds, uint32_t begin, uint32_t end, uint32_t* out)
+{
+    uint32_t written = 0;
+
+#if defined(DM_SIMD_AVX2)
+    for (uint32_t i = begin; i < end; i += 8)
+    {
+        const __m256 x = _mm256_loadu_ps(bounds.centerX + i);
+        const __m256 y = _mm256_loadu_ps(bounds.centerY + i);
+        const __m256 z = _mm256_loadu_ps(bounds.centerZ + i);
+        const __m256 ex = _mm256_loadu_ps(bounds.extentX + i);
+        __m256 ey = ex;
+        __m256 ez = ex;
+        if constexpr (!IsSphere)
+        {
+            ey = _mm256_loadu_ps(bounds.extentY + i);
+            ez = _mm256_loadu_ps(bounds.extentZ + i);
+        }
+
+        __m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+        for (uint32_t plane = 0; plane < Frustum::PlaneCount; ++plane)
+        {
+            __m256 distance = _mm256_set1_ps(planes.distance[plane]);
+            distance = _mm256_add_ps(distance, _mm256_mul_ps(x, _mm256_set1_ps(planes.normalX[plane])));
+            distance = _mm256_add_ps(distance, _mm256_mul_ps(y, _mm256_set1_ps(planes.normalY[plane])));
+            distance = _mm256_add_ps(distance, _mm256_mul_ps(z, _mm256_set1_ps(planes.normalZ[plane])));
+
+            __m256 radius = ex;
+            if constexpr (!IsSphere)
+            {
+                radius = _mm256_mul_ps(ex, _mm256_set1_ps(planes.absX[plane]));
+                radius = _mm256_add_ps(radius, _mm256_mul_ps(ey, _mm256_set1_ps(planes.absY[plane])));
+                radius = _mm256_add_ps(radius, _mm256_mul_ps(ez, _mm256_set1_ps(planes.absZ[plane])));
+            }
+            inside = _mm256_and_ps(inside, _mm256_cmp_ps(_mm256_add_ps(distance, radius), _mm256_setzero_ps(), _CMP_GE_OQ));
+        }
+
+        uint32_t mask = (uint32_t) _mm256_movemask_ps(inside);
+        if (end - i < 8)
+            mask &= (1u << (end - i)) - 1u;
+        if (mask != 0)
+            written = CompactLanes<8>(mask, i, out, written);
+    }
+#elif defined(DM_SIMD_SSE2)
+    for (uint32_t i = begin; i < end; i += 4)
+    {
+        const __m128 x = _mm_loadu_ps(bounds.centerX + i);
+        const __m128 y = _mm_loadu_ps(bounds.centerY + i);
+        const __m128 z = _mm_loadu_ps(bounds.centerZ + i);
+        const __m128 ex = _mm_loadu_ps(bounds.extentX + i);
+        __m128 ey = ex;
+        __m128 ez = ex;
+        if constexpr (!IsSphere)
+        {
+            ey = _mm_loadu_ps(bounds.extentY + i);
+            ez = _mm_loadu_ps(bounds.extentZ + i);
+        }
+
+        __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+        for (uint32_t plane = 0; plane < Frustum::PlaneCount; ++plane)
+        {
+            __m128 distance = _mm_set1_ps(planes.distance[plane]);
+            distance = _mm_add_ps(distance, _mm_mul_ps(x, _mm_set1_ps(planes.normalX[plane])));
+            distance = _mm_add_ps(distance, _mm_mul_ps(y, _mm_set1_ps(planes.normalY[plane])));
+            distance = _mm_add_ps(distance, _mm_mul_ps(z, _mm_set1_ps(planes.normalZ[plane])));
+
+            __m128 radius = ex;
+            if constexpr (!IsSphere)
+            {
+                radius = _mm_mul_ps(ex, _mm_set1_ps(planes.absX[plane]));
+                radius = _mm_add_ps(radius, _mm_mul_ps(ey, _mm_set1_ps(planes.absY[plane])));
+                radius = _mm_add_ps(radius, _mm_mul_ps(ez, _mm_set1_ps(planes.absZ[plane])));
+            }
+            inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(distance, radius), _mm_setzero_ps()));
+        }
+
+        uint32_t mask = (uint32_t) _mm_movemask_ps(inside);
+        if (end - i < 4)
+            mask &= (1u << (end - i)) - 1u;
+        if (mask != 0)
+            written = CompactLanes<4>(mask, i, out, written);
+    }
+#else
+    for (uint32_t i = begin; i < end; ++i)
+    {
+        bool inside = true;
+        for (uint32_t plane = 0; plane < Frustum::PlaneCount && inside; ++plane)
+        {
+            const float distance = planes.distance[plane]
+                                   + bounds.centerX[i] * planes.normalX[plane]
+                                   + bounds.centerY[i] * planes.normalY[plane]
+                                   + bounds.centerZ[i] * planes.normalZ[plane];
+            float radius = bounds.extentX[i];
+            if constexpr (!IsSphere)
+            {
+                radius = bounds.extentX[i] * planes.absX[plane]
+                         + bounds.extentY[i] * planes.absY[plane]
+                         + bounds.extentZ[i] * planes.absZ[plane];
+            }
+            inside = distance + radius >= 0.0f;
+        }
+        out[written] = i;
+        written += inside ? 1u : 0u;
+    }
+#endif
+
+    return written;
+}
+
+template<bool IsSphere>
+void CullBounds(const Frustum& frustum, const BoundsView& bounds, uint32_t count, std::vector<uint32_t>& visible,
+                ThreadPool* pool)
+{
+    visible.resize(RoundUp(count, BoxBounds::boundsPadding));
+    if (count == 0)
+        return;
+
+    const CullPlanes planes = SplitPlanes(frustum);
+
+    // Chunks start on a padding boundary so every SIMD iteration stays aligned to the arrays' padding
+    uint32_t chunkCount = 1;
+    if (pool != nullptr)
+        chunkCount = std::clamp(count / MinBoundsPerChunk, 1u, pool->GetConcurrency());
+    const uint32_t chunkSize = RoundUp((count + chunkCount - 1) / chunkCount, BoxBounds::boundsPadding);
+    chunkCount = (count + chunkSize - 1) / chunkSize;
+
+    // Each chunk writes its visible indices to the start of its own slice of visible
+    std::vector<uint32_t> chunkVisible(chunkCount);
+    auto cullChunk = [&](uint32_t chunk)
+    {
+        const uint32_t begin = chunk * chunkSize;
+        const uint32_t end = std::min(begin + chunkSize, count);
+        chunkVisible[chunk] = CullRange<IsSphere>(planes, bounds, begin, end, visible.data() + begin);
+    };
+
+    if (chunkCount > 1)
+        pool->Dispatch(chunkCount, cullChunk);
+    else
+        cullChunk(0);
+
+    uint32_t total = chunkVisible[0];
+    for (uint32_t chunk = 1; chunk < chunkCount; ++chunk)
+    {
+        std::memmove(visible.data() + total, visible.data() + chunk * chunkSize, chunkVisible[chunk] * sizeof(uint32_t));
+        total += chunkVisible[chunk];
+    }
+    visible.resize(total);
+}
+
+}
+
+uint32_t FrustumCullWidth()
+{
+#if defined(DM_SIMD_AVX2)
+    return 8;
+#elif defined(DM_SIMD_SSE2)
+    return 4;
+#else
+    return 1;
+#endif
+}
+
+uint32_t BoxBounds::Add(const primitives::Box& box)
+{
+    const uint32_t index = count++;
+    PadBounds({ &centerX, &centerY, &centerZ, &extentX, &extentY, &extentZ }, count);
+    Set(index, box);
+    return index;
+}
+
+void BoxBounds::Set(uint32_t index, const primitives::Box& box)
+{
+    DM_ASSERT_MSG(index < count, "Box index out of range");
+    centerX[index] = box.position.x;
+    centerY[index] = box.position.y;
+    centerZ[index] = box.position.z;
+    extentX[index] = box.halfExtent.x;
+    extentY[index] = box.halfExtent.y;
+    extentZ[index] = box.halfExtent.z;
+}
+
+primitives::Box BoxBounds::Get(uint32_t index) const
+{
+    DM_ASSERT_MSG(index < count, "Box index out of range");
+    return {
+        { centerX[index], centerY[index], centerZ[index] },
+        { extentX[index], extentY[index], extentZ[index] }
+    };
+}
+
+void BoxBounds::Pop()
+{
+    DM_ASSERT_MSG(count > 0, "No boxes to remove");
+    Set(count - 1, {});
+    --count;
+}
+
+void BoxBounds::Clear()
+{
+    for (std::vector<float>* array : { &centerX, &centerY, &centerZ, &extentX, &extentY, &extentZ })
+        array->clear();
+    count = 0;
+}
+
+void BoxBounds::Reserve(uint32_t capacity)
+{
+    for (std::vector<float>* array : { &centerX, &centerY, &centerZ, &extentX, &extentY, &extentZ })
+        array->reserve(RoundUp(capacity, boundsPadding));
+}
+
+uint32_t SphereBounds::Add(const primitives::Sphere& sphere)
+{
+    const uint32_t index = count++;
+    PadBounds({ &centerX, &centerY, &centerZ, &radius }, count);
+    Set(index, sphere);
+    return index;
+}
+
+void SphereBounds::Set(uint32_t index, const primitives::Sphere& sphere)
+{
+    DM_ASSERT_MSG(index < count, "Sphere index out of range");
+    centerX[index] = sphere.position.x;
+    centerY[index] = sphere.position.y;
+    centerZ[index] = sphere.position.z;
+    radius[index] = sphere.radius;
+}
+
+primitives::Sphere SphereBounds::Get(uint32_t index) const
+{
+    DM_ASSERT_MSG(index < count, "Sphere index out of range");
+    return { radius[index], { centerX[index], centerY[index], centerZ[index] } };
+}
+
+void SphereBounds::Pop()
+{
+    DM_ASSERT_MSG(count > 0, "No spheres to remove");
+    Set(count - 1, {});
+    --count;
+}
+
+void SphereBounds::Clear()
+{
+    for (std::vector<float>* array : { &centerX, &centerY, &centerZ, &radius })
+        array->clear();
+    count = 0;
+}
+
+void SphereBounds::Reserve(uint32_t capacity)
+{
+    for (std::vector<float>* array : { &centerX, &centerY, &centerZ, &radius })
+        array->reserve(RoundUp(capacity, boundsPadding));
+}
+
+void FrustumCull(const Frustum& frustum, const BoxBounds& bounds, std::vector<uint32_t>& visible, ThreadPool* pool)
+{
+    const BoundsView view = {
+        bounds.centerX.data(), bounds.centerY.data(), bounds.centerZ.data(),
+        bounds.extentX.data(), bounds.extentY.data(), bounds.extentZ.data()
+    };
+    CullBounds<false>(frustum, view, bounds.count, visible, pool);
+}
+
+void FrustumCull(const Frustum& frustum, const SphereBounds& bounds, std::vector<uint32_t>& visible, ThreadPool* pool)
+{
+    const BoundsView view = {
+        bounds.centerX.data(), bounds.centerY.data(), bounds.centerZ.data(),
+        bounds.radius.data(), nullptr, nullptr
+    };
+    CullBounds<true>(frustum, view, bounds.count, visible, pool);
+}
+
+}
@@ -0,0 +1,88 @@
+//------------------------------------------------------------------------------
+//
+// File Name:	FrustumCulling.h
+// Author(s):	Jonathan Bourim (j.bourim)
+// Date:        10/19/2026
+//
+//------------------------------------------------------------------------------
+#pragma once
+
+namespace dm
+{
+
+class ThreadPool;
+
+/// \brief Elements tested per iteration by FrustumCull, 8 with AVX2, 4 with SSE2, otherwise 1
+uint32_t FrustumCullWidth();
+
+/**
+ * Structure of arrays primitives::Box bounds for FrustumCull.
+ * Arrays are zero padded to a multiple of boundsPadding so SIMD loads never read past the end.
+ */
+class BoxBounds
+{
+public:
+    static constexpr uint32_t boundsPadding = 8;
+
+    /// \return Index of the box, reported by FrustumCull when visible
+    uint32_t Add(const primitives::Box& box);
+    void Set(uint32_t index, const primitives::Box& box);
+    [[nodiscard]] primitives::Box Get(uint32_t index) const;
+
+    /// \brief Remove the last box
+    void Pop();
+    void Clear();
+    void Reserve(uint32_t capacity);
+
+    [[nodiscard]] uint32_t Size() const { return count; }
+
+private:
+    friend void FrustumCull(const Frustum&, const BoxBounds&, std::vector<uint32_t>&, ThreadPool*);
+
+    std::vector<float> centerX, centerY, centerZ;
+    std::vector<float> extentX, extentY, extentZ;
+    uint32_t count = 0;
+};
+
+/**
+ * Structure of arrays primitives::Sphere bounds for FrustumCull.
+ * Arrays are zero padded to a multiple of boundsPadding so SIMD loads never read past the end.
+ */
+class SphereBounds
+{
+public:
+    static constexpr uint32_t boundsPadding = BoxBounds::boundsPadding;
+
+    /// \return Index of the sphere, reported by FrustumCull when visible
+    uint32_t Add(const primitives::Sphere& sphere);
+    void Set(uint32_t index, const primitives::Sphere& sphere);
+    [[nodiscard]] primitives::Sphere Get(uint32_t index) const;
+
+    /// \brief Remove the last sphere
+    void Pop();
+    void Clear();
+    void Reserve(uint32_t capacity);
+
+    [[nodiscard]] uint32_t Size() const { return count; }
+
+private:
+    friend void FrustumCull(const Frustum&, const SphereBounds&, std::vector<uint32_t>&, ThreadPool*);
+
+    std::vector<float> centerX, centerY, centerZ;
+    std::vector<float> radius;
+    uint32_t count = 0;
+};
+
+/// \brief Test every box against the frustum, conservatively keeping boxes touching a plane.
+/// \param visible Replaced with the ascending indices of visible boxes, its capacity is reused across frames
+/// \param pool Optional thread pool, each thread culls a contiguous chunk
+void FrustumCull(const Frustum& frustum, const BoxBounds& bounds, std::vector<uint32_t>& visible,
+                 ThreadPool* pool = nullptr);
+
+/// \brief Test every sphere against the frustum, conservatively keeping spheres touching a plane.
+/// \param visible Replaced with the ascending indices of visible spheres, its capacity is reused across frames
+/// \param pool Optional thread pool, each thread culls a contiguous chunk
+void FrustumCull(const Frustum& frustum, const SphereBounds& bounds, std::vector<uint32_t>& visible,
+                 ThreadPool* pool = nullptr);
+
+}
@@ -0,0 +1,274 @@
+//------------------------------------------------------------------------------
+//
+// File Name:	GpuScene.cpp
+// Author(s):	Jonathan Bourim (j.bourim)
+// Date:        10/19/2026
+//
+//------------------------------------------------------------------------------
+
+#include "GpuScene.h"
+
+namespace dm
+{
+
+static constexpr uint32_t invalidSlot = ~0u;
+
+GpuScene::~GpuScene() noexcept
+{
+    Destroy();
+}
+
+void GpuScene::Create(Device* inOwner, uint32_t inMaxObjects, uint32_t inMaxMeshes, const std::string& shaderPath)
+{
+    Destroy();
+    IOwned::CreateOwned(inOwner);
+    maxObjects = inMaxObjects;
+    maxMeshes = inMaxMeshes;
+
+    const PhysicalDevice& physicalDevice = OwnerGet<PhysicalDevice>();
+    DM_ASSERT_MSG(physicalDevice.supportedFeatures.drawIndirectFirstInstance,
+                  "GPU driven drawing requires drawIndirectFirstInstance to pass object indices");
+    useDrawCount = physicalDevice.drawIndirectCount;
+
+    std::array<vk::DescriptorSetLayoutBinding, 4> bindings;
+    for (uint32_t i = 0; i < bindings.size(); ++i)
+        bindings[i] = { i, vk::DescriptorType::eStorageBuffer, 1, vk::ShaderStageFlagBits::eCompute };
+
+    vk::DescriptorSetLayoutCreateInfo setLayoutCreateInfo;
+    setLayoutCreateInfo.bindingCount = (uint32_t) bindings.size();
+    setLayoutCreateInfo.pBindings = bindings.data();
+    setLayout.Create(setLayoutCreateInfo, owner);
+
+    vk::PushConstantRange pushConstantRange(vk::ShaderStageFlagBits::eCompute, 0, sizeof(CullConstants));
+    vk::PipelineLayoutCreateInfo pipelineLayoutCreateInfo;
+    pipelineLayoutCreateInfo.setLayoutCount = 1;
+    pipelineLayoutCreateInfo.pSetLayouts = setLayout.VkTypePtr();
+    pipelineLayoutCreateInfo.pushConstantRangeCount = 1;
+    pipelineLayoutCreateInfo.pPushConstantRanges = &pushConstantRange;
+    pipelineLayout.Create(pipelineLayoutCreateInfo, owner);
+
+    CreatePipeline(shaderPath);
+
+    frames.resize(owner->ImageCount());
+    for (Frame& frame : frames)
+    {
+        CreateBuffer(frame.objects, sizeof(ObjectData) * (vk::DeviceSize) maxObjects,
+                     vk::BufferUsageFlagBits::eStorageBuffer, true);
+        CreateBuffer(frame.meshes, sizeof(MeshData) * (vk::DeviceSize) maxMeshes,
+                     vk::BufferUsageFlagBits::eStorageBuffer, true);
+        CreateBuffer(frame.commands, sizeof(vk::DrawIndexedIndirectCommand) * (vk::DeviceSize) maxObjects,
+                     vk::BufferUsageFlagBits::eStorageBuffer | vk::BufferUsageFlagBits::eIndirectBuffer, false);
+        CreateBuffer(frame.count, sizeof(uint32_t),
+                     vk::BufferUsageFlagBits::eStorageBuffer | vk::BufferUsageFlagBits::eIndirectBuffer |
+                     vk::BufferUsageFlagBits::eTransferDst, false);
+
+        vk::DescriptorSetAllocateInfo allocateInfo;
+        allocateInfo.descriptorPool = owner->DescriptorPool().VkType();
+        allocateInfo.descriptorSetCount = 1;
+        allocateInfo.pSetLayouts = setLayout.VkTypePtr();
+        DM_ASSERT_VK(owner->allocateDescriptorSets(&allocateInfo, &frame.set));
+
+        std::array<vk::DescriptorBufferInfo, 4> bufferInfos = {
+            vk::DescriptorBufferInfo(frame.objects.VkType(), 0, VK_WHOLE_SIZE),
+            vk::DescriptorBufferInfo(frame.meshes.VkType(), 0, VK_WHOLE_SIZE),
+            vk::DescriptorBufferInfo(frame.commands.VkType(), 0, VK_WHOLE_SIZE),
+            vk::DescriptorBufferInfo(frame.count.VkType(), 0, VK_WHOLE_SIZE)
+        };
+        std::array<vk::WriteDescriptorSet, 4> writes;
+        for (uint32_t i = 0; i < writes.size(); ++i)
+            writes[i] = vk::WriteDescriptorSet(frame.set, i, 0, 1, vk::DescriptorType::eStorageBuffer, nullptr, &bufferInfos[i]);
+        owner->updateDescriptorSets((uint32_t) writes.size(), writes.data(), 0, nullptr);
+    }
+}
+
+void GpuScene::Destroy()
+{
+    if (!created)
+        return;
+
+    // Sets are returned with the descriptor pool, which doesn't free individual sets
+    frames.clear();
+    owner->destroyPipeline(cullPipeline);
+    cullPipeline = nullptr;
+    pipelineLayout.Destroy();
+    setLayout.Destroy();
+
+    objects.clear();
+    slotToObject.clear();
+    objectToSlot.clear();
+    freeObjects.clear();
+    meshes.clear();
+    geometryPool = nullptr;
+    geometryArena = RangeAllocator::invalidOffset;
+    created = false;
+}
+
+void GpuScene::CreateBuffer(Buffer& buffer, vk::DeviceSize size, vk::BufferUsageFlags usage, bool hostVisible)
+{
+    vk::BufferCreateInfo bufferCreateInfo;
+    bufferCreateInfo.usage = usage;
+    bufferCreateInfo.size = size;
+
+    VmaAllocationCreateInfo allocCreateInfo = {};
+    allocCreateInfo.usage = hostVisible ? VMA_MEMORY_USAGE_CPU_TO_GPU : VMA_MEMORY_USAGE_GPU_ONLY;
+    if (hostVisible)
+        allocCreateInfo.flags = VMA_ALLOCATION_CREATE_MAPPED_BIT;
+
+    buffer.Create(bufferCreateInfo, allocCreateInfo, owner);
+}
+
+void GpuScene::CreatePipeline(const std::string& shaderPath)
+{
+    ShaderModule module;
+    vk::PipelineShaderStageCreateInfo stage = module.Load(shaderPath, vk::ShaderStageFlagBits::eCompute, owner);
+
+    VkBool32 drawCount = useDrawCount ? VK_TRUE : VK_FALSE;
+    vk::SpecializationMapEntry entry(0, 0, sizeof(VkBool32));
+    vk::SpecializationInfo specialization(1, &entry, sizeof(VkBool32), &drawCount);
+    stage.pSpecializationInfo = &specialization;
+
+    vk::ComputePipelineCreateInfo createInfo({}, stage, pipelineLayout.VkType());
+    DM_ASSERT_VK(owner->createComputePipelines(vk::PipelineCache(), 1, &createInfo, nullptr, &cullPipeline));
+}
+
+uint32_t GpuScene::AddMesh(const MeshData& data)
+{
+    DM_ASSERT_MSG(meshes.size() < maxMeshes, "GPU scene mesh capacity exceeded");
+    meshes.push_back(data);
+    ++meshVersion;
+    return (uint32_t) meshes.size() - 1;
+}
+
+uint32_t GpuScene::AddObject(uint32_t mesh, const glm::mat4& model)
+{
+    DM_ASSERT_MSG(objects.size() < maxObjects, "GPU scene object capacity exceeded");
+    DM_ASSERT_MSG(mesh < meshes.size(), "Attempting to add an object of an unregistered mesh");
+
+    uint32_t object;
+    if (!freeObjects.empty())
+    {
+        object = freeObjects.back();
+        freeObjects.pop_back();
+    }
+    else
+    {
+        object = (uint32_t) objectToSlot.size();
+        objectToSlot.push_back(invalidSlot);
+    }
+
+    objectToSlot[object] = (uint32_t) objects.size();
+    slotToObject.push_back(object);
+    objects.push_back({ model, mesh, {} });
+    ++objectVersion;
+    return object;
+}
+
+void GpuScene::SetTransform(uint32_t object, const glm::mat4& model)
+{
+    DM_ASSERT_MSG(object < objectToSlot.size() && objectToSlot[object] != invalidSlot, "Attempting to move a removed object");
+    objects[objectToSlot[object]].model = model;
+    ++objectVersion;
+}
+
+void GpuScene::RemoveObject(uint32_t object)
+{
+    DM_ASSERT_MSG(object < objectToSlot.size() && objectToSlot[object] != invalidSlot, "Attempting to remove a removed object");
+
+    // Swap the last object into the removed slot, keeping objects packed for the culling pass
+    const uint32_t slot = objectToSlot[object];
+    const uint32_t last = (uint32_t) objects.size() - 1;
+    objects[slot] = objects[last];
+    slotToObject[slot] = slotToObject[last];
+    objectToSlot[slotToObject[slot]] = slot;
+
+    objects.pop_back();
+    slotToObject.pop_back();
+    objectToSlot[object] = invalidSlot;
+    freeObjects.push_back(object);
+    ++objectVersion;
+}
+
+void GpuScene::Cull(CommandRecorder& recorder, int imageIndex, const glm::mat4& viewProjection,
+                    const glm::vec3& cameraPosition, float lodScale)
+{
+    Frame& frame = frames[imageIndex];
+
+    // Each image holds its own copy, brought up to date once the image is reused
+    if (frame.objectVersion != objectVersion)
+    {
+        std::memcpy(frame.objects.allocationInfo.pMappedData, objects.data(), sizeof(ObjectData) * objects.size());
+        vmaFlushAllocation(owner->allocator, frame.objects.allocation, 0, sizeof(ObjectData) * objects.size());
+        frame.objectVersion = objectVersion;
+    }
+    if (frame.meshVersion != meshVersion)
+    {
+        std::memcpy(frame.meshes.allocationInfo.pMappedData, meshes.data(), sizeof(MeshData) * meshes.size());
+        vmaFlushAllocation(owner->allocator, frame.meshes.allocation, 0, sizeof(MeshData) * meshes.size());
+        frame.meshVersion = meshVersion;
+    }
+
+    vk::CommandBuffer commandBuffer = recorder.GetCommandBuffer();
+    recorder.Flush();
+
+    if (useDrawCount)
+    {
+        commandBuffer.fillBuffer(frame.count.VkType(), 0, sizeof(uint32_t), 0);
+
+        vk::MemoryBarrier clearBarrier(vk::AccessFlagBits::eTransferWrite,
+                                       vk::AccessFlagBits::eShaderRead | vk::AccessFlagBits::eShaderWrite);
+        commandBuffer.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer, vk::PipelineStageFlagBits::eComputeShader,
+                                      {}, 1, &clearBarrier, 0, nullptr, 0, nullptr);
+    }
+
+    if (objects.empty())
+        return;
+
+    const Frustum frustum = Frustum::FromMatrix(viewProjection);
+    CullConstants constants = {};
+    std::copy(frustum.planes.begin(), frustum.planes.end(), constants.planes);
+    constants.cameraPosition = glm::vec4(cameraPosition, lodScale);
+    constants.objectCount = (uint32_t) objects.size();
+
+    recorder.BindPipeline(cullPipeline, pipelineLayout.VkType(), vk::PipelineBindPoint::eCompute);
+    recorder.BindDescriptorSet(pipelineLayout.VkType(), 0, frame.set, vk::PipelineBindPoint::eCompute);
+    recorder.PushConstants(pipelineLayout.VkType(), vk::ShaderStageFlagBits::eCompute, 0, sizeof(CullConstants), &constants);
+    recorder.Dispatch((constants.objectCount + workgroupSize - 1) / workgroupSize, 1, 1);
+
+    vk::MemoryBarrier cullBarrier(vk::AccessFlagBits::eShaderWrite, vk::AccessFlagBits::eIndirectCommandRead);
+    commandBuffer.pipelineBarrier(vk::PipelineStageFlagBits::eComputeShader, vk::PipelineStageFlagBits::eDrawIndirect,
+                                  {}, 1, &cullBarrier, 0, nullptr, 0, nullptr);
+}
+
+void GpuScene::Draw(CommandRecorder& recorder, int imageIndex)
+{
+    if (objects.empty())
+        return;
+
+    const Frame& frame = frames[imageIndex];
+    recorder.BindVertexBuffer(VertexStream, geometryPool->GetVertexBuffer(geometryArena));
+    recorder.BindIndexBuffer(geometryPool->GetIndexBuffer(), 0, vk::IndexType::eUint32);
+
+    const uint32_t stride = sizeof(vk::DrawIndexedIndirectCommand);
+    const auto objectCount = (uint32_t) objects.size();
+    if (useDrawCount)
+    {
+        recorder.DrawIndexedIndirectCount(frame.commands.VkType(), 0, frame.count.VkType(), 0, objectCount, stride);
+    }
+    else if (OwnerGet<PhysicalDevice>().supportedFeatures.multiDrawIndirect)
+    {
+        // Culled draws remain in place with an instance count of 0
+        recorder.DrawIndexedIndirect(frame.commands.VkType(), 0, objectCount, stride);
+    }
+    else
+    {
+        for (uint32_t i = 0; i < objectCount; ++i)
+            recorder.DrawIndexedIndirect(frame.commands.VkType(), (vk::DeviceSize) stride * i, 1, stride);
+    }
+}
+
+vk::DescriptorBufferInfo GpuScene::GetObjectBufferInfo(int imageIndex) const
+{
+    return { frames[imageIndex].objects.VkType(), 0, VK_WHOLE_SIZE };
+}
+
+}
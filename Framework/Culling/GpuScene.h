@@ -0,0 +1,190 @@
+//------------------------------------------------------------------------------
+//
+// File Name:	GpuScene.h
+// Author(s):	Jonathan Bourim (j.bourim)
+// Date:        10/19/2026
+//
+//------------------------------------------------------------------------------
+#pragma once
+
+namespace dm
+{
+
+/**
+ * GPU driven drawing of pooled meshes of a single vertex type.
+ * Object transforms and mesh LODs live in storage buffers, a compute pass frustum culls
+ * every object, selects its LOD and writes indexed indirect draws consumed by Draw.
+ * The CPU only records a dispatch and a single indirect draw per frame, whatever the object count.
+ *
+ * Opting in pipelines read their transform from the object buffer (GetObjectBufferInfo),
+ * indexed by gl_InstanceIndex, which each draw's firstInstance sets to its object.
+ */
+class GpuScene : public IOwned<Device>
+{
+public:
+DM_TYPE_OWNED_BODY(GpuScene, IOwned<Device>)
+    ~GpuScene() noexcept override;
+
+    static constexpr uint32_t maxLods = 4;
+    static constexpr uint32_t workgroupSize = 64;
+    static constexpr const char* cullShaderPath = "Shaders/GpuCulling.comp.spv";    //< Embedded by the Damascus target
+
+    struct ObjectData
+    {
+        glm::mat4 model;
+        uint32_t mesh;
+        uint32_t pad[3];
+    };
+
+    struct MeshLod
+    {
+        uint32_t firstIndex;
+        uint32_t indexCount;
+        int32_t vertexOffset;
+        float maxDistance;      //< Distance from the camera this LOD is replaced at, for an object scale of 1
+    };
+
+    struct MeshData
+    {
+        glm::vec4 sphere;       //< Local bounding sphere, xyz center and w radius
+        uint32_t lodCount;
+        uint32_t pad[3];
+        MeshLod lods[maxLods];
+    };
+
+    /// \param maxObjects Capacity of the object and draw buffers
+    /// \param maxMeshes Capacity of the mesh buffer
+    /// \param shaderPath Culling shader, embedded or loaded from disk
+    void Create(Device* inOwner, uint32_t maxObjects, uint32_t maxMeshes = 1024,
+                const std::string& shaderPath = cullShaderPath);
+    void Destroy();
+
+    /// \brief Register a mesh and its LODs, all pooled with the same vertex type
+    /// \param lods Meshes from finest to coarsest
+    /// \param lodDistances Furthest distance each LOD but the last is used at, multiplied by each object's scale
+    /// \param sphere Local bounding sphere, xyz center and w radius
+    /// \return Mesh index passed to AddObject
+    template<class VertexType>
+    uint32_t AddMesh(const std::vector<const Mesh<VertexType>*>& lods, const std::vector<float>& lodDistances,
+                     const glm::vec4& sphere)
+    {
+        DM_ASSERT_MSG(!lods.empty() && lods.size() <= maxLods, "GPU scene meshes must have between 1 and maxLods LODs");
+        DM_ASSERT_MSG(lodDistances.size() + 1 >= lods.size(), "Every LOD but the last needs a maximum distance");
+
+        MeshData data = {};
+        data.sphere = sphere;
+        data.lodCount = (uint32_t) lods.size();
+        for (size_t i = 0; i < lods.size(); ++i)
+        {
+            const Mesh<VertexType>& lod = *lods[i];
+            DM_ASSERT_MSG(lod.IsPooled() && lod.GetIndexCount() > 0, "GPU scene meshes must be indexed and pooled");
+
+            const uint32_t arena = lod.geometry.Get().arena;
+            DM_ASSERT_MSG(geometryArena == RangeAllocator::invalidOffset || geometryArena == arena,
+                          "Every GPU scene mesh must share a vertex type");
+            geometryArena = arena;
+            geometryPool = lod.geometry.GetPool();
+
+            data.lods[i].firstIndex = lod.GetLodFirstIndex(0);
+            data.lods[i].indexCount = lod.GetLodIndexCount(0);
+            data.lods[i].vertexOffset = (int32_t) lod.GetVertexOffset();
+            data.lods[i].maxDistance = i < lodDistances.size() ? lodDistances[i] : std::numeric_limits<float>::max();
+        }
+        return AddMesh(data);
+    }
+
+    /// \brief Register a mesh with its LOD chain, switching LODs where selector would for each object's scale
+    /// \param sphere Local bounding sphere, xyz center and w radius
+    /// \return Mesh index passed to AddObject
+    template<class VertexType>
+    uint32_t AddMesh(const Mesh<VertexType>& mesh, const glm::vec4& sphere, const LodSelector& selector)
+    {
+        DM_ASSERT_MSG(mesh.IsPooled() && mesh.GetIndexCount() > 0, "GPU scene meshes must be indexed and pooled");
+
+        const uint32_t arena = mesh.geometry.Get().arena;
+        DM_ASSERT_MSG(geometryArena == RangeAllocator::invalidOffset || geometryArena == arena,
+                      "Every GPU scene mesh must share a vertex type");
+        geometryArena = arena;
+        geometryPool = mesh.geometry.GetPool();
+
+        // Chains longer than maxLods keep their finest levels
+        MeshData data = {};
+        data.sphere = sphere;
+        data.lodCount = std::min(mesh.GetLodCount(), maxLods);
+        for (uint32_t i = 0; i < data.lodCount; ++i)
+        {
+            data.lods[i].firstIndex = mesh.GetLodFirstIndex(i);
+            data.lods[i].indexCount = mesh.GetLodIndexCount(i);
+            data.lods[i].vertexOffset = (int32_t) mesh.GetVertexOffset();
+            data.lods[i].maxDistance = i + 1 < data.lodCount
+                                       ? selector.LodDistance(mesh.GetLods()[i + 1].error)
+                                       : std::numeric_limits<float>::max();
+        }
+        return AddMesh(data);
+    }
+
+    /// \return Object ID, stable until removed
+    uint32_t AddObject(uint32_t mesh, const glm::mat4& model);
+    void SetTransform(uint32_t object, const glm::mat4& model);
+    void RemoveObject(uint32_t object);
+
+    /// \brief Record the culling pass, outside of a render pass.
+    ///        Uploads objects and meshes changed since this image was last culled.
+    /// \param lodScale Scales distances used for LOD selection
+    void Cull(CommandRecorder& recorder, int imageIndex, const glm::mat4& viewProjection,
+              const glm::vec3& cameraPosition, float lodScale = 1.0f);
+
+    /// \brief Record the culled draws, inside a render pass with an opted in pipeline and its sets bound
+    void Draw(CommandRecorder& recorder, int imageIndex);
+
+    /// \brief Object buffer read by the vertex shader for imageIndex's draws
+    [[nodiscard]] vk::DescriptorBufferInfo GetObjectBufferInfo(int imageIndex) const;
+
+    [[nodiscard]] uint32_t ObjectCount() const { return (uint32_t) objects.size(); }
+    [[nodiscard]] bool UsesDrawCount() const { return useDrawCount; }
+
+private:
+    struct CullConstants
+    {
+        glm::vec4 planes[Frustum::PlaneCount];
+        glm::vec4 cameraPosition;   //< w scales LOD distances
+        uint32_t objectCount;
+    };
+
+    struct Frame
+    {
+        Buffer objects;             //< Host visible copy of objects, rewritten when out of date
+        Buffer meshes;
+        Buffer commands;            //< Written by the culling pass
+        Buffer count;
+        vk::DescriptorSet set = {};
+        uint64_t objectVersion = 0;
+        uint64_t meshVersion = 0;
+    };
+
+    uint32_t AddMesh(const MeshData& data);
+    void CreateBuffer(Buffer& buffer, vk::DeviceSize size, vk::BufferUsageFlags usage, bool hostVisible);
+    void CreatePipeline(const std::string& shaderPath);
+
+    std::vector<ObjectData> objects;        //< Packed, in slot order
+    std::vector<uint32_t> slotToObject;
+    std::vector<uint32_t> objectToSlot;
+    std::vector<uint32_t> freeObjects;
+    std::vector<MeshData> meshes;
+    uint64_t objectVersion = 1;
+    uint64_t meshVersion = 1;
+
+    std::vector<Frame> frames;              //< One per swapchain image
+    uint32_t maxObjects = 0;
+    uint32_t maxMeshes = 0;
+
+    GeometryPool* geometryPool = nullptr;
+    uint32_t geometryArena = RangeAllocator::invalidOffset;
+
+    DescriptorSetLayout setLayout;
+    PipelineLayout pipelineLayout;
+    vk::Pipeline cullPipeline = {};
+    bool useDrawCount = false;
+};
+
+}
@@ -0,0 +1,172 @@
+//------------------------------------------------------------------------------
+//
+// File Name:	MeshletCulling.cpp
+// Author(s):	Jonathan Bourim (j.bourim)
+// Date:        10/19/2026
+//
+//------------------------------------------------------------------------------
+
+#include "MeshletCulling.h"
+
+namespace dm
+{
+
+namespace
+{
+
+#ifdef VK_EXT_mesh_shader
+const vk::ShaderStageFlags meshletTaskStage = vk::ShaderStageFlagBits::eTaskEXT;
+const vk::ShaderStageFlags meshletMeshStage = vk::ShaderStageFlagBits::eMeshEXT;
+#else
+const vk::ShaderStageFlags meshletTaskStage = {};
+const vk::ShaderStageFlags meshletMeshStage = {};
+#endif
+
+// Normal cones are only preserved by rotations, translations and uniform scales
+bool ScalesUniformly(const glm::mat4& model)
+{
+    const float x = glm::length(glm::vec3(model[0]));
+    const float y = glm::length(glm::vec3(model[1]));
+    const float z = glm::length(glm::vec3(model[2]));
+    const float largest = std::max(x, std::max(y, z));
+    return largest - std::min(x, std::min(y, z)) <= largest * 1e-3f;
+}
+
+glm::vec3 LocalCameraPosition(const glm::mat4& model, const glm::vec3& cameraPosition)
+{
+    return glm::vec3(glm::inverse(model) * glm::vec4(cameraPosition, 1.0f));
+}
+
+}
+
+void MeshletCuller::Cull(const MeshletData& data, const glm::mat4& model, const glm::mat4& viewProjection,
+                         const glm::vec3& cameraPosition)
+{
+    ranges.clear();
+    stats = {};
+    stats.meshlets = (uint32_t) data.meshlets.size();
+
+    const Frustum frustum = Frustum::FromMatrix(viewProjection * model);
+    const glm::vec3 camera = LocalCameraPosition(model, cameraPosition);
+    const bool testCones = ScalesUniformly(model);
+
+    for (size_t i = 0; i < data.meshlets.size(); ++i)
+    {
+        const Meshlet& meshlet = data.meshlets[i];
+        const MeshletBounds& bounds = data.bounds[i];
+        if (!frustum.IntersectsSphere(bounds.center, bounds.radius))
+            continue;
+        if (testCones && glm::dot(glm::normalize(bounds.coneApex - camera), bounds.coneAxis) >= bounds.coneCutoff)
+            continue;
+
+        ++stats.visible;
+        stats.triangles += meshlet.triangleCount;
+
+        const uint32_t indexCount = meshlet.triangleCount * 3;
+        if (!ranges.empty() && ranges.back().firstIndex + ranges.back().indexCount == meshlet.triangleOffset)
+            ranges.back().indexCount += indexCount;
+        else
+            ranges.push_back({ meshlet.triangleOffset, indexCount });
+    }
+    stats.ranges = (uint32_t) ranges.size();
+}
+
+MeshletDrawer::~MeshletDrawer() noexcept
+{
+    Destroy();
+}
+
+void MeshletDrawer::Create(Device* inOwner, const std::vector<Vertex>& vertices, const MeshletData& data)
+{
+    Destroy();
+    IOwned::CreateOwned(inOwner);
+
+    DM_ASSERT_MSG(OwnerGet<PhysicalDevice>().meshShader,
+                  "Meshlet drawing requires VK_EXT_mesh_shader, see PhysicalDevice::meshShader");
+    DM_ASSERT_MSG(!vertices.empty() && !data.meshlets.empty(), "Attempting to draw a mesh without meshlets");
+    for (const Meshlet& meshlet : data.meshlets)
+    {
+        DM_ASSERT_MSG(meshlet.vertexCount <= MeshletData::maxVertices && meshlet.triangleCount <= MeshletData::maxTriangles,
+                      "Meshlets exceed the mesh shader's output limits");
+    }
+    meshletCount = (uint32_t) data.meshlets.size();
+
+    CreateBuffer(buffers[Vertices], vertices.data(), sizeof(Vertex) * vertices.size());
+    CreateBuffer(buffers[Meshlets], data.meshlets.data(), sizeof(Meshlet) * data.meshlets.size());
+    CreateBuffer(buffers[Bounds], data.bounds.data(), sizeof(MeshletBounds) * data.bounds.size());
+    CreateBuffer(buffers[MeshletVertices], data.vertices.data(), sizeof(uint32_t) * data.vertices.size());
+    CreateBuffer(buffers[MeshletTriangles], data.triangles.data(), data.triangles.size());
+
+    // Stages match reflection of the meshlet shaders, keeping the layout compatible with opted in pipelines
+    std::array<vk::DescriptorSetLayoutBinding, BindingCount> bindings = {
+        vk::DescriptorSetLayoutBinding(Vertices, vk::DescriptorType::eStorageBuffer, 1, meshletMeshStage),
+        vk::DescriptorSetLayoutBinding(Meshlets, vk::DescriptorType::eStorageBuffer, 1, meshletTaskStage | meshletMeshStage),
+        vk::DescriptorSetLayoutBinding(Bounds, vk::DescriptorType::eStorageBuffer, 1, meshletTaskStage),
+        vk::DescriptorSetLayoutBinding(MeshletVertices, vk::DescriptorType::eStorageBuffer, 1, meshletMeshStage),
+        vk::DescriptorSetLayoutBinding(MeshletTriangles, vk::DescriptorType::eStorageBuffer, 1, meshletMeshStage)
+    };
+
+    vk::DescriptorSetLayoutCreateInfo setLayoutCreateInfo;
+    setLayoutCreateInfo.bindingCount = (uint32_t) bindings.size();
+    setLayoutCreateInfo.pBindings = bindings.data();
+    setLayout.Create(setLayoutCreateInfo, owner);
+
+    vk::DescriptorSetAllocateInfo allocateInfo;
+    allocateInfo.descriptorPool = owner->DescriptorPool().VkType();
+    allocateInfo.descriptorSetCount = 1;
+    allocateInfo.pSetLayouts = setLayout.VkTypePtr();
+    DM_ASSERT_VK(owner->allocateDescriptorSets(&allocateInfo, &set));
+
+    std::array<vk::DescriptorBufferInfo, BindingCount> bufferInfos;
+    std::array<vk::WriteDescriptorSet, BindingCount> writes;
+    for (uint32_t i = 0; i < BindingCount; ++i)
+    {
+        bufferInfos[i] = vk::DescriptorBufferInfo(buffers[i].VkType(), 0, VK_WHOLE_SIZE);
+        writes[i] = vk::WriteDescriptorSet(set, i, 0, 1, vk::DescriptorType::eStorageBuffer, nullptr, &bufferInfos[i]);
+    }
+    owner->updateDescriptorSets((uint32_t) writes.size(), writes.data(), 0, nullptr);
+}
+
+void MeshletDrawer::Destroy()
+{
+    if (!created)
+        return;
+
+    // The set is returned with the descriptor pool, which doesn't free individual sets
+    set = nullptr;
+    setLayout.Destroy();
+    for (Buffer& buffer : buffers)
+        buffer.Destroy();
+    meshletCount = 0;
+    created = false;
+}
+
+void MeshletDrawer::CreateBuffer(Buffer& buffer, const void* data, vk::DeviceSize size)
+{
+    buffer.CreateStaged(
+        const_cast<void*>(data), size,
+        vk::BufferUsageFlagBits::eStorageBuffer,
+        VMA_MEMORY_USAGE_GPU_ONLY,
+        true,
+        false,
+        owner
+    );
+}
+
+void MeshletDrawer::Draw(CommandRecorder& recorder, vk::PipelineLayout layout, const glm::mat4& viewProjection,
+                         const glm::mat4& model, const glm::vec3& cameraPosition)
+{
+    DrawConstants constants = {};
+    constants.modelViewProjection = viewProjection * model;
+    // Rows of the inverse transpose are the columns of the inverse, keeping normals perpendicular under non-uniform scale
+    const glm::mat3 inverse = glm::inverse(glm::mat3(model));
+    for (uint32_t i = 0; i < 3; ++i)
+        constants.normalMatrix[i] = glm::vec4(inverse[i], 0.0f);
+    constants.cameraPosition = glm::vec4(LocalCameraPosition(model, cameraPosition), ScalesUniformly(model) ? 1.0f : 0.0f);
+
+    recorder.BindDescriptorSet(layout, DescriptorSetIndex::PerObject, set);
+    recorder.PushConstants(layout, meshletTaskStage | meshletMeshStage, 0, sizeof(DrawConstants), &constants);
+    recorder.DrawMeshTasks((meshletCount + taskWorkgroupSize - 1) / taskWorkgroupSize, 1, 1);
+}
+
+}
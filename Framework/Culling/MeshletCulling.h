@@ -0,0 +1,122 @@
+//------------------------------------------------------------------------------
+//
+// File Name:	MeshletCulling.h
+// Author(s):	Jonathan Bourim (j.bourim)
+// Date:        10/19/2026
+//
+//------------------------------------------------------------------------------
+#pragma once
+
+namespace dm
+{
+
+/**
+ * CPU culling of a mesh's meshlets against the view frustum and their normal cones.
+ * Tests run in the mesh's local space, and runs of visible meshlets, being consecutive
+ * in the mesh's index buffer, are drawn as one index range each.
+ *
+ * Per frame and mesh instance: Cull, then Draw with the mesh bound.
+ */
+class MeshletCuller
+{
+public:
+    struct Stats
+    {
+        uint32_t meshlets = 0;
+        uint32_t visible = 0;
+        uint32_t triangles = 0;             //< Triangles of visible meshlets
+        uint32_t ranges = 0;                //< Draws recorded per instance
+    };
+
+    /// \param data Meshlets built from the mesh's full detail level, see BuildMeshlets
+    /// \param model Local to world transform, cones are only tested when it scales uniformly
+    /// \param viewProjection Projection * view with a [0, 1] depth range
+    void Cull(const MeshletData& data, const glm::mat4& model, const glm::mat4& viewProjection,
+              const glm::vec3& cameraPosition);
+
+    /// \brief Record the visible ranges of the mesh the meshlets were built from, which must be bound
+    template<class VertexType>
+    void Draw(CommandRecorder& recorder, const Mesh<VertexType>& mesh, uint32_t instanceCount = 1,
+              uint32_t firstInstance = 0) const
+    {
+        for (const IndexRange& range : ranges)
+        {
+            recorder.DrawIndexed(range.indexCount, instanceCount, mesh.GetLodFirstIndex(0) + range.firstIndex,
+                                 (int32_t) mesh.GetVertexOffset(), firstInstance);
+        }
+    }
+
+    [[nodiscard]] const Stats& GetStats() const { return stats; }
+
+private:
+    struct IndexRange
+    {
+        uint32_t firstIndex;
+        uint32_t indexCount;
+    };
+
+    std::vector<IndexRange> ranges;         //< Reused across frames
+    Stats stats;
+};
+
+/**
+ * Mesh shader drawing of a meshlet mesh through VK_EXT_mesh_shader, see PhysicalDevice::meshShader.
+ * The task shader frustum and cone culls 32 meshlets per workgroup, launching a mesh shader
+ * workgroup for each visible one, which emits its vertices and triangles. The CPU records
+ * one draw per mesh instance.
+ *
+ * Opting in pipelines are read from taskShaderPath, meshShaderPath and a fragment shader taking the
+ * mesh shader's outputs, normal at location 0, color at 1 and texture coordinates at 2.
+ * The meshlet buffers are bound to the PerObject set, which the fragment shader mustn't use.
+ */
+class MeshletDrawer : public IOwned<Device>
+{
+public:
+DM_TYPE_OWNED_BODY(MeshletDrawer, IOwned<Device>)
+    ~MeshletDrawer() noexcept override;
+
+    static constexpr uint32_t taskWorkgroupSize = 32;
+    static constexpr const char* taskShaderPath = "Shaders/Meshlet.task.spv";
+    static constexpr const char* meshShaderPath = "Shaders/Meshlet.mesh.spv";
+
+    /// \brief Upload a mesh's vertices and meshlets for the mesh shaders
+    /// \param data Meshlets of the vertices, within MeshletData's default limits
+    void Create(Device* inOwner, const std::vector<Vertex>& vertices, const MeshletData& data);
+    void Destroy();
+
+    /// \brief Record the culled draw, inside a render pass with an opted in pipeline bound
+    /// \param layout Layout of the bound pipeline
+    /// \param model Local to world transform, cones are only tested when it scales uniformly
+    void Draw(CommandRecorder& recorder, vk::PipelineLayout layout, const glm::mat4& viewProjection,
+              const glm::mat4& model, const glm::vec3& cameraPosition);
+
+    [[nodiscard]] uint32_t MeshletCount() const { return meshletCount; }
+
+private:
+    enum Binding : uint32_t
+    {
+        Vertices = 0,
+        Meshlets,
+        Bounds,
+        MeshletVertices,
+        MeshletTriangles,
+        BindingCount
+    };
+
+    // Mirrored by the task and mesh shaders' push constant block, 128 bytes to fit every device
+    struct DrawConstants
+    {
+        glm::mat4 modelViewProjection;
+        glm::vec4 normalMatrix[3];      //< Rows of the model matrix's inverse transpose, transforming normals to world space
+        glm::vec4 cameraPosition;       //< In the mesh's local space, w disables cone culling when 0
+    };
+
+    void CreateBuffer(Buffer& buffer, const void* data, vk::DeviceSize size);
+
+    std::array<Buffer, BindingCount> buffers;
+    DescriptorSetLayout setLayout;
+    vk::DescriptorSet set = {};
+    uint32_t meshletCount = 0;
+};
+
+}
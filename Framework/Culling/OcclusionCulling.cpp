@@ -0,0 +1,425 @@
+//------------------------------------------------------------------------------
+//
+// File Name:	OcclusionCulling.cpp
+// Author(s):	Jonathan Bourim (j.bourim)
+// Date:        10/19/2026
+//
+//------------------------------------------------------------------------------
+
+#include "OcclusionCulling.h"
+
+namespace dm
+{
+
+namespace
+{
+
+constexpr uint32_t MinRowsPerBand = 8;
+constexpr uint32_t MinBoxesPerChunk = 4096;     //< Below this per thread, synchronization outweighs the work
+constexpr float MinClipW = 1e-6f;
+constexpr uint32_t MaxTestTexels = 4;           //< Box size in texels at the tested Hi-Z level, before alignment
+
+using OcclusionClock = std::chrono::steady_clock;
+
+float MillisecondsSince(OcclusionClock::time_point start)
+{
+    return std::chrono::duration<float, std::milli>(OcclusionClock::now() - start).count();
+}
+
+// Edge function A * x + B * y + C, positive inside a counter clockwise triangle
+struct RasterEdge
+{
+    float A;
+    float B;
+    float C;
+
+    RasterEdge(const glm::vec3& a, const glm::vec3& b)
+        : A(a.y - b.y)
+        , B(b.x - a.x)
+        , C(a.x * b.y - a.y * b.x)
+    {}
+};
+
+}
+
+void OcclusionCuller::Create(uint32_t inWidth, uint32_t inHeight)
+{
+    DM_ASSERT_MSG(inWidth > 0 && inWidth % 4 == 0 && inHeight > 0, "Occlusion buffer width must be a multiple of 4");
+    width = inWidth;
+    height = inHeight;
+
+    levels.clear();
+    uint32_t levelWidth = width;
+    uint32_t levelHeight = height;
+    while (true)
+    {
+        Level& level = levels.emplace_back();
+        level.width = levelWidth;
+        level.height = levelHeight;
+        level.depth.assign(levelWidth * levelHeight, 1.0f);
+        if (levelWidth == 1 && levelHeight == 1)
+            break;
+
+        levelWidth = std::max(1u, (levelWidth + 1) / 2);
+        levelHeight = std::max(1u, (levelHeight + 1) / 2);
+    }
+}
+
+uint32_t OcclusionCuller::AddOccluder(std::vector<glm::vec3> triangles)
+{
+    DM_ASSERT_MSG(triangles.size() % 3 == 0, "Occluders must be triangle lists");
+    occluders.emplace_back(std::move(triangles));
+    return (uint32_t) occluders.size() - 1;
+}
+
+void OcclusionCuller::ClearOccluders()
+{
+    occluders.clear();
+    instances.clear();
+}
+
+void OcclusionCuller::Begin(const glm::mat4& inViewProjection)
+{
+    DM_ASSERT_MSG(!levels.empty(), "Occlusion culler must be created before use");
+    viewProjection = inViewProjection;
+    instances.clear();
+    stats = {};
+}
+
+void OcclusionCuller::SubmitOccluder(uint32_t occluder, const glm::mat4& model)
+{
+    DM_ASSERT_MSG(occluder < occluders.size(), "Occluder ID out of range");
+    instances.push_back({ occluder, model });
+}
+
+void OcclusionCuller::Rasterize(ThreadPool* pool)
+{
+    const OcclusionClock::time_point start = OcclusionClock::now();
+    stats.occluders = (uint32_t) instances.size();
+
+    // Transform, clip and project occluders, striding instances across tasks to balance their sizes
+    uint32_t taskCount = 1;
+    if (pool != nullptr)
+        taskCount = std::clamp((uint32_t) instances.size(), 1u, pool->GetConcurrency());
+    taskTriangles.resize(std::max<size_t>(taskTriangles.size(), taskCount));
+    for (std::vector<ScreenTriangle>& triangles : taskTriangles)
+        triangles.clear();
+
+    auto setup = [&](uint32_t task)
+    {
+        for (size_t i = task; i < instances.size(); i += taskCount)
+            SetupTriangles(instances[i], taskTriangles[task]);
+    };
+
+    // Each band owns its rows of the depth buffer
+    uint32_t bandCount = 1;
+    if (pool != nullptr)
+        bandCount = std::clamp(height / MinRowsPerBand, 1u, pool->GetConcurrency());
+    const uint32_t rowsPerBand = (height + bandCount - 1) / bandCount;
+
+    std::fill(levels[0].depth.begin(), levels[0].depth.end(), 1.0f);
+    auto rasterize = [&](uint32_t band)
+    {
+        const uint32_t rowBegin = band * rowsPerBand;
+        RasterizeBand(rowBegin, std::min(rowBegin + rowsPerBand, height));
+    };
+
+    if (pool != nullptr)
+    {
+        pool->Dispatch(taskCount, setup);
+        pool->Dispatch(bandCount, rasterize);
+    }
+    else
+    {
+        setup(0);
+        rasterize(0);
+    }
+
+    for (const std::vector<ScreenTriangle>& triangles : taskTriangles)
+        stats.triangles += (uint32_t) triangles.size();
+
+    BuildHiZ();
+    stats.rasterizeMilliseconds += MillisecondsSince(start);
+}
+
+void OcclusionCuller::SetupTriangles(const OccluderInstance& instance, std::vector<ScreenTriangle>& triangles) const
+{
+    const glm::mat4 modelViewProjection = viewProjection * instance.model;
+    const std::vector<glm::vec3>& positions = occluders[instance.occluder];
+
+    auto project = [this](const glm::vec4& clip)
+    {
+        const float inverseW = 1.0f / clip.w;
+        return glm::vec3(
+            (clip.x * inverseW * 0.5f + 0.5f) * (float) width,
+            (clip.y * inverseW * 0.5f + 0.5f) * (float) height,
+            std::clamp(clip.z * inverseW, 0.0f, 1.0f)
+        );
+    };
+
+    for (size_t i = 0; i + 2 < positions.size(); i += 3)
+    {
+        const glm::vec4 clip[3] = {
+            modelViewProjection * glm::vec4(positions[i], 1.0f),
+            modelViewProjection * glm::vec4(positions[i + 1], 1.0f),
+            modelViewProjection * glm::vec4(positions[i + 2], 1.0f)
+        };
+
+        // Trivially reject triangles entirely outside one of the side or far planes
+        if ((clip[0].x > clip[0].w && clip[1].x > clip[1].w && clip[2].x > clip[2].w) ||
+            (clip[0].x < -clip[0].w && clip[1].x < -clip[1].w && clip[2].x < -clip[2].w) ||
+            (clip[0].y > clip[0].w && clip[1].y > clip[1].w && clip[2].y > clip[2].w) ||
+            (clip[0].y < -clip[0].w && clip[1].y < -clip[1].w && clip[2].y < -clip[2].w) ||
+            (clip[0].z > clip[0].w && clip[1].z > clip[1].w && clip[2].z > clip[2].w))
+            continue;
+
+        // Clip against the near plane, z >= 0, giving up to a quad
+        glm::vec4 polygon[4];
+        uint32_t polygonSize = 0;
+        for (uint32_t v = 0; v < 3; ++v)
+        {
+            const glm::vec4& current = clip[v];
+            const glm::vec4& next = clip[(v + 1) % 3];
+            if (current.z >= 0.0f)
+                polygon[polygonSize++] = current;
+            if ((current.z >= 0.0f) != (next.z >= 0.0f))
+                polygon[polygonSize++] = glm::mix(current, next, current.z / (current.z - next.z));
+        }
+
+        if (polygonSize < 3)
+            continue;
+
+        bool behindCamera = false;
+        for (uint32_t v = 0; v < polygonSize; ++v)
+            behindCamera |= polygon[v].w < MinClipW;
+        if (behindCamera)
+            continue;
+
+        const glm::vec3 first = project(polygon[0]);
+        glm::vec3 previous = project(polygon[1]);
+        for (uint32_t v = 2; v < polygonSize; ++v)
+        {
+            const glm::vec3 current = project(polygon[v]);
+            triangles.push_back({ { first, previous, current } });
+            previous = current;
+        }
+    }
+}
+
+void OcclusionCuller::RasterizeBand(uint32_t rowBegin, uint32_t rowEnd)
+{
+    float* depth = levels[0].depth.data();
+
+    for (const std::vector<ScreenTriangle>& triangles : taskTriangles)
+    {
+        for (const ScreenTriangle& triangle : triangles)
+        {
+            glm::vec3 v0 = triangle.vertices[0];
+            glm::vec3 v1 = triangle.vertices[1];
+            glm::vec3 v2 = triangle.vertices[2];
+
+            float area = (v1.x - v0.x) * (v2.y - v0.y) - (v2.x - v0.x) * (v1.y - v0.y);
+            if (area == 0.0f)
+                continue;
+
+            // Occluders are drawn double sided, wind every triangle counter clockwise
+            if (area < 0.0f)
+            {
+                std::swap(v1, v2);
+                area = -area;
+            }
+
+            const float minX = std::max(std::min({ v0.x, v1.x, v2.x }), 0.0f);
+            const float maxX = std::min(std::max({ v0.x, v1.x, v2.x }), (float) width - 1.0f);
+            const float minY = std::max(std::min({ v0.y, v1.y, v2.y }), (float) rowBegin);
+            const float maxY = std::min(std::max({ v0.y, v1.y, v2.y }), (float) rowEnd - 1.0f);
+            if (minX > maxX || minY > maxY)
+                continue;
+
+            const uint32_t x0 = (uint32_t) minX & ~3u;
+            const uint32_t x1 = (uint32_t) std::ceil(maxX);
+            const uint32_t y0 = (uint32_t) minY;
+            const uint32_t y1 = (uint32_t) std::ceil(maxY);
+
+            const RasterEdge e0(v1, v2);
+            const RasterEdge e1(v2, v0);
+            const RasterEdge e2(v0, v1);
+
+            // Depth is affine in screen space
+            const float dzdx = ((v1.z - v0.z) * (v2.y - v0.y) - (v2.z - v0.z) * (v1.y - v0.y)) / area;
+            const float dzdy = ((v2.z - v0.z) * (v1.x - v0.x) - (v1.z - v0.z) * (v2.x - v0.x)) / area;
+            const float dzc = v0.z - dzdx * v0.x - dzdy * v0.y;
+
+            for (uint32_t y = y0; y <= y1 && y < rowEnd; ++y)
+            {
+                const float py = (float) y + 0.5f;
+                float* row = depth + y * width;
+
+#if defined(DM_SIMD_SSE2)
+                const __m128 w0Row = _mm_set1_ps(e0.B * py + e0.C);
+                const __m128 w1Row = _mm_set1_ps(e1.B * py + e1.C);
+                const __m128 w2Row = _mm_set1_ps(e2.B * py + e2.C);
+                const __m128 zRow = _mm_set1_ps(dzdy * py + dzc);
+                const __m128 zero = _mm_setzero_ps();
+
+                __m128 px = _mm_add_ps(_mm_set1_ps((float) x0), _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f));
+                for (uint32_t x = x0; x <= x1; x += 4)
+                {
+                    const __m128 w0 = _mm_add_ps(w0Row, _mm_mul_ps(_mm_set1_ps(e0.A), px));
+                    const __m128 w1 = _mm_add_ps(w1Row, _mm_mul_ps(_mm_set1_ps(e1.A), px));
+                    const __m128 w2 = _mm_add_ps(w2Row, _mm_mul_ps(_mm_set1_ps(e2.A), px));
+                    const __m128 inside = _mm_and_ps(_mm_cmpge_ps(w0, zero),
+                                                     _mm_and_ps(_mm_cmpge_ps(w1, zero), _mm_cmpge_ps(w2, zero)));
+                    if (_mm_movemask_ps(inside) != 0)
+                    {
+                        const __m128 z = _mm_add_ps(zRow, _mm_mul_ps(_mm_set1_ps(dzdx), px));
+                        const __m128 previous = _mm_loadu_ps(row + x);
+                        const __m128 nearest = _mm_min_ps(previous, z);
+                        _mm_storeu_ps(row + x, _mm_or_ps(_mm_and_ps(inside, nearest), _mm_andnot_ps(inside, previous)));
+                    }
+                    px = _mm_add_ps(px, _mm_set1_ps(4.0f));
+                }
+#else
+                for (uint32_t x = x0; x <= x1; ++x)
+                {
+                    const float px = (float) x + 0.5f;
+                    if (e0.A * px + e0.B * py + e0.C < 0.0f ||
+                        e1.A * px + e1.B * py + e1.C < 0.0f ||
+                        e2.A * px + e2.B * py + e2.C < 0.0f)
+                        continue;
+
+                    row[x] = std::min(row[x], dzdx * px + dzdy * py + dzc);
+                }
+#endif
+            }
+        }
+    }
+}
+
+void OcclusionCuller::BuildHiZ()
+{
+    // Each texel keeps the furthest depth of its children, so a box behind it is behind every child
+    for (size_t l = 1; l < levels.size(); ++l)
+    {
+        const Level& source = levels[l - 1];
+        Level& destination = levels[l];
+        for (uint32_t y = 0; y < destination.height; ++y)
+        {
+            const uint32_t sy0 = y * 2;
+            const uint32_t sy1 = std::min(sy0 + 1, source.height - 1);
+            for (uint32_t x = 0; x < destination.width; ++x)
+            {
+                const uint32_t sx0 = x * 2;
+                const uint32_t sx1 = std::min(sx0 + 1, source.width - 1);
+                destination.depth[y * destination.width + x] = std::max(
+                    std::max(source.depth[sy0 * source.width + sx0], source.depth[sy0 * source.width + sx1]),
+                    std::max(source.depth[sy1 * source.width + sx0], source.depth[sy1 * source.width + sx1])
+                );
+            }
+        }
+    }
+}
+
+bool OcclusionCuller::IsVisible(const primitives::Box& box) const
+{
+    float minX = std::numeric_limits<float>::max();
+    float minY = std::numeric_limits<float>::max();
+    float maxX = std::numeric_limits<float>::lowest();
+    float maxY = std::numeric_limits<float>::lowest();
+    float nearest = std::numeric_limits<float>::max();
+
+    for (uint32_t corner = 0; corner < 8; ++corner)
+    {
+        const glm::vec3 offset(
+            corner & 1 ? box.halfExtent.x : -box.halfExtent.x,
+            corner & 2 ? box.halfExtent.y : -box.halfExtent.y,
+            corner & 4 ? box.halfExtent.z : -box.halfExtent.z
+        );
+        const glm::vec4 clip = viewProjection * glm::vec4(box.position + offset, 1.0f);
+
+        // Boxes crossing the near plane can't be bounded on screen
+        if (clip.z < 0.0f || clip.w < MinClipW)
+            return true;
+
+        const float inverseW = 1.0f / clip.w;
+        const float x = (clip.x * inverseW * 0.5f + 0.5f) * (float) width;
+        const float y = (clip.y * inverseW * 0.5f + 0.5f) * (float) height;
+        minX = std::min(minX, x);
+        maxX = std::max(maxX, x);
+        minY = std::min(minY, y);
+        maxY = std::max(maxY, y);
+        nearest = std::min(nearest, clip.z * inverseW);
+    }
+
+    // Outside of the screen is left to frustum culling
+    if (maxX < 0.0f || maxY < 0.0f || minX >= (float) width || minY >= (float) height)
+        return true;
+
+    const uint32_t x0 = (uint32_t) std::max(minX, 0.0f);
+    const uint32_t y0 = (uint32_t) std::max(minY, 0.0f);
+    const uint32_t x1 = (uint32_t) std::min(maxX, (float) width - 1.0f);
+    const uint32_t y1 = (uint32_t) std::min(maxY, (float) height - 1.0f);
+
+    // Finest level where the box covers at most 5x5 texels, coarser levels cull less as texels overhang the box
+    const uint32_t size = std::max(x1 - x0, y1 - y0) + 1;
+    uint32_t l = 0;
+    while (l + 1 < levels.size() && (size >> l) > MaxTestTexels)
+        ++l;
+
+    const Level& level = levels[l];
+    for (uint32_t y = y0 >> l; y <= (y1 >> l); ++y)
+    {
+        for (uint32_t x = x0 >> l; x <= (x1 >> l); ++x)
+        {
+            if (nearest <= level.depth[y * level.width + x])
+                return true;
+        }
+    }
+    return false;
+}
+
+void OcclusionCuller::Cull(const BoxBounds& bounds, std::vector<uint32_t>& visible, ThreadPool* pool)
+{
+    const OcclusionClock::time_point start = OcclusionClock::now();
+    const uint32_t count = (uint32_t) visible.size();
+
+    uint32_t chunkCount = 1;
+    if (pool != nullptr)
+        chunkCount = std::clamp(count / MinBoxesPerChunk, 1u, pool->GetConcurrency());
+    const uint32_t chunkSize = (count + chunkCount - 1) / chunkCount;
+
+    // Each chunk compacts its own slice of visible in place
+    std::vector<uint32_t> chunkVisible(chunkCount);
+    auto cullChunk = [&](uint32_t chunk)
+    {
+        const uint32_t begin = chunk * chunkSize;
+        const uint32_t end = std::min(begin + chunkSize, count);
+        uint32_t written = begin;
+        for (uint32_t i = begin; i < end; ++i)
+        {
+            const uint32_t index = visible[i];
+            if (IsVisible(bounds.Get(index)))
+                visible[written++] = index;
+        }
+        chunkVisible[chunk] = written - begin;
+    };
+
+    if (chunkCount > 1)
+        pool->Dispatch(chunkCount, cullChunk);
+    else
+        cullChunk(0);
+
+    uint32_t total = chunkVisible[0];
+    for (uint32_t chunk = 1; chunk < chunkCount; ++chunk)
+    {
+        std::memmove(visible.data() + total, visible.data() + chunk * chunkSize, chunkVisible[chunk] * sizeof(uint32_t));
+        total += chunkVisible[chunk];
+    }
+    visible.resize(total);
+
+    stats.tested += count;
+    stats.culled += count - total;
+    stats.testMilliseconds += MillisecondsSince(start);
+}
+
+}
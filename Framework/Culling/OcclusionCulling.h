@@ -0,0 +1,142 @@
+//------------------------------------------------------------------------------
+//
+// File Name:	OcclusionCulling.h
+// Author(s):	Jonathan Bourim (j.bourim)
+// Date:        10/19/2026
+//
+//------------------------------------------------------------------------------
+#pragma once
+
+namespace dm
+{
+
+class ThreadPool;
+
+/**
+ * Software occlusion culling against a small set of occluders.
+ * Occluder triangles are rasterized into a low resolution CPU depth buffer, reduced into a
+ * Hi-Z pyramid storing the furthest depth of each texel, and boxes whose nearest depth lies
+ * behind every texel they cover are culled.
+ *
+ * Depth is sampled at pixel centers, so occluders should be simplified proxies lying inside
+ * the geometry they stand in for. Boxes crossing the near plane are always visible.
+ *
+ * Per frame: Begin, SubmitOccluder for each occluder instance, Rasterize, then Cull or IsVisible.
+ */
+class OcclusionCuller
+{
+public:
+    static constexpr uint32_t defaultWidth = 256;
+    static constexpr uint32_t defaultHeight = 128;
+
+    struct Stats
+    {
+        uint32_t occluders = 0;             //< Occluder instances submitted
+        uint32_t triangles = 0;             //< Occluder triangles rasterized, after clipping
+        uint32_t tested = 0;
+        uint32_t culled = 0;
+        float rasterizeMilliseconds = 0.0f; //< Includes building the Hi-Z pyramid
+        float testMilliseconds = 0.0f;
+    };
+
+    /// \param inWidth Depth buffer width, a multiple of 4
+    void Create(uint32_t inWidth = defaultWidth, uint32_t inHeight = defaultHeight);
+
+    /// \brief Register occluder geometry
+    /// \param triangles Local space triangle list
+    /// \return Occluder ID passed to SubmitOccluder
+    uint32_t AddOccluder(std::vector<glm::vec3> triangles);
+
+    /// \brief Register CPU side mesh data, typically a simplified proxy kept from import, as occluder geometry.
+    ///        Only dynamic meshes keep their buffers mapped, see Mesh::GetDataView.
+    ///        VertexType can't be deduced from the nested type, e.g. AddOccluder<Vertex>(data).
+    template<class VertexType>
+    uint32_t AddOccluder(const typename Mesh<VertexType>::View& view)
+    {
+        std::vector<glm::vec3> triangles;
+        if (view.indexCount > 0)
+        {
+            triangles.resize(view.indexCount);
+            for (uint32_t i = 0; i < view.indexCount; ++i)
+                triangles[i] = view.vertices[view.indices[i]].pos;
+        }
+        else
+        {
+            triangles.resize(view.vertexCount);
+            for (uint32_t i = 0; i < view.vertexCount; ++i)
+                triangles[i] = view.vertices[i].pos;
+        }
+        return AddOccluder(std::move(triangles));
+    }
+
+    template<class VertexType>
+    uint32_t AddOccluder(const typename Mesh<VertexType>::Data& data)
+    {
+        const typename Mesh<VertexType>::View view = {
+            data.vertices.data(), (uint32_t) data.vertices.size(),
+            data.indices.data(), (uint32_t) data.indices.size()
+        };
+        return AddOccluder<VertexType>(view);
+    }
+
+    void ClearOccluders();
+
+    /// \brief Start a frame, clearing the depth buffer, queued occluders and stats
+    /// \param viewProjection Projection * view with a [0, 1] depth range
+    void Begin(const glm::mat4& viewProjection);
+
+    /// \brief Queue an occluder instance for Rasterize
+    void SubmitOccluder(uint32_t occluder, const glm::mat4& model);
+
+    /// \brief Rasterize the queued occluders and build the Hi-Z pyramid
+    /// \param pool Optional thread pool, occluders are transformed in parallel and each thread rasterizes a band of rows
+    void Rasterize(ThreadPool* pool = nullptr);
+
+    /// \brief Test a world space box against the rasterized occluders
+    [[nodiscard]] bool IsVisible(const primitives::Box& box) const;
+
+    /// \brief Remove occluded boxes from visible, typically the output of FrustumCull on the same bounds
+    /// \param pool Optional thread pool, each thread tests a contiguous chunk
+    void Cull(const BoxBounds& bounds, std::vector<uint32_t>& visible, ThreadPool* pool = nullptr);
+
+    [[nodiscard]] uint32_t Width() const { return width; }
+    [[nodiscard]] uint32_t Height() const { return height; }
+
+    /// \brief Rasterized depth, row major with 1 where no occluder was drawn
+    [[nodiscard]] const std::vector<float>& GetDepth() const { return levels[0].depth; }
+    [[nodiscard]] const Stats& GetStats() const { return stats; }
+
+private:
+    struct ScreenTriangle
+    {
+        glm::vec3 vertices[3];  //< Pixel coordinates and depth
+    };
+
+    struct Level
+    {
+        std::vector<float> depth;
+        uint32_t width = 0;
+        uint32_t height = 0;
+    };
+
+    struct OccluderInstance
+    {
+        uint32_t occluder;
+        glm::mat4 model;
+    };
+
+    void SetupTriangles(const OccluderInstance& instance, std::vector<ScreenTriangle>& triangles) const;
+    void RasterizeBand(uint32_t rowBegin, uint32_t rowEnd);
+    void BuildHiZ();
+
+    std::vector<std::vector<glm::vec3>> occluders;
+    std::vector<OccluderInstance> instances;
+    std::vector<std::vector<ScreenTriangle>> taskTriangles;     //< Set up per task, reused across frames
+    std::vector<Level> levels;                                  //< Hi-Z pyramid, level 0 is the depth buffer
+    glm::mat4 viewProjection = glm::mat4(1.0f);
+    uint32_t width = 0;
+    uint32_t height = 0;
+    Stats stats;
+};
+
+}
@@ -0,0 +1,333 @@
+//------------------------------------------------------------------------------
+//
+// File Name:	GeometryPool.cpp
+// Author(s):	Jonathan Bourim (j.bourim)
+// Date:        10/19/2026
+//
+//------------------------------------------------------------------------------
+
+#include "GeometryPool.h"
+
+namespace dm
+{
+
+static const vk::BufferUsageFlags poolTransferUsage =
+    vk::BufferUsageFlagBits::eTransferDst | vk::BufferUsageFlagBits::eTransferSrc | vk::BufferUsageFlagBits::eStorageBuffer;
+
+void RangeAllocator::Create(uint32_t inCapacity)
+{
+    freeByOffset.clear();
+    freeBySize.clear();
+    allocations.clear();
+    capacity = inCapacity;
+    used = 0;
+    if (capacity > 0)
+        InsertFree(0, capacity);
+}
+
+void RangeAllocator::InsertFree(uint32_t offset, uint32_t count)
+{
+    freeByOffset.emplace(offset, count);
+    freeBySize.emplace(count, offset);
+}
+
+void RangeAllocator::EraseFree(std::map<uint32_t, uint32_t>::iterator it)
+{
+    auto range = freeBySize.equal_range(it->second);
+    for (auto sizeIt = range.first; sizeIt != range.second; ++sizeIt)
+    {
+        if (sizeIt->second == it->first)
+        {
+            freeBySize.erase(sizeIt);
+            break;
+        }
+    }
+    freeByOffset.erase(it);
+}
+
+uint32_t RangeAllocator::Allocate(uint32_t count)
+{
+    DM_ASSERT_MSG(count > 0, "Attempting to allocate an empty range");
+
+    auto sizeIt = freeBySize.lower_bound(count);
+    if (sizeIt == freeBySize.end())
+        return invalidOffset;
+
+    const uint32_t offset = sizeIt->second;
+    const uint32_t freeCount = sizeIt->first;
+    EraseFree(freeByOffset.find(offset));
+    if (freeCount > count)
+        InsertFree(offset + count, freeCount - count);
+
+    allocations.emplace(offset, count);
+    used += count;
+    return offset;
+}
+
+void RangeAllocator::Free(uint32_t offset)
+{
+    auto it = allocations.find(offset);
+    DM_ASSERT_MSG(it != allocations.end(), "Attempting to free a range that isn't allocated");
+
+    uint32_t count = it->second;
+    used -= count;
+    allocations.erase(it);
+
+    // Coalesce with the free ranges on either side
+    auto next = freeByOffset.lower_bound(offset);
+    if (next != freeByOffset.end() && next->first == offset + count)
+    {
+        count += next->second;
+        EraseFree(next);
+    }
+
+    auto prev = freeByOffset.lower_bound(offset);
+    if (prev != freeByOffset.begin())
+    {
+        --prev;
+        if (prev->first + prev->second == offset)
+        {
+            offset = prev->first;
+            count += prev->second;
+            EraseFree(prev);
+        }
+    }
+
+    InsertFree(offset, count);
+}
+
+void RangeAllocator::Grow(uint32_t newCapacity)
+{
+    DM_ASSERT_MSG(newCapacity >= capacity, "Range allocators can't shrink");
+    if (newCapacity == capacity)
+        return;
+
+    uint32_t offset = capacity;
+    uint32_t count = newCapacity - capacity;
+    capacity = newCapacity;
+
+    // Merge into a free range ending at the old capacity
+    if (!freeByOffset.empty())
+    {
+        auto last = std::prev(freeByOffset.end());
+        if (last->first + last->second == offset)
+        {
+            offset = last->first;
+            count += last->second;
+            EraseFree(last);
+        }
+    }
+
+    InsertFree(offset, count);
+}
+
+GeometryPool::~GeometryPool() noexcept
+{
+    Destroy();
+}
+
+void GeometryPool::Create(Device* inOwner, uint32_t inVertexCapacity, uint32_t inIndexCapacity)
+{
+    Destroy();
+    IOwned::CreateOwned(inOwner);
+
+    vertexCapacity = inVertexCapacity;
+    indexBuffer = CreateBuffer(sizeof(uint32_t) * (vk::DeviceSize) inIndexCapacity,
+                               vk::BufferUsageFlagBits::eIndexBuffer | poolTransferUsage);
+    indexAllocator.Create(inIndexCapacity);
+}
+
+void GeometryPool::Destroy()
+{
+    if (!created)
+        return;
+
+    arenas.clear();
+    arenaLookup.clear();
+    indexBuffer.reset();
+    created = false;
+}
+
+std::unique_ptr<Buffer> GeometryPool::CreateBuffer(vk::DeviceSize size, vk::BufferUsageFlags usage)
+{
+    vk::BufferCreateInfo bufferCreateInfo;
+    bufferCreateInfo.usage = usage;
+    bufferCreateInfo.size = size;
+
+    VmaAllocationCreateInfo allocCreateInfo = {};
+    allocCreateInfo.usage = VMA_MEMORY_USAGE_GPU_ONLY;
+
+    auto buffer = std::make_unique<Buffer>();
+    buffer->Create(bufferCreateInfo, allocCreateInfo, owner);
+    return buffer;
+}
+
+uint32_t GeometryPool::GetArena(std::type_index type, uint32_t stride)
+{
+    DM_ASSERT_MSG(created, "Geometry pool must be created before allocating");
+
+    auto it = arenaLookup.find(type);
+    if (it != arenaLookup.end())
+        return it->second;
+
+    Arena& arena = arenas.emplace_back();
+    arena.stride = stride;
+    arena.buffer = CreateBuffer((vk::DeviceSize) stride * vertexCapacity,
+                                vk::BufferUsageFlagBits::eVertexBuffer | poolTransferUsage);
+    arena.allocator.Create(vertexCapacity);
+
+    const auto index = (uint32_t) (arenas.size() - 1);
+    arenaLookup.emplace(type, index);
+    return index;
+}
+
+void GeometryPool::Grow(std::unique_ptr<Buffer>& buffer, RangeAllocator& allocator, uint32_t stride,
+                        uint32_t required, vk::BufferUsageFlags usage)
+{
+    const uint32_t oldCapacity = allocator.Capacity();
+    const uint32_t newCapacity = std::max(oldCapacity + required, oldCapacity * 2);
+
+    std::unique_ptr<Buffer> grown = CreateBuffer((vk::DeviceSize) stride * newCapacity, usage);
+
+    // Single submits wait for the queue to idle, so the old buffer is no longer in use afterwards
+    CommandPool& commandPool = OwnerGet<Renderer>().commandPool;
+    auto commandBuffer = commandPool.BeginCommandBuffer();
+    vk::BufferCopy region(0, 0, (vk::DeviceSize) stride * oldCapacity);
+    commandBuffer->copyBuffer(buffer->VkType(), grown->VkType(), 1, &region);
+    commandPool.EndCommandBuffer(commandBuffer.get());
+
+    buffer = std::move(grown);
+    allocator.Grow(newCapacity);
+    ++generation;
+}
+
+GeometryAllocation GeometryPool::Allocate(uint32_t arenaIndex, const void* vertices, uint32_t vertexCount,
+                                          const uint32_t* indices, uint32_t indexCount)
+{
+    DM_ASSERT_MSG(vertexCount > 0, "Attempting to pool a mesh without vertices");
+    Arena& arena = arenas[arenaIndex];
+
+    GeometryAllocation allocation;
+    allocation.arena = arenaIndex;
+    allocation.vertexCount = vertexCount;
+    allocation.indexCount = indexCount;
+
+    allocation.vertexOffset = arena.allocator.Allocate(vertexCount);
+    if (allocation.vertexOffset == RangeAllocator::invalidOffset)
+    {
+        Grow(arena.buffer, arena.allocator, arena.stride, vertexCount,
+             vk::BufferUsageFlagBits::eVertexBuffer | poolTransferUsage);
+        allocation.vertexOffset = arena.allocator.Allocate(vertexCount);
+    }
+
+    if (indexCount > 0)
+    {
+        allocation.firstIndex = indexAllocator.Allocate(indexCount);
+        if (allocation.firstIndex == RangeAllocator::invalidOffset)
+        {
+            Grow(indexBuffer, indexAllocator, sizeof(uint32_t), indexCount,
+                 vk::BufferUsageFlagBits::eIndexBuffer | poolTransferUsage);
+            allocation.firstIndex = indexAllocator.Allocate(indexCount);
+        }
+    }
+
+    // Stage vertices and indices through a single buffer and copy both in one submission
+    const vk::DeviceSize vertexBytes = (vk::DeviceSize) arena.stride * vertexCount;
+    const vk::DeviceSize indexBytes = sizeof(uint32_t) * (vk::DeviceSize) indexCount;
+
+    vk::BufferCreateInfo stagingCreateInfo;
+    stagingCreateInfo.usage = vk::BufferUsageFlagBits::eTransferSrc;
+    stagingCreateInfo.size = vertexBytes + indexBytes;
+
+    VmaAllocationCreateInfo stagingAllocCreateInfo = {};
+    stagingAllocCreateInfo.usage = VMA_MEMORY_USAGE_CPU_ONLY;
+    stagingAllocCreateInfo.flags = VMA_ALLOCATION_CREATE_MAPPED_BIT;
+
+    Buffer staging;
+    staging.Create(stagingCreateInfo, stagingAllocCreateInfo, owner);
+    auto* mapped = static_cast<char*>(staging.allocationInfo.pMappedData);
+    std::memcpy(mapped, vertices, (size_t) vertexBytes);
+    if (indexCount > 0)
+        std::memcpy(mapped + vertexBytes, indices, (size_t) indexBytes);
+
+    CommandPool& commandPool = OwnerGet<Renderer>().commandPool;
+    auto commandBuffer = commandPool.BeginCommandBuffer();
+    vk::BufferCopy vertexRegion(0, (vk::DeviceSize) arena.stride * allocation.vertexOffset, vertexBytes);
+    commandBuffer->copyBuffer(staging.VkType(), arena.buffer->VkType(), 1, &vertexRegion);
+    if (indexCount > 0)
+    {
+        vk::BufferCopy indexRegion(vertexBytes, sizeof(uint32_t) * (vk::DeviceSize) allocation.firstIndex, indexBytes);
+        commandBuffer->copyBuffer(staging.VkType(), indexBuffer->VkType(), 1, &indexRegion);
+    }
+    commandPool.EndCommandBuffer(commandBuffer.get());
+
+    return allocation;
+}
+
+void GeometryPool::Free(const GeometryAllocation& allocation)
+{
+    // Handles may outlive the pool at shutdown, its buffers and ranges are already released
+    if (!created)
+        return;
+
+    DM_ASSERT_MSG(allocation.IsValid() && allocation.arena < arenas.size(), "Attempting to free an invalid geometry allocation");
+
+    arenas[allocation.arena].allocator.Free(allocation.vertexOffset);
+    if (allocation.indexCount > 0)
+        indexAllocator.Free(allocation.firstIndex);
+}
+
+GeometryPool::Stats GeometryPool::GetStats() const
+{
+    Stats stats;
+    stats.vertexBuffers = (uint32_t) arenas.size();
+    for (const Arena& arena : arenas)
+    {
+        stats.allocations += arena.allocator.AllocationCount();
+        stats.vertexBytesUsed += (vk::DeviceSize) arena.stride * arena.allocator.Used();
+        stats.vertexBytesCapacity += (vk::DeviceSize) arena.stride * arena.allocator.Capacity();
+    }
+    stats.indexBytesUsed = sizeof(uint32_t) * (vk::DeviceSize) indexAllocator.Used();
+    stats.indexBytesCapacity = sizeof(uint32_t) * (vk::DeviceSize) indexAllocator.Capacity();
+    return stats;
+}
+
+GeometryHandle::GeometryHandle(GeometryPool* inPool, const GeometryAllocation& inAllocation)
+    : pool(inPool), allocation(inAllocation)
+{
+}
+
+GeometryHandle::GeometryHandle(GeometryHandle&& other) noexcept
+{
+    *this = std::move(other);
+}
+
+GeometryHandle& GeometryHandle::operator=(GeometryHandle&& other) noexcept
+{
+    if (this != &other)
+    {
+        Reset();
+        pool = other.pool;
+        allocation = other.allocation;
+        other.pool = nullptr;
+        other.allocation = {};
+    }
+    return *this;
+}
+
+GeometryHandle::~GeometryHandle()
+{
+    Reset();
+}
+
+void GeometryHandle::Reset()
+{
+    if (pool)
+    {
+        pool->Free(allocation);
+        pool = nullptr;
+        allocation = {};
+    }
+}
+
+}
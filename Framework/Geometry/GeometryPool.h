@@ -0,0 +1,168 @@
+//------------------------------------------------------------------------------
+//
+// File Name:	GeometryPool.h
+// Author(s):	Jonathan Bourim (j.bourim)
+// Date:        10/19/2026
+//
+//------------------------------------------------------------------------------
+#pragma once
+
+namespace dm
+{
+
+/**
+ * Best fit free-list suballocator over a range of elements.
+ * Freed ranges are coalesced with their free neighbours.
+ */
+class RangeAllocator
+{
+public:
+    static constexpr uint32_t invalidOffset = ~0u;
+
+    void Create(uint32_t inCapacity);
+
+    /// \brief Allocate count contiguous elements
+    /// \return Offset of the first element, invalidOffset if no free range is large enough
+    uint32_t Allocate(uint32_t count);
+    void Free(uint32_t offset);
+
+    /// \brief Extend the range, the added elements are free
+    void Grow(uint32_t newCapacity);
+
+    [[nodiscard]] uint32_t Capacity() const { return capacity; }
+    [[nodiscard]] uint32_t Used() const { return used; }
+    [[nodiscard]] uint32_t AllocationCount() const { return (uint32_t) allocations.size(); }
+
+private:
+    void InsertFree(uint32_t offset, uint32_t count);
+    void EraseFree(std::map<uint32_t, uint32_t>::iterator it);
+
+    std::map<uint32_t, uint32_t> freeByOffset;          //< Offset to count
+    std::multimap<uint32_t, uint32_t> freeBySize;       //< Count to offset
+    std::unordered_map<uint32_t, uint32_t> allocations; //< Offset to count
+    uint32_t capacity = 0;
+    uint32_t used = 0;
+};
+
+struct GeometryAllocation
+{
+    uint32_t arena = RangeAllocator::invalidOffset;     //< Vertex buffer of the pool, one per vertex layout
+    uint32_t vertexOffset = 0;                          //< First vertex in the arena's vertex buffer
+    uint32_t vertexCount = 0;
+    uint32_t firstIndex = 0;                            //< First index in the pool's index buffer
+    uint32_t indexCount = 0;
+
+    [[nodiscard]] bool IsValid() const { return arena != RangeAllocator::invalidOffset; }
+};
+
+/**
+ * Shared vertex and index buffers that static meshes are suballocated from,
+ * so meshes of the same vertex layout share their binds.
+ * Vertex data is pooled per vertex type, indices are shared by every layout and
+ * stay relative to their mesh's first vertex.
+ */
+class GeometryPool : public IOwned<Device>
+{
+public:
+DM_TYPE_OWNED_BODY(GeometryPool, IOwned<Device>)
+    ~GeometryPool() noexcept override;
+
+    /// \param inVertexCapacity Initial vertices of each layout's buffer
+    /// \param inIndexCapacity Initial indices of the shared index buffer
+    void Create(Device* inOwner, uint32_t inVertexCapacity = 1u << 18, uint32_t inIndexCapacity = 1u << 20);
+    void Destroy();
+
+    /// \brief Suballocate and upload a mesh's geometry, growing the pool if needed.
+    ///        Growing waits for the device, and invalidates recorded command buffers binding the pool, see GetGeneration.
+    template<class VertexType>
+    GeometryAllocation Allocate(const std::vector<VertexType>& vertices, const std::vector<uint32_t>& indices)
+    {
+        return Allocate(vertices.data(), (uint32_t) vertices.size(), indices.data(), (uint32_t) indices.size());
+    }
+
+    template<class VertexType>
+    GeometryAllocation Allocate(const VertexType* vertices, uint32_t vertexCount, const uint32_t* indices, uint32_t indexCount)
+    {
+        static_assert(std::is_trivially_copyable<VertexType>::value, "Pooled vertices are copied directly to the GPU");
+        const uint32_t arena = GetArena(typeid(VertexType), sizeof(VertexType));
+        return Allocate(arena, vertices, vertexCount, indices, indexCount);
+    }
+
+    /// \brief Return allocation's ranges to the pool, does nothing once the pool is destroyed
+    void Free(const GeometryAllocation& allocation);
+
+    template<class VertexType>
+    [[nodiscard]] vk::Buffer GetVertexBuffer() const
+    {
+        auto it = arenaLookup.find(typeid(VertexType));
+        DM_ASSERT_MSG(it != arenaLookup.end(), "No geometry of this vertex type has been pooled");
+        return GetVertexBuffer(it->second);
+    }
+
+    [[nodiscard]] vk::Buffer GetVertexBuffer(uint32_t arena) const { return arenas[arena].buffer->VkType(); }
+    [[nodiscard]] vk::Buffer GetIndexBuffer() const { return indexBuffer->VkType(); }
+
+    /// \brief Incremented each time a buffer is replaced by growth
+    [[nodiscard]] uint32_t GetGeneration() const { return generation; }
+
+    struct Stats
+    {
+        uint32_t vertexBuffers = 0;
+        uint32_t allocations = 0;
+        vk::DeviceSize vertexBytesUsed = 0;
+        vk::DeviceSize vertexBytesCapacity = 0;
+        vk::DeviceSize indexBytesUsed = 0;
+        vk::DeviceSize indexBytesCapacity = 0;
+    };
+
+    [[nodiscard]] Stats GetStats() const;
+
+private:
+    struct Arena
+    {
+        std::unique_ptr<Buffer> buffer;
+        RangeAllocator allocator;
+        uint32_t stride = 0;
+    };
+
+    uint32_t GetArena(std::type_index type, uint32_t stride);
+    GeometryAllocation Allocate(uint32_t arena, const void* vertices, uint32_t vertexCount,
+                                const uint32_t* indices, uint32_t indexCount);
+    std::unique_ptr<Buffer> CreateBuffer(vk::DeviceSize size, vk::BufferUsageFlags usage);
+    void Grow(std::unique_ptr<Buffer>& buffer, RangeAllocator& allocator, uint32_t stride,
+              uint32_t required, vk::BufferUsageFlags usage);
+
+    std::vector<Arena> arenas;
+    std::unordered_map<std::type_index, uint32_t> arenaLookup;
+    std::unique_ptr<Buffer> indexBuffer;
+    RangeAllocator indexAllocator;
+    uint32_t vertexCapacity = 0;
+    uint32_t generation = 0;
+};
+
+/**
+ * Owns a GeometryPool allocation, freeing it on destruction.
+ */
+class GeometryHandle
+{
+public:
+    GeometryHandle() = default;
+    GeometryHandle(GeometryPool* inPool, const GeometryAllocation& inAllocation);
+    GeometryHandle(GeometryHandle&& other) noexcept;
+    GeometryHandle& operator=(GeometryHandle&& other) noexcept;
+    GeometryHandle(const GeometryHandle& other) = delete;
+    GeometryHandle& operator=(const GeometryHandle& other) = delete;
+    ~GeometryHandle();
+
+    void Reset();
+
+    [[nodiscard]] const GeometryAllocation& Get() const { return allocation; }
+    [[nodiscard]] GeometryPool* GetPool() const { return pool; }
+    explicit operator bool() const { return pool != nullptr; }
+
+private:
+    GeometryPool* pool = nullptr;
+    GeometryAllocation allocation;
+};
+
+}
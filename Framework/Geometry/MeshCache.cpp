@@ -0,0 +1,313 @@
+//------------------------------------------------------------------------------
+//
+// File Name:	MeshCache.cpp
+// Author(s):	Jonathan Bourim (j.bourim)
+// Date:        10/19/2026
+//
+//------------------------------------------------------------------------------
+
+#include "MeshCache.h"
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace dm
+{
+
+namespace
+{
+
+struct MeshCacheAttribute
+{
+    uint32_t format;
+    uint32_t offset;
+};
+
+uint64_t AlignCacheOffset(uint64_t offset)
+{
+    return (offset + CacheFile::blobAlignment - 1) & ~(CacheFile::blobAlignment - 1);
+}
+
+// Unique per write, so concurrent writers of one file, in this process or another, never share a temporary file
+std::string CacheTemporaryPath(const std::string& path)
+{
+    static std::atomic<uint32_t> writeCount{ 0 };
+#if defined(_WIN32)
+    const unsigned long process = GetCurrentProcessId();
+#else
+    const unsigned long process = (unsigned long) getpid();
+#endif
+    return path + "." + std::to_string(process) + "." + std::to_string(writeCount++) + ".tmp";
+}
+
+uint64_t MeshCacheLodOffset(uint32_t attributeCount)
+{
+    return sizeof(MeshCacheHeader) + sizeof(MeshCacheAttribute) * attributeCount;
+}
+
+uint64_t MeshCacheTableEnd(const MeshCacheHeader& header)
+{
+    return MeshCacheLodOffset(header.attributeCount) + sizeof(LodRange) * header.lodCount;
+}
+
+}
+
+MappedFile::~MappedFile()
+{
+    Close();
+}
+
+bool MappedFile::Open(const std::string& path)
+{
+    Close();
+
+#if defined(_WIN32)
+    HANDLE handle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (handle == INVALID_HANDLE_VALUE)
+        return false;
+
+    LARGE_INTEGER fileSize = {};
+    if (!GetFileSizeEx(handle, &fileSize) || fileSize.QuadPart == 0)
+    {
+        CloseHandle(handle);
+        return false;
+    }
+
+    HANDLE mappingHandle = CreateFileMappingA(handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    void* view = mappingHandle ? MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (!view)
+    {
+        if (mappingHandle)
+            CloseHandle(mappingHandle);
+        CloseHandle(handle);
+        return false;
+    }
+
+    file = handle;
+    mapping = mappingHandle;
+    data = static_cast<const uint8_t*>(view);
+    size = (size_t) fileSize.QuadPart;
+#else
+    int descriptor = open(path.c_str(), O_RDONLY);
+    if (descriptor < 0)
+        return false;
+
+    struct stat status = {};
+    if (fstat(descriptor, &status) != 0 || status.st_size == 0)
+    {
+        close(descriptor);
+        return false;
+    }
+
+    void* view = mmap(nullptr, (size_t) status.st_size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+    if (view == MAP_FAILED)
+    {
+        close(descriptor);
+        return false;
+    }
+
+    // Mapped files are read front to back, once
+    madvise(view, (size_t) status.st_size, MADV_SEQUENTIAL);
+    madvise(view, (size_t) status.st_size, MADV_WILLNEED);
+
+    file = descriptor;
+    data = static_cast<const uint8_t*>(view);
+    size = (size_t) status.st_size;
+#endif
+    return true;
+}
+
+void MappedFile::Close()
+{
+    if (!data)
+        return;
+
+#if defined(_WIN32)
+    UnmapViewOfFile(data);
+    CloseHandle(mapping);
+    CloseHandle(file);
+    mapping = nullptr;
+    file = nullptr;
+#else
+    munmap(const_cast<uint8_t*>(data), size);
+    close(file);
+    file = -1;
+#endif
+    data = nullptr;
+    size = 0;
+}
+
+CacheFile::Layout CacheFile::GetLayout(uint64_t tableEnd, uint32_t vertexStride, uint32_t vertexCount)
+{
+    Layout layout;
+    layout.vertexOffset = AlignCacheOffset(tableEnd);
+    layout.indexOffset = AlignCacheOffset(layout.vertexOffset + (uint64_t) vertexStride * vertexCount);
+    return layout;
+}
+
+uint64_t CacheFile::HashBytes(uint64_t hash, const void* data, size_t size)
+{
+    // Finished with the MurmurHash3 finalizer per call, so calls chain
+    constexpr uint64_t multiplier = 0x9e3779b97f4a7c15ull;
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    hash ^= size;
+    size_t i = 0;
+    for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t))
+    {
+        uint64_t word;
+        std::memcpy(&word, bytes + i, sizeof(uint64_t));
+        hash = ((hash ^ word) * multiplier);
+        hash = (hash << 31) | (hash >> 33);
+    }
+
+    uint64_t tail = 0;
+    std::memcpy(&tail, bytes + i, size - i);
+    return detail::MixVertexHash(hash ^ tail);
+}
+
+bool CacheFile::Write(const std::string& path, std::initializer_list<Section> sections, const Layout& layout,
+                      const void* vertices, uint64_t vertexBytes, const uint32_t* indices, uint32_t indexCount)
+{
+    const std::string temporaryPath = CacheTemporaryPath(path);
+    {
+        std::ofstream stream(temporaryPath, std::ios::binary | std::ios::trunc);
+        if (!stream)
+            return false;
+
+        const char padding[blobAlignment] = {};
+        auto pad = [&](uint64_t offset)
+        {
+            stream.write(padding, (std::streamsize) (offset - (uint64_t) stream.tellp()));
+        };
+
+        for (const Section& section : sections)
+            stream.write(static_cast<const char*>(section.data), (std::streamsize) section.size);
+        pad(layout.vertexOffset);
+        stream.write(static_cast<const char*>(vertices), (std::streamsize) vertexBytes);
+        pad(layout.indexOffset);
+        stream.write(reinterpret_cast<const char*>(indices), (std::streamsize) (sizeof(uint32_t) * indexCount));
+
+        if (!stream)
+        {
+            stream.close();
+            std::remove(temporaryPath.c_str());
+            return false;
+        }
+    }
+
+    std::remove(path.c_str());
+    if (std::rename(temporaryPath.c_str(), path.c_str()) != 0)
+    {
+        std::remove(temporaryPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+uint64_t MeshCache::HashFile(const std::string& path)
+{
+    MappedFile source;
+    if (!source.Open(path))
+        return 0;
+
+    // 0 is reserved for unreadable files
+    const uint64_t hash = CacheFile::HashBytes(0, source.Data(), source.Size());
+    return hash != 0 ? hash : 1;
+}
+
+bool MeshCache::WriteFile(const std::string& path, MeshCacheHeader header, const VertexAttributes& attributes,
+                          const std::vector<LodRange>& lods, const void* vertices, const uint32_t* indices)
+{
+    header.reserved = 0;
+    header.attributeCount = (uint32_t) attributes.size();
+    header.lodCount = (uint32_t) lods.size();
+    const CacheFile::Layout layout = CacheFile::GetLayout(MeshCacheTableEnd(header), header.vertexStride, header.vertexCount);
+    header.vertexOffset = layout.vertexOffset;
+    header.indexOffset = layout.indexOffset;
+
+    std::vector<MeshCacheAttribute> packed;
+    packed.reserve(attributes.size());
+    for (const VertexAttribute& attribute : attributes)
+        packed.push_back({ (uint32_t) attribute.format, attribute.offset });
+
+    return CacheFile::Write(path, {
+        { &header, sizeof(header) },
+        { packed.data(), sizeof(MeshCacheAttribute) * packed.size() },
+        { lods.data(), sizeof(LodRange) * lods.size() }
+    }, layout, vertices, (uint64_t) header.vertexStride * header.vertexCount, indices, header.indexCount);
+}
+
+bool MeshCache::OpenFile(const std::string& path, uint64_t sourceHash, uint32_t optimizeFlags,
+                         const MeshLodSettings& lodSettings, uint32_t vertexStride, const VertexAttributes& attributes)
+{
+    Close();
+    const bool current = CacheFile::Open(file, path, vertexStride, header, MeshCacheTableEnd)
+                         && header.sourceHash == sourceHash
+                         && header.optimizeFlags == optimizeFlags
+                         && header.lodLevelCount == lodSettings.levelCount
+                         && header.lodReduction == lodSettings.reduction
+                         && header.lodMaxError == lodSettings.maxError
+                         && header.lodCount <= header.lodLevelCount
+                         && header.attributeCount == attributes.size();
+    if (!current)
+    {
+        Close();
+        return false;
+    }
+
+    const auto* packed = reinterpret_cast<const MeshCacheAttribute*>(file.Data() + sizeof(MeshCacheHeader));
+    for (size_t i = 0; i < attributes.size(); ++i)
+    {
+        if (packed[i].format != (uint32_t) attributes[i].format || packed[i].offset != attributes[i].offset)
+        {
+            Close();
+            return false;
+        }
+    }
+
+    for (const LodRange& lod : GetLods())
+    {
+        if ((uint64_t) lod.firstIndex + lod.indexCount > header.indexCount)
+        {
+            Close();
+            return false;
+        }
+    }
+    return true;
+}
+
+void MeshCache::Close()
+{
+    file.Close();
+    header = {};
+}
+
+primitives::Box MeshCache::GetBounds() const
+{
+    const glm::vec3 boundsMin(header.boundsMin[0], header.boundsMin[1], header.boundsMin[2]);
+    const glm::vec3 boundsMax(header.boundsMax[0], header.boundsMax[1], header.boundsMax[2]);
+    return { (boundsMin + boundsMax) * 0.5f, (boundsMax - boundsMin) * 0.5f };
+}
+
+std::vector<LodRange> MeshCache::GetLods() const
+{
+    std::vector<LodRange> lods(header.lodCount);
+    if (header.lodCount > 0)
+        std::memcpy(lods.data(), file.Data() + MeshCacheLodOffset(header.attributeCount), sizeof(LodRange) * header.lodCount);
+    return lods;
+}
+
+}
@@ -0,0 +1,311 @@
+//------------------------------------------------------------------------------
+//
+// File Name:	MeshCache.h
+// Author(s):	Jonathan Bourim (j.bourim)
+// Date:        10/19/2026
+//
+//------------------------------------------------------------------------------
+#pragma once
+
+namespace dm
+{
+
+/**
+ * Read only memory mapping of a whole file.
+ */
+class MappedFile
+{
+public:
+    MappedFile() = default;
+    MappedFile(const MappedFile& other) = delete;
+    MappedFile& operator=(const MappedFile& other) = delete;
+    ~MappedFile();
+
+    /// \return False if the file can't be opened or is empty
+    bool Open(const std::string& path);
+    void Close();
+
+    [[nodiscard]] const uint8_t* Data() const { return data; }
+    [[nodiscard]] size_t Size() const { return size; }
+    [[nodiscard]] bool IsOpen() const { return data != nullptr; }
+
+private:
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+#if defined(_WIN32)
+    void* file = nullptr;
+    void* mapping = nullptr;
+#else
+    int file = -1;
+#endif
+};
+
+/**
+ * Binary cache files laid out as a header and its tables, then a vertex and an index blob,
+ * each blob aligned to blobAlignment. Shared by MeshCache and StaticBatchCache, whose headers
+ * start with magic and version and hold vertexStride, vertexCount, indexCount, vertexOffset and indexOffset.
+ */
+class CacheFile
+{
+public:
+    static constexpr uint64_t blobAlignment = 16;
+
+    struct Layout
+    {
+        uint64_t vertexOffset = 0;
+        uint64_t indexOffset = 0;
+    };
+
+    struct Section
+    {
+        const void* data = nullptr;
+        size_t size = 0;
+    };
+
+    /// \brief Blob offsets of a file whose header and tables take tableEnd bytes
+    static Layout GetLayout(uint64_t tableEnd, uint32_t vertexStride, uint32_t vertexCount);
+
+    /// \brief Multiply-rotate hash over 8 byte words of data, chained onto hash so calls may be combined
+    static uint64_t HashBytes(uint64_t hash, const void* data, size_t size);
+
+    /// \brief Write a cache file, padding up to each blob's offset in layout.
+    ///        Written to a file of its own beside path and renamed over it, so readers never map a partial file
+    ///        and concurrent writers never share one.
+    /// \param sections Header followed by its tables, written back to back
+    /// \return False if the file couldn't be written, which only costs the next load a rebuild
+    static bool Write(const std::string& path, std::initializer_list<Section> sections, const Layout& layout,
+                      const void* vertices, uint64_t vertexBytes, const uint32_t* indices, uint32_t indexCount);
+
+    /// \brief Map path and read its header, failing if it's of another format, version or vertex stride,
+    ///        or its blobs don't sit where GetLayout places them within the file
+    /// \param tableEnd Size of the header and its tables, given the header read
+    template<class Header, class TableEndFunc>
+    static bool Open(MappedFile& file, const std::string& path, uint32_t vertexStride, Header& header,
+                     const TableEndFunc& tableEnd)
+    {
+        if (!file.Open(path) || file.Size() < sizeof(Header))
+            return false;
+
+        std::memcpy(&header, file.Data(), sizeof(Header));
+        if (header.magic != Header::magicValue || header.version != Header::currentVersion
+            || header.vertexStride != vertexStride)
+            return false;
+
+        const Layout layout = GetLayout(tableEnd(header), vertexStride, header.vertexCount);
+        return header.vertexOffset == layout.vertexOffset && header.indexOffset == layout.indexOffset
+               && header.indexOffset + sizeof(uint32_t) * (uint64_t) header.indexCount <= file.Size();
+    }
+};
+
+/// \brief Header of a mesh cache file, followed by its vertex attributes and LOD ranges, then the vertex and index blobs
+struct MeshCacheHeader
+{
+    static constexpr uint32_t magicValue = 0x48534D44;      //< "DMSH"
+    static constexpr uint32_t currentVersion = 4;
+
+    uint32_t magic = magicValue;
+    uint32_t version = currentVersion;
+    uint64_t sourceHash = 0;
+    uint32_t optimizeFlags = 0;                             //< MeshOptimizeFlags applied on import
+    uint32_t lodLevelCount = 0;                             //< MeshLodSettings the LOD chain was generated with
+    float lodReduction = 0.0f;
+    float lodMaxError = 0.0f;
+    uint32_t lodCount = 0;                                  //< LOD ranges generated, 0 without a chain
+    uint32_t vertexStride = 0;
+    uint32_t attributeCount = 0;
+    uint32_t vertexCount = 0;
+    uint32_t indexCount = 0;
+    uint32_t reserved = 0;                                  //< Written as zero, keeps vertexOffset aligned without implicit padding
+    uint64_t vertexOffset = 0;                              //< Byte offset of the vertex blob from the start of the file
+    uint64_t indexOffset = 0;
+    float boundsMin[3] = {};
+    float boundsMax[3] = {};
+};
+
+static_assert(sizeof(MeshCacheHeader) == 96 && offsetof(MeshCacheHeader, vertexOffset) == 56,
+              "MeshCacheHeader's layout is part of the file format, bump currentVersion when changing it");
+
+/**
+ * Binary mesh files written next to the model they were imported from, so later loads skip parsing.
+ * Files are keyed by a hash of the source file's bytes, their vertex layout, the optimizations
+ * and LOD settings applied on import, and are rebuilt when any of them, or the format version, no longer matches.
+ *
+ * Opened files are memory mapped, and meshes are created straight from the mapping,
+ * copying the blobs into staging memory without an intermediate copy.
+ */
+class MeshCache
+{
+public:
+    static constexpr const char* extension = ".dmesh";
+
+    /// \brief Hash of a file's bytes
+    /// \return 0 if the file can't be read
+    static uint64_t HashFile(const std::string& path);
+
+    [[nodiscard]] static std::string CachePath(const std::string& sourcePath) { return sourcePath + extension; }
+
+    /// \brief Create mesh from the model at sourcePath, through its cache file.
+    ///        Models without an up to date cache file are imported with Mesh::LoadModel, optimized,
+    ///        given a LOD chain and written to one.
+    /// \param pool Optional thread pool the import deduplicates vertices with
+    /// \param optimize MeshOptimizeFlags applied on import
+    /// \param lodSettings LOD chain generated on import, see GenerateLods
+    /// \param stats Optional output of the vertex cache efficiency, only written when the model is imported and optimized
+    template<class VertexType>
+    static void LoadModel(Mesh<VertexType>& mesh, const std::string& sourcePath, Device* owner,
+                          bool dynamic = false, ThreadPool* pool = nullptr, uint32_t optimize = MeshOptimizeAll,
+                          const MeshLodSettings& lodSettings = {}, MeshOptimizeStats* stats = nullptr)
+    {
+        const bool loaded = Load<VertexType>(sourcePath, pool, optimize, lodSettings, stats,
+                                             [&](const typename Mesh<VertexType>::View& view, std::vector<LodRange> lods)
+        {
+            mesh.Create(view, owner, dynamic);
+            mesh.SetLods(std::move(lods));
+        });
+        DM_ASSERT_MSG(loaded, std::string("Failed to read model ") + sourcePath);
+    }
+
+    /// \brief Create mesh in geometryPool from the model at sourcePath, through its cache file
+    template<class VertexType>
+    static void LoadModel(Mesh<VertexType>& mesh, const std::string& sourcePath, GeometryPool& geometryPool,
+                          ThreadPool* pool = nullptr, uint32_t optimize = MeshOptimizeAll,
+                          const MeshLodSettings& lodSettings = {}, MeshOptimizeStats* stats = nullptr)
+    {
+        const bool loaded = Load<VertexType>(sourcePath, pool, optimize, lodSettings, stats,
+                                             [&](const typename Mesh<VertexType>::View& view, std::vector<LodRange> lods)
+        {
+            mesh.Create(view, geometryPool);
+            mesh.SetLods(std::move(lods));
+        });
+        DM_ASSERT_MSG(loaded, std::string("Failed to read model ") + sourcePath);
+    }
+
+    /// \brief Read the model at sourcePath through its cache file into data, without creating a mesh.
+    ///        Touches no device, so it may run on worker threads.
+    /// \return False if the model couldn't be read, leaving data and lods untouched
+    template<class VertexType>
+    static bool Import(const std::string& sourcePath, typename Mesh<VertexType>::Data& data, std::vector<LodRange>& lods,
+                       ThreadPool* pool = nullptr, uint32_t optimize = MeshOptimizeAll,
+                       const MeshLodSettings& lodSettings = {}, MeshOptimizeStats* stats = nullptr)
+    {
+        return Load<VertexType>(sourcePath, pool, optimize, lodSettings, stats,
+                                [&](const typename Mesh<VertexType>::View& view, std::vector<LodRange> inLods)
+        {
+            data.vertices.assign(view.vertices, view.vertices + view.vertexCount);
+            data.indices.assign(view.indices, view.indices + view.indexCount);
+            lods = std::move(inLods);
+        });
+    }
+
+    /// \brief Write mesh data to a cache file
+    /// \param optimizeFlags MeshOptimizeFlags the data was optimized with
+    /// \param lodSettings Settings lods were generated with
+    /// \return False if the file couldn't be written
+    template<class VertexType>
+    static bool Write(const std::string& path, uint64_t sourceHash, uint32_t optimizeFlags,
+                      const MeshLodSettings& lodSettings, const typename Mesh<VertexType>::View& view,
+                      const std::vector<LodRange>& lods)
+    {
+        static_assert(std::is_trivially_copyable<VertexType>::value, "Cached vertices are written by their bytes");
+
+        MeshCacheHeader header;
+        header.sourceHash = sourceHash;
+        header.optimizeFlags = optimizeFlags;
+        header.lodLevelCount = lodSettings.levelCount;
+        header.lodReduction = lodSettings.reduction;
+        header.lodMaxError = lodSettings.maxError;
+        header.vertexStride = sizeof(VertexType);
+        header.vertexCount = view.vertexCount;
+        header.indexCount = view.indexCount;
+
+        glm::vec3 boundsMin(std::numeric_limits<float>::max());
+        glm::vec3 boundsMax(std::numeric_limits<float>::lowest());
+        for (uint32_t i = 0; i < view.vertexCount; ++i)
+        {
+            boundsMin = glm::min(boundsMin, view.vertices[i].pos);
+            boundsMax = glm::max(boundsMax, view.vertices[i].pos);
+        }
+        std::memcpy(header.boundsMin, &boundsMin, sizeof(header.boundsMin));
+        std::memcpy(header.boundsMax, &boundsMax, sizeof(header.boundsMax));
+
+        return WriteFile(path, header, VertexType::Attributes(), lods, view.vertices, view.indices);
+    }
+
+    /// \brief Map a cache file, failing if it's missing, out of date, of another vertex layout,
+    ///        optimized differently or with other LOD settings
+    template<class VertexType>
+    bool Open(const std::string& path, uint64_t sourceHash, uint32_t optimizeFlags, const MeshLodSettings& lodSettings)
+    {
+        return OpenFile(path, sourceHash, optimizeFlags, lodSettings, sizeof(VertexType), VertexType::Attributes());
+    }
+
+    void Close();
+
+    /// \brief Geometry of the open file, pointing into the mapping
+    template<class VertexType>
+    [[nodiscard]] typename Mesh<VertexType>::View GetView() const
+    {
+        DM_ASSERT_MSG(file.IsOpen() && header.vertexStride == sizeof(VertexType), "Mesh cache view of another vertex type");
+        return {
+            reinterpret_cast<const VertexType*>(file.Data() + header.vertexOffset), header.vertexCount,
+            reinterpret_cast<const uint32_t*>(file.Data() + header.indexOffset), header.indexCount
+        };
+    }
+
+    /// \brief Local bounds of the open file's vertices
+    [[nodiscard]] primitives::Box GetBounds() const;
+
+    /// \brief LOD ranges of the open file, empty without a chain
+    [[nodiscard]] std::vector<LodRange> GetLods() const;
+
+private:
+    // False without calling create if the source can't be read, before the importer asserts on it
+    template<class VertexType, class CreateFunc>
+    static bool Load(const std::string& sourcePath, ThreadPool* pool, uint32_t optimize,
+                     const MeshLodSettings& lodSettings, MeshOptimizeStats* stats, const CreateFunc& create)
+    {
+        const uint64_t sourceHash = HashFile(sourcePath);
+        if (sourceHash == 0)
+            return false;
+
+        const std::string cachePath = CachePath(sourcePath);
+        MeshCache cache;
+        if (cache.Open<VertexType>(cachePath, sourceHash, optimize, lodSettings))
+        {
+            create(cache.GetView<VertexType>(), cache.GetLods());
+            return true;
+        }
+
+        typename Mesh<VertexType>::Data data = Mesh<VertexType>::LoadModel(sourcePath, pool);
+        if (optimize != MeshOptimizeNone)
+        {
+            const MeshOptimizeStats optimizeStats = OptimizeMesh<VertexType>(data, optimize);
+            if (stats != nullptr)
+                *stats = optimizeStats;
+        }
+
+        // Generated after optimizing, which would reorder the chain's indices
+        std::vector<LodRange> lods;
+        if (lodSettings.levelCount > 1)
+            lods = GenerateLods<VertexType>(data, lodSettings);
+
+        const typename Mesh<VertexType>::View view = {
+            data.vertices.data(), (uint32_t) data.vertices.size(),
+            data.indices.data(), (uint32_t) data.indices.size()
+        };
+
+        Write<VertexType>(cachePath, sourceHash, optimize, lodSettings, view, lods);
+        create(view, std::move(lods));
+        return true;
+    }
+
+    static bool WriteFile(const std::string& path, MeshCacheHeader header, const VertexAttributes& attributes,
+                          const std::vector<LodRange>& lods, const void* vertices, const uint32_t* indices);
+    bool OpenFile(const std::string& path, uint64_t sourceHash, uint32_t optimizeFlags,
+                  const MeshLodSettings& lodSettings, uint32_t vertexStride, const VertexAttributes& attributes);
+
+    MappedFile file;
+    MeshCacheHeader header;
+};
+
+}
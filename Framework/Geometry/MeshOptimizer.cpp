@@ -0,0 +1,314 @@
+//------------------------------------------------------------------------------
+//
+// File Name:	MeshOptimizer.cpp
+// Author(s):	Jonathan Bourim (j.bourim)
+// Date:        10/19/2026
+//
+//------------------------------------------------------------------------------
+
+#include "MeshOptimizer.h"
+
+namespace dm
+{
+
+namespace
+{
+
+/**
+ * FIFO post-transform cache emulated with per vertex timestamps,
+ * a vertex is cached while fewer than cacheSize misses happened since it was loaded.
+ */
+struct VertexCacheSimulator
+{
+    VertexCacheSimulator(uint32_t vertexCount, uint32_t inCacheSize)
+        : timestamps(vertexCount, 0), cacheSize(inCacheSize), timestamp(inCacheSize + 1)
+    {
+    }
+
+    /// \return Whether vertex missed the cache
+    bool Access(uint32_t vertex)
+    {
+        if (timestamp - timestamps[vertex] > cacheSize)
+        {
+            timestamps[vertex] = timestamp++;
+            return true;
+        }
+        return false;
+    }
+
+    void Flush()
+    {
+        timestamp += cacheSize + 1;
+    }
+
+    std::vector<uint32_t> timestamps;
+    uint32_t cacheSize;
+    uint32_t timestamp;
+};
+
+// Triangles using each vertex, as offsets into a flat list
+struct TriangleAdjacency
+{
+    TriangleAdjacency(const uint32_t* indices, size_t indexCount, uint32_t vertexCount)
+        : offsets(vertexCount + 1, 0), triangles(indexCount)
+    {
+        for (size_t i = 0; i < indexCount; ++i)
+            ++offsets[indices[i] + 1];
+        for (uint32_t v = 0; v < vertexCount; ++v)
+            offsets[v + 1] += offsets[v];
+
+        std::vector<uint32_t> cursor(offsets.begin(), offsets.end() - 1);
+        for (size_t i = 0; i < indexCount; ++i)
+            triangles[cursor[indices[i]]++] = (uint32_t) (i / 3);
+    }
+
+    std::vector<uint32_t> offsets;
+    std::vector<uint32_t> triangles;
+};
+
+glm::vec3 OptimizerPosition(const float* positions, size_t positionStride, uint32_t vertex)
+{
+    const float* position = reinterpret_cast<const float*>(reinterpret_cast<const uint8_t*>(positions) + positionStride * vertex);
+    return { position[0], position[1], position[2] };
+}
+
+}
+
+VertexCacheStats AnalyzeVertexCache(const uint32_t* indices, size_t indexCount, uint32_t vertexCount, uint32_t cacheSize)
+{
+    VertexCacheStats stats;
+    if (indexCount == 0)
+        return stats;
+
+    VertexCacheSimulator cache(vertexCount, cacheSize);
+    std::vector<bool> referenced(vertexCount, false);
+    uint32_t referencedCount = 0;
+    for (size_t i = 0; i < indexCount; ++i)
+    {
+        stats.transformed += cache.Access(indices[i]);
+        if (!referenced[indices[i]])
+        {
+            referenced[indices[i]] = true;
+            ++referencedCount;
+        }
+    }
+
+    stats.acmr = (float) stats.transformed / (float) (indexCount / 3);
+    stats.atvr = (float) stats.transformed / (float) referencedCount;
+    return stats;
+}
+
+void OptimizeVertexCache(uint32_t* destination, const uint32_t* indices, size_t indexCount, uint32_t vertexCount,
+                         uint32_t cacheSize, std::vector<uint32_t>* clusters)
+{
+    DM_ASSERT_MSG(indexCount % 3 == 0, "Vertex cache optimization expects a triangle list");
+    DM_ASSERT_MSG(destination != indices, "Vertex cache optimization can't run in place");
+
+    if (clusters)
+        clusters->clear();
+    if (indexCount == 0)
+        return;
+
+    const TriangleAdjacency adjacency(indices, indexCount, vertexCount);
+    std::vector<uint32_t> live(vertexCount);
+    for (uint32_t v = 0; v < vertexCount; ++v)
+        live[v] = adjacency.offsets[v + 1] - adjacency.offsets[v];
+
+    const size_t triangleCount = indexCount / 3;
+    std::vector<bool> emitted(triangleCount, false);
+    std::vector<uint32_t> deadEnds;
+    std::vector<uint32_t> candidates;
+    std::vector<uint32_t> cacheTimes(vertexCount, 0);
+    uint32_t timestamp = cacheSize + 1;
+    uint32_t cursor = 0;
+    size_t written = 0;
+
+    auto nextLiveVertex = [&]()
+    {
+        while (!deadEnds.empty())
+        {
+            const uint32_t vertex = deadEnds.back();
+            deadEnds.pop_back();
+            if (live[vertex] > 0)
+                return vertex;
+        }
+        while (cursor < vertexCount)
+        {
+            if (live[cursor] > 0)
+                return cursor;
+            ++cursor;
+        }
+        return ~0u;
+    };
+
+    uint32_t fanning = nextLiveVertex();
+    if (clusters)
+        clusters->push_back(0);
+
+    while (fanning != ~0u)
+    {
+        // Emit every remaining triangle around the fanning vertex
+        candidates.clear();
+        for (uint32_t a = adjacency.offsets[fanning]; a < adjacency.offsets[fanning + 1]; ++a)
+        {
+            const uint32_t triangle = adjacency.triangles[a];
+            if (emitted[triangle])
+                continue;
+
+            for (uint32_t corner = 0; corner < 3; ++corner)
+            {
+                const uint32_t vertex = indices[triangle * 3 + corner];
+                destination[written++] = vertex;
+                deadEnds.push_back(vertex);
+                candidates.push_back(vertex);
+                --live[vertex];
+                if (timestamp - cacheTimes[vertex] > cacheSize)
+                    cacheTimes[vertex] = timestamp++;
+            }
+            emitted[triangle] = true;
+        }
+
+        // Fan next around the oldest candidate still in the cache once its triangles are emitted
+        uint32_t next = ~0u;
+        int64_t bestPriority = -1;
+        for (uint32_t vertex : candidates)
+        {
+            if (live[vertex] == 0)
+                continue;
+
+            int64_t priority = 0;
+            if (timestamp - cacheTimes[vertex] + 2 * live[vertex] <= cacheSize)
+                priority = timestamp - cacheTimes[vertex];
+            if (priority > bestPriority)
+            {
+                bestPriority = priority;
+                next = vertex;
+            }
+        }
+
+        if (next == ~0u)
+        {
+            next = nextLiveVertex();
+            if (clusters && next != ~0u)
+                clusters->push_back((uint32_t) written);
+        }
+        fanning = next;
+    }
+
+    DM_ASSERT_MSG(written == indexCount, "Vertex cache optimization lost triangles");
+}
+
+void OptimizeOverdraw(uint32_t* destination, const uint32_t* indices, size_t indexCount,
+                      const float* positions, size_t positionStride, uint32_t vertexCount,
+                      const std::vector<uint32_t>& clusters, float threshold, uint32_t cacheSize)
+{
+    DM_ASSERT_MSG(indexCount % 3 == 0, "Overdraw optimization expects a triangle list");
+    DM_ASSERT_MSG(destination != indices, "Overdraw optimization can't run in place");
+    if (indexCount == 0)
+        return;
+
+    // Split clusters once drawing them from a cold cache keeps their ACMR within threshold
+    std::vector<uint32_t> starts;
+    VertexCacheSimulator cache(vertexCount, cacheSize);
+    for (size_t c = 0; c < std::max<size_t>(clusters.size(), 1); ++c)
+    {
+        const uint32_t begin = clusters.empty() ? 0 : clusters[c];
+        const auto end = (uint32_t) (c + 1 < clusters.size() ? clusters[c + 1] : indexCount);
+
+        cache.Flush();
+        uint32_t clusterMisses = 0;
+        for (uint32_t i = begin; i < end; ++i)
+            clusterMisses += cache.Access(indices[i]);
+        const float targetAcmr = threshold * (float) clusterMisses / (float) ((end - begin) / 3);
+
+        cache.Flush();
+        starts.push_back(begin);
+        uint32_t misses = 0;
+        uint32_t subclusterBegin = begin;
+        for (uint32_t i = begin; i < end; i += 3)
+        {
+            misses += cache.Access(indices[i]) + cache.Access(indices[i + 1]) + cache.Access(indices[i + 2]);
+            const uint32_t triangles = (i + 3 - subclusterBegin) / 3;
+            if (i + 3 < end && (float) misses <= targetAcmr * (float) triangles)
+            {
+                subclusterBegin = i + 3;
+                starts.push_back(subclusterBegin);
+                misses = 0;
+                cache.Flush();
+            }
+        }
+    }
+
+    // Area weighted centroids and normals
+    struct Cluster
+    {
+        uint32_t begin;
+        uint32_t end;
+        glm::vec3 centroid;
+        glm::vec3 normal;
+        float sortKey;
+    };
+
+    std::vector<Cluster> sorted(starts.size());
+    glm::vec3 meshCentroid(0.0f);
+    float meshArea = 0.0f;
+    for (size_t c = 0; c < starts.size(); ++c)
+    {
+        Cluster& cluster = sorted[c];
+        cluster.begin = starts[c];
+        cluster.end = (uint32_t) (c + 1 < starts.size() ? starts[c + 1] : indexCount);
+        cluster.centroid = glm::vec3(0.0f);
+        cluster.normal = glm::vec3(0.0f);
+
+        float area = 0.0f;
+        for (uint32_t i = cluster.begin; i < cluster.end; i += 3)
+        {
+            const glm::vec3 a = OptimizerPosition(positions, positionStride, indices[i]);
+            const glm::vec3 b = OptimizerPosition(positions, positionStride, indices[i + 1]);
+            const glm::vec3 c2 = OptimizerPosition(positions, positionStride, indices[i + 2]);
+            const glm::vec3 normal = glm::cross(b - a, c2 - a);
+            const float triangleArea = glm::length(normal);
+
+            cluster.centroid += (a + b + c2) * (triangleArea / 3.0f);
+            cluster.normal += normal;
+            area += triangleArea;
+        }
+
+        meshCentroid += cluster.centroid;
+        meshArea += area;
+        cluster.centroid = area > 0.0f ? cluster.centroid / area : cluster.centroid;
+        const float normalLength = glm::length(cluster.normal);
+        cluster.normal = normalLength > 0.0f ? cluster.normal / normalLength : cluster.normal;
+    }
+    meshCentroid = meshArea > 0.0f ? meshCentroid / meshArea : meshCentroid;
+
+    // Clusters facing away from the mesh center are likely to occlude others, so draw first
+    for (Cluster& cluster : sorted)
+        cluster.sortKey = glm::dot(cluster.centroid - meshCentroid, cluster.normal);
+    std::stable_sort(sorted.begin(), sorted.end(), [](const Cluster& a, const Cluster& b)
+    {
+        return a.sortKey > b.sortKey;
+    });
+
+    size_t written = 0;
+    for (const Cluster& cluster : sorted)
+    {
+        std::copy(indices + cluster.begin, indices + cluster.end, destination + written);
+        written += cluster.end - cluster.begin;
+    }
+}
+
+uint32_t OptimizeVertexFetchRemap(uint32_t* remap, const uint32_t* indices, size_t indexCount, uint32_t vertexCount)
+{
+    std::fill(remap, remap + vertexCount, ~0u);
+
+    uint32_t next = 0;
+    for (size_t i = 0; i < indexCount; ++i)
+    {
+        if (remap[indices[i]] == ~0u)
+            remap[indices[i]] = next++;
+    }
+    return next;
+}
+
+}
@@ -0,0 +1,111 @@
+//------------------------------------------------------------------------------
+//
+// File Name:	MeshOptimizer.h
+// Author(s):	Jonathan Bourim (j.bourim)
+// Date:        10/19/2026
+//
+//------------------------------------------------------------------------------
+#pragma once
+
+namespace dm
+{
+
+/// \brief Optimizations applied to imported triangle lists, in the order listed
+enum MeshOptimizeFlags : uint32_t
+{
+    MeshOptimizeNone        = 0,
+    MeshOptimizeVertexCache = 1 << 0,   //< Reorder triangles for post-transform vertex cache reuse
+    MeshOptimizeOverdraw    = 1 << 1,   //< Reorder cache friendly clusters of triangles front to back from most views
+    MeshOptimizeVertexFetch = 1 << 2,   //< Reorder vertices by first use, dropping unreferenced ones
+    MeshOptimizeAll         = MeshOptimizeVertexCache | MeshOptimizeOverdraw | MeshOptimizeVertexFetch
+};
+
+struct VertexCacheStats
+{
+    float acmr = 0.0f;                  //< Vertices transformed per triangle, 0.5 to 3
+    float atvr = 0.0f;                  //< Vertices transformed per referenced vertex, 1 is optimal
+    uint32_t transformed = 0;
+};
+
+struct MeshOptimizeStats
+{
+    VertexCacheStats before;
+    VertexCacheStats after;
+};
+
+/// \brief Vertex cache size optimized for and simulated, typical of post-transform caches
+constexpr uint32_t defaultVertexCacheSize = 16;
+
+/// \brief Simulate a FIFO post-transform vertex cache over a triangle list
+VertexCacheStats AnalyzeVertexCache(const uint32_t* indices, size_t indexCount, uint32_t vertexCount,
+                                    uint32_t cacheSize = defaultVertexCacheSize);
+
+/// \brief Reorder triangles for vertex cache reuse with Tipsify (Sander et al. 2007)
+/// \param clusters Optional output of the first index of each cluster, split where the order jumps across the mesh
+void OptimizeVertexCache(uint32_t* destination, const uint32_t* indices, size_t indexCount, uint32_t vertexCount,
+                         uint32_t cacheSize = defaultVertexCacheSize, std::vector<uint32_t>* clusters = nullptr);
+
+/// \brief Reorder clusters of a vertex cache optimized triangle list so outward facing ones draw first.
+///        Clusters are further split where that keeps their ACMR within threshold of the input's.
+/// \param positions First vertex's position, three floats every positionStride bytes
+void OptimizeOverdraw(uint32_t* destination, const uint32_t* indices, size_t indexCount,
+                      const float* positions, size_t positionStride, uint32_t vertexCount,
+                      const std::vector<uint32_t>& clusters, float threshold = 1.05f,
+                      uint32_t cacheSize = defaultVertexCacheSize);
+
+/// \brief Build a remap of vertices in order of first use
+/// \return Number of referenced vertices, unreferenced ones are remapped to ~0u
+uint32_t OptimizeVertexFetchRemap(uint32_t* remap, const uint32_t* indices, size_t indexCount, uint32_t vertexCount);
+
+/// \brief Optimize mesh data before Mesh::Create
+/// \return Vertex cache efficiency before and after
+template<class VertexType>
+MeshOptimizeStats OptimizeMesh(typename Mesh<VertexType>::Data& data, uint32_t flags = MeshOptimizeAll,
+                               uint32_t cacheSize = defaultVertexCacheSize)
+{
+    std::vector<uint32_t>& indices = data.indices;
+    std::vector<VertexType>& vertices = data.vertices;
+    const auto vertexCount = (uint32_t) vertices.size();
+
+    MeshOptimizeStats stats;
+    stats.before = AnalyzeVertexCache(indices.data(), indices.size(), vertexCount, cacheSize);
+    stats.after = stats.before;
+    if (indices.empty())
+        return stats;
+
+    std::vector<uint32_t> scratch(indices.size());
+    std::vector<uint32_t> clusters;
+    if (flags & (MeshOptimizeVertexCache | MeshOptimizeOverdraw))
+    {
+        OptimizeVertexCache(scratch.data(), indices.data(), indices.size(), vertexCount, cacheSize, &clusters);
+        indices.swap(scratch);
+    }
+
+    if (flags & MeshOptimizeOverdraw)
+    {
+        OptimizeOverdraw(scratch.data(), indices.data(), indices.size(), &vertices[0].pos.x, sizeof(VertexType),
+                         vertexCount, clusters, 1.05f, cacheSize);
+        indices.swap(scratch);
+    }
+
+    if (flags & MeshOptimizeVertexFetch)
+    {
+        std::vector<uint32_t> remap(vertexCount);
+        const uint32_t referenced = OptimizeVertexFetchRemap(remap.data(), indices.data(), indices.size(), vertexCount);
+
+        std::vector<VertexType> reordered(referenced);
+        for (uint32_t i = 0; i < vertexCount; ++i)
+        {
+            if (remap[i] != ~0u)
+                reordered[remap[i]] = vertices[i];
+        }
+        for (uint32_t& index : indices)
+            index = remap[index];
+        vertices.swap(reordered);
+    }
+
+    stats.after = AnalyzeVertexCache(indices.data(), indices.size(), (uint32_t) vertices.size(), cacheSize);
+    return stats;
+}
+
+}
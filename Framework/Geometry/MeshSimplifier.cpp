@@ -0,0 +1,341 @@
+//------------------------------------------------------------------------------
+//
+// File Name:	MeshSimplifier.cpp
+// Author(s):	Jonathan Bourim (j.bourim)
+// Date:        10/19/2026
+//
+//------------------------------------------------------------------------------
+
+#include "MeshSimplifier.h"
+#include "Camera/Camera.h"
+
+namespace dm
+{
+
+namespace
+{
+
+// Sum of squared distances to weighted planes, as the symmetric matrix A, vector b and constant c
+struct Quadric
+{
+    double a00 = 0.0, a11 = 0.0, a22 = 0.0, a01 = 0.0, a02 = 0.0, a12 = 0.0;
+    double b0 = 0.0, b1 = 0.0, b2 = 0.0;
+    double c = 0.0;
+    double weight = 0.0;
+
+    void AddPlane(const glm::dvec3& normal, double distance, double planeWeight)
+    {
+        a00 += planeWeight * normal.x * normal.x;
+        a11 += planeWeight * normal.y * normal.y;
+        a22 += planeWeight * normal.z * normal.z;
+        a01 += planeWeight * normal.x * normal.y;
+        a02 += planeWeight * normal.x * normal.z;
+        a12 += planeWeight * normal.y * normal.z;
+        b0 += planeWeight * normal.x * distance;
+        b1 += planeWeight * normal.y * distance;
+        b2 += planeWeight * normal.z * distance;
+        c += planeWeight * distance * distance;
+        weight += planeWeight;
+    }
+
+    void Add(const Quadric& other)
+    {
+        a00 += other.a00; a11 += other.a11; a22 += other.a22;
+        a01 += other.a01; a02 += other.a02; a12 += other.a12;
+        b0 += other.b0; b1 += other.b1; b2 += other.b2;
+        c += other.c;
+        weight += other.weight;
+    }
+
+    // Mean squared distance of p to the planes
+    [[nodiscard]] double Error(const glm::dvec3& p) const
+    {
+        const double rx = a00 * p.x + a01 * p.y + a02 * p.z;
+        const double ry = a01 * p.x + a11 * p.y + a12 * p.z;
+        const double rz = a02 * p.x + a12 * p.y + a22 * p.z;
+        const double error = p.x * rx + p.y * ry + p.z * rz + 2.0 * (b0 * p.x + b1 * p.y + b2 * p.z) + c;
+        return weight > 0.0 ? std::max(error, 0.0) / weight : 0.0;
+    }
+};
+
+struct SimplifierCollapse
+{
+    uint32_t from;                  //< Position moved onto to
+    uint32_t to;
+    float cost;
+};
+
+// Triangles touching each position, as offsets into a flat list
+struct SimplifierAdjacency
+{
+    SimplifierAdjacency(const std::vector<uint32_t>& corners, uint32_t positionCount)
+        : offsets(positionCount + 1, 0), triangles(corners.size())
+    {
+        for (uint32_t position : corners)
+            ++offsets[position + 1];
+        for (uint32_t p = 0; p < positionCount; ++p)
+            offsets[p + 1] += offsets[p];
+
+        std::vector<uint32_t> cursor(offsets.begin(), offsets.end() - 1);
+        for (size_t i = 0; i < corners.size(); ++i)
+            triangles[cursor[corners[i]]++] = (uint32_t) (i / 3);
+    }
+
+    std::vector<uint32_t> offsets;
+    std::vector<uint32_t> triangles;
+};
+
+}
+
+size_t SimplifyMesh(uint32_t* destination, const uint32_t* indices, size_t indexCount,
+                    const float* positions, size_t positionStride, uint32_t vertexCount,
+                    size_t targetIndexCount, float targetError, float* resultError)
+{
+    DM_ASSERT_MSG(indexCount % 3 == 0, "Simplification expects a triangle list");
+    if (resultError)
+        *resultError = 0.0f;
+
+    std::copy(indices, indices + indexCount, destination);
+    if (indexCount <= targetIndexCount || vertexCount == 0)
+        return indexCount;
+
+    // Normalized to the unit cube, so errors are relative to the extent
+    std::vector<glm::dvec3> points(vertexCount);
+    for (uint32_t v = 0; v < vertexCount; ++v)
+    {
+        const float* p = reinterpret_cast<const float*>(reinterpret_cast<const uint8_t*>(positions) + positionStride * v);
+        points[v] = glm::dvec3(p[0], p[1], p[2]);
+    }
+    glm::dvec3 boundsMin = points[0];
+    glm::dvec3 boundsMax = points[0];
+    for (const glm::dvec3& point : points)
+    {
+        boundsMin = glm::min(boundsMin, point);
+        boundsMax = glm::max(boundsMax, point);
+    }
+    const glm::dvec3 size = boundsMax - boundsMin;
+    const double extent = std::max(size.x, std::max(size.y, size.z));
+    const double inverseExtent = extent > 0.0 ? 1.0 / extent : 0.0;
+    for (glm::dvec3& point : points)
+        point = (point - boundsMin) * inverseExtent;
+
+    // Vertices sharing a position are wedges of it, split by their other attributes
+    std::vector<uint32_t> sortedVertices(vertexCount);
+    std::iota(sortedVertices.begin(), sortedVertices.end(), 0u);
+    std::sort(sortedVertices.begin(), sortedVertices.end(), [&points](uint32_t a, uint32_t b)
+    {
+        return std::tie(points[a].x, points[a].y, points[a].z) < std::tie(points[b].x, points[b].y, points[b].z);
+    });
+    std::vector<uint32_t> vertexPosition(vertexCount);
+    std::vector<uint32_t> positionVertex;
+    for (uint32_t i = 0; i < vertexCount; ++i)
+    {
+        const uint32_t v = sortedVertices[i];
+        if (i == 0 || points[v] != points[sortedVertices[i - 1]])
+            positionVertex.push_back(v);
+        vertexPosition[v] = (uint32_t) positionVertex.size() - 1;
+    }
+    const auto positionCount = (uint32_t) positionVertex.size();
+
+    // Area weighted planes of every triangle, and open borders from edges missing their opposite
+    std::vector<Quadric> quadrics(positionCount);
+    std::unordered_set<uint64_t> directedEdges;
+    directedEdges.reserve(indexCount);
+    for (size_t i = 0; i < indexCount; i += 3)
+    {
+        const uint32_t corner[3] = { vertexPosition[indices[i]], vertexPosition[indices[i + 1]], vertexPosition[indices[i + 2]] };
+        const glm::dvec3& a = points[positionVertex[corner[0]]];
+        const glm::dvec3 normal = glm::cross(points[positionVertex[corner[1]]] - a, points[positionVertex[corner[2]]] - a);
+        const double area = glm::length(normal);
+        if (area > 0.0)
+        {
+            const glm::dvec3 unitNormal = normal / area;
+            for (uint32_t position : corner)
+                quadrics[position].AddPlane(unitNormal, -glm::dot(unitNormal, a), area);
+        }
+
+        for (uint32_t e = 0; e < 3; ++e)
+            directedEdges.insert((uint64_t) corner[e] << 32 | corner[(e + 1) % 3]);
+    }
+
+    std::vector<bool> border(positionCount, false);
+    for (uint64_t edge : directedEdges)
+    {
+        const auto from = (uint32_t) (edge >> 32);
+        const auto to = (uint32_t) edge;
+        if (from != to && directedEdges.count((uint64_t) to << 32 | from) == 0)
+        {
+            border[from] = true;
+            border[to] = true;
+        }
+    }
+
+    const double errorLimit = (double) targetError * (double) targetError;
+    double maxError = 0.0;
+    size_t count = indexCount;
+    std::vector<uint32_t> corners(indexCount);
+    std::vector<uint32_t> wedgeTarget(vertexCount, ~0u);
+    std::vector<uint32_t> collapsed;
+    std::vector<SimplifierCollapse> candidates;
+    std::vector<bool> dirty(positionCount);
+
+    while (count > targetIndexCount)
+    {
+        for (size_t i = 0; i < count; ++i)
+            corners[i] = vertexPosition[destination[i]];
+        corners.resize(count);
+        const SimplifierAdjacency adjacency(corners, positionCount);
+
+        // Both directions of every edge, each triangle's edge is also found from its neighbour across it
+        candidates.clear();
+        for (size_t i = 0; i < count; i += 3)
+        {
+            for (uint32_t e = 0; e < 3; ++e)
+            {
+                const uint32_t a = corners[i + e];
+                const uint32_t b = corners[i + (e + 1) % 3];
+                if (a == b)
+                    continue;
+                if (!border[a])
+                    candidates.push_back({ a, b, (float) quadrics[a].Error(points[positionVertex[b]]) });
+                if (!border[b])
+                    candidates.push_back({ b, a, (float) quadrics[b].Error(points[positionVertex[a]]) });
+            }
+        }
+        std::sort(candidates.begin(), candidates.end(), [](const SimplifierCollapse& a, const SimplifierCollapse& b)
+        {
+            return a.cost < b.cost;
+        });
+
+        // Collapse the cheapest edges whose neighbourhoods are untouched this pass, keeping adjacency valid
+        std::fill(dirty.begin(), dirty.end(), false);
+        collapsed.clear();
+        const size_t trianglesToRemove = (count - targetIndexCount + 2) / 3;
+        size_t removed = 0;
+        for (const SimplifierCollapse& collapse : candidates)
+        {
+            if (collapse.cost > errorLimit || removed >= trianglesToRemove)
+                break;
+            if (dirty[collapse.from] || dirty[collapse.to])
+                continue;
+
+            const glm::dvec3& target = points[positionVertex[collapse.to]];
+            const uint32_t* begin = adjacency.triangles.data() + adjacency.offsets[collapse.from];
+            const uint32_t* end = adjacency.triangles.data() + adjacency.offsets[collapse.from + 1];
+
+            // Each wedge moves onto the wedge it shares a collapsing triangle with, so seams stay seams
+            bool valid = true;
+            size_t collapsing = 0;
+            for (const uint32_t* t = begin; t != end; ++t)
+            {
+                const uint32_t* triangle = destination + *t * 3;
+                const uint32_t* triangleCorners = corners.data() + *t * 3;
+                int fromCorner = -1;
+                int toCorner = -1;
+                for (int c = 0; c < 3; ++c)
+                {
+                    fromCorner = triangleCorners[c] == collapse.from ? c : fromCorner;
+                    toCorner = triangleCorners[c] == collapse.to ? c : toCorner;
+                }
+
+                if (toCorner >= 0)
+                {
+                    wedgeTarget[triangle[fromCorner]] = triangle[toCorner];
+                    ++collapsing;
+                    continue;
+                }
+
+                // Remaining triangles mustn't flip or turn sharply
+                glm::dvec3 moved[3];
+                glm::dvec3 original[3];
+                for (int c = 0; c < 3; ++c)
+                {
+                    original[c] = points[positionVertex[triangleCorners[c]]];
+                    moved[c] = c == fromCorner ? target : original[c];
+                }
+                const glm::dvec3 before = glm::cross(original[1] - original[0], original[2] - original[0]);
+                const glm::dvec3 after = glm::cross(moved[1] - moved[0], moved[2] - moved[0]);
+                if (glm::dot(before, after) < 0.25 * glm::length(before) * glm::length(after))
+                    valid = false;
+            }
+
+            for (const uint32_t* t = begin; t != end && valid; ++t)
+            {
+                const uint32_t* triangle = destination + *t * 3;
+                for (int c = 0; c < 3; ++c)
+                {
+                    if (corners[*t * 3 + c] == collapse.from && wedgeTarget[triangle[c]] == ~0u)
+                        valid = false;
+                }
+            }
+
+            if (!valid || collapsing == 0)
+            {
+                for (const uint32_t* t = begin; t != end; ++t)
+                {
+                    for (int c = 0; c < 3; ++c)
+                        wedgeTarget[destination[*t * 3 + c]] = ~0u;
+                }
+                continue;
+            }
+
+            for (const uint32_t* t = begin; t != end; ++t)
+            {
+                for (int c = 0; c < 3; ++c)
+                {
+                    const uint32_t vertex = destination[*t * 3 + c];
+                    dirty[corners[*t * 3 + c]] = true;
+                    if (corners[*t * 3 + c] == collapse.from)
+                        collapsed.push_back(vertex);
+                }
+            }
+            quadrics[collapse.to].Add(quadrics[collapse.from]);
+            maxError = std::max(maxError, (double) collapse.cost);
+            removed += collapsing;
+        }
+
+        if (collapsed.empty())
+            break;
+
+        // Rewrite collapsed wedges, then drop triangles that lost an edge
+        size_t written = 0;
+        for (size_t i = 0; i < count; i += 3)
+        {
+            uint32_t triangle[3];
+            for (int c = 0; c < 3; ++c)
+            {
+                const uint32_t vertex = destination[i + c];
+                triangle[c] = wedgeTarget[vertex] != ~0u ? wedgeTarget[vertex] : vertex;
+            }
+
+            const uint32_t p0 = vertexPosition[triangle[0]];
+            const uint32_t p1 = vertexPosition[triangle[1]];
+            const uint32_t p2 = vertexPosition[triangle[2]];
+            if (p0 == p1 || p1 == p2 || p0 == p2)
+                continue;
+
+            destination[written++] = triangle[0];
+            destination[written++] = triangle[1];
+            destination[written++] = triangle[2];
+        }
+        count = written;
+
+        for (uint32_t vertex : collapsed)
+            wedgeTarget[vertex] = ~0u;
+    }
+
+    if (resultError)
+        *resultError = (float) std::sqrt(maxError);
+    return count;
+}
+
+LodSelector LodSelector::FromCamera(const Camera& camera, float viewportHeight, float maxErrorPixels)
+{
+    LodSelector selector;
+    selector.cameraPosition = glm::vec3(glm::inverse(camera.matrices.view)[3]);
+    selector.pixelsPerUnit = std::abs(camera.matrices.perspective[1][1]) * 0.5f * viewportHeight;
+    selector.maxErrorPixels = maxErrorPixels;
+    return selector;
+}
+
+}
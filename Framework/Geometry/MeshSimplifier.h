@@ -0,0 +1,127 @@
+//------------------------------------------------------------------------------
+//
+// File Name:	MeshSimplifier.h
+// Author(s):	Jonathan Bourim (j.bourim)
+// Date:        10/19/2026
+//
+//------------------------------------------------------------------------------
+#pragma once
+
+class Camera;
+
+namespace dm
+{
+
+struct MeshLodSettings
+{
+    uint32_t levelCount = 1;            //< Including the full detail level, 1 generates no LODs
+    float reduction = 0.5f;             //< Triangles each level keeps of the previous one
+    float maxError = 0.02f;             //< Largest deviation of the coarsest level, relative to the mesh's extent
+};
+
+/// \brief Simplify a triangle list by quadric error edge collapses (Garland and Heckbert 1997).
+///        Collapses move a vertex onto a neighbour, so the result indexes the input's vertices.
+///        Open borders are kept in place, and vertices split along attribute seams only collapse along the seam.
+/// \param positions First vertex's position, three floats every positionStride bytes
+/// \param targetIndexCount Indices to simplify down to, unless that exceeds targetError first
+/// \param targetError Largest deviation allowed, relative to the mesh's extent
+/// \param resultError Optional output of the deviation reached, relative to the mesh's extent
+/// \return Index count written to destination
+size_t SimplifyMesh(uint32_t* destination, const uint32_t* indices, size_t indexCount,
+                    const float* positions, size_t positionStride, uint32_t vertexCount,
+                    size_t targetIndexCount, float targetError, float* resultError = nullptr);
+
+/// \brief Append a LOD chain to the indices of mesh data, each level simplified from the previous one
+///        and optimized for the vertex cache. Stops early once a level can't meet its error budget.
+/// \return Every level's range, the first covering the original indices
+template<class VertexType>
+std::vector<LodRange> GenerateLods(typename Mesh<VertexType>::Data& data, const MeshLodSettings& settings)
+{
+    std::vector<uint32_t>& indices = data.indices;
+    const std::vector<VertexType>& vertices = data.vertices;
+
+    std::vector<LodRange> lods;
+    lods.push_back({ 0, (uint32_t) indices.size(), 0.0f });
+    if (indices.empty() || vertices.empty())
+        return lods;
+
+    glm::vec3 boundsMin = vertices[0].pos;
+    glm::vec3 boundsMax = vertices[0].pos;
+    for (const VertexType& vertex : vertices)
+    {
+        boundsMin = glm::min(boundsMin, vertex.pos);
+        boundsMax = glm::max(boundsMax, vertex.pos);
+    }
+    const glm::vec3 size = boundsMax - boundsMin;
+    const float extent = std::max(size.x, std::max(size.y, size.z));
+
+    std::vector<uint32_t> previous(indices);
+    std::vector<uint32_t> simplified(indices.size());
+    float accumulatedError = 0.0f;
+    for (uint32_t level = 1; level < settings.levelCount; ++level)
+    {
+        const size_t target = (size_t) ((float) (previous.size() / 3) * settings.reduction) * 3;
+        const float budget = settings.maxError - accumulatedError;
+        if (target == 0 || budget <= 0.0f)
+            break;
+
+        float error = 0.0f;
+        const size_t count = SimplifyMesh(simplified.data(), previous.data(), previous.size(), &vertices[0].pos.x,
+                                          sizeof(VertexType), (uint32_t) vertices.size(), target, budget, &error);
+
+        // Levels barely smaller than the previous one cost memory without saving triangles
+        if (count == 0 || count * 20 > previous.size() * 19)
+            break;
+
+        previous.resize(count);
+        OptimizeVertexCache(previous.data(), simplified.data(), count, (uint32_t) vertices.size());
+
+        accumulatedError += error;
+        lods.push_back({ (uint32_t) indices.size(), (uint32_t) count, accumulatedError * extent });
+        indices.insert(indices.end(), previous.begin(), previous.end());
+    }
+    return lods;
+}
+
+/**
+ * Picks mesh LODs from their projected error, the coarsest level whose deviation covers
+ * at most maxErrorPixels on screen at the mesh's distance from the camera.
+ */
+struct LodSelector
+{
+    glm::vec3 cameraPosition = glm::vec3(0.0f);
+    float pixelsPerUnit = 1.0f;         //< Screen height in pixels of one unit at a distance of one
+    float maxErrorPixels = 1.0f;
+
+    /// \param viewportHeight Height in pixels of the viewport the camera renders to
+    static LodSelector FromCamera(const Camera& camera, float viewportHeight, float maxErrorPixels = 1.0f);
+
+    /// \brief Distance from the camera to a bounding sphere's surface past which an error is acceptable
+    /// \param scale World units per mesh unit
+    [[nodiscard]] float LodDistance(float error, float scale = 1.0f) const
+    {
+        return error * scale * pixelsPerUnit / maxErrorPixels;
+    }
+
+    /// \param center World space center of the mesh's bounding sphere
+    /// \param radius World space radius of the mesh's bounding sphere
+    /// \param scale World units per mesh unit
+    [[nodiscard]] uint32_t Select(const std::vector<LodRange>& lods, const glm::vec3& center, float radius,
+                                  float scale = 1.0f) const
+    {
+        const float distance = std::max(glm::length(center - cameraPosition) - radius, 0.0f);
+        uint32_t lod = 0;
+        while (lod + 1 < lods.size() && distance >= LodDistance(lods[lod + 1].error, scale))
+            ++lod;
+        return lod;
+    }
+
+    template<class VertexType>
+    [[nodiscard]] uint32_t Select(const Mesh<VertexType>& mesh, const glm::vec3& center, float radius,
+                                  float scale = 1.0f) const
+    {
+        return Select(mesh.GetLods(), center, radius, scale);
+    }
+};
+
+}
@@ -0,0 +1,243 @@
+//------------------------------------------------------------------------------
+//
+// File Name:	Meshlets.cpp
+// Author(s):	Jonathan Bourim (j.bourim)
+// Date:        10/19/2026
+//
+//------------------------------------------------------------------------------
+
+#include "Meshlets.h"
+
+namespace dm
+{
+
+namespace
+{
+
+constexpr uint8_t meshletUnusedVertex = 0xff;
+constexpr uint32_t meshletNoTriangle = ~0u;
+
+glm::vec3 MeshletPosition(const float* positions, size_t positionStride, uint32_t vertex)
+{
+    const float* position = reinterpret_cast<const float*>(reinterpret_cast<const uint8_t*>(positions) + positionStride * vertex);
+    return { position[0], position[1], position[2] };
+}
+
+MeshletBounds ComputeMeshletBounds(const MeshletData& data, const Meshlet& meshlet,
+                                   const float* positions, size_t positionStride)
+{
+    MeshletBounds bounds = {};
+    bounds.coneCutoff = 1.0f;
+
+    const uint32_t* vertices = data.vertices.data() + meshlet.vertexOffset;
+    glm::vec3 boundsMin = MeshletPosition(positions, positionStride, vertices[0]);
+    glm::vec3 boundsMax = boundsMin;
+    for (uint32_t i = 1; i < meshlet.vertexCount; ++i)
+    {
+        const glm::vec3 position = MeshletPosition(positions, positionStride, vertices[i]);
+        boundsMin = glm::min(boundsMin, position);
+        boundsMax = glm::max(boundsMax, position);
+    }
+
+    bounds.center = (boundsMin + boundsMax) * 0.5f;
+    for (uint32_t i = 0; i < meshlet.vertexCount; ++i)
+        bounds.radius = std::max(bounds.radius, glm::length(MeshletPosition(positions, positionStride, vertices[i]) - bounds.center));
+
+    // Cone around the average triangle normal, wide enough to hold every triangle's normal
+    std::vector<glm::vec3> triangleNormals(meshlet.triangleCount);
+    auto triangleCorner = [&](uint32_t triangle, uint32_t corner) {
+        const uint8_t local = data.triangles[meshlet.triangleOffset + triangle * 3 + corner];
+        return MeshletPosition(positions, positionStride, vertices[local]);
+    };
+
+    glm::vec3 axis = glm::vec3(0.0f);
+    for (uint32_t t = 0; t < meshlet.triangleCount; ++t)
+    {
+        const glm::vec3 p0 = triangleCorner(t, 0);
+        const glm::vec3 normal = glm::cross(triangleCorner(t, 1) - p0, triangleCorner(t, 2) - p0);
+        const float length = glm::length(normal);
+        triangleNormals[t] = length > 0.0f ? normal / length : glm::vec3(0.0f);
+        axis += triangleNormals[t];
+    }
+
+    const float axisLength = glm::length(axis);
+    if (axisLength == 0.0f)
+        return bounds;
+    axis /= axisLength;
+
+    float minDot = 1.0f;
+    for (uint32_t t = 0; t < meshlet.triangleCount; ++t)
+    {
+        if (triangleNormals[t] != glm::vec3(0.0f))
+            minDot = std::min(minDot, glm::dot(axis, triangleNormals[t]));
+    }
+
+    // Cones this wide cull too rarely to be worth testing
+    if (minDot <= 0.1f)
+        return bounds;
+
+    // Move the apex back along the axis until every triangle's plane faces away from it
+    float maxDistance = 0.0f;
+    for (uint32_t t = 0; t < meshlet.triangleCount; ++t)
+    {
+        const float facing = glm::dot(axis, triangleNormals[t]);
+        if (facing <= 0.0f)
+            continue;
+        const float distance = glm::dot(bounds.center - triangleCorner(t, 0), triangleNormals[t]) / facing;
+        maxDistance = std::max(maxDistance, distance);
+    }
+
+    bounds.coneApex = bounds.center - axis * maxDistance;
+    bounds.coneAxis = axis;
+    bounds.coneCutoff = std::sqrt(1.0f - minDot * minDot);
+    return bounds;
+}
+
+}
+
+MeshletData BuildMeshlets(uint32_t* indices, size_t indexCount, const float* positions, size_t positionStride,
+                          uint32_t vertexCount, uint32_t maxVertices, uint32_t maxTriangles)
+{
+    DM_ASSERT_MSG(indexCount % 3 == 0, "Meshlets are built from triangle lists");
+    DM_ASSERT_MSG(maxVertices >= 3 && maxVertices < meshletUnusedVertex && maxTriangles > 0,
+                  "Meshlets hold between 3 and 254 vertices and at least one triangle");
+
+    MeshletData data;
+    const auto triangleCount = (uint32_t) (indexCount / 3);
+    if (triangleCount == 0)
+        return data;
+
+    // Triangles using each vertex, and how many of them aren't in a meshlet yet
+    std::vector<uint32_t> offsets(vertexCount + 1, 0);
+    for (size_t i = 0; i < indexCount; ++i)
+        ++offsets[indices[i] + 1];
+    for (uint32_t v = 0; v < vertexCount; ++v)
+        offsets[v + 1] += offsets[v];
+
+    std::vector<uint32_t> adjacency(indexCount);
+    std::vector<uint32_t> liveTriangles(vertexCount, 0);
+    for (size_t i = 0; i < indexCount; ++i)
+        adjacency[offsets[indices[i]] + liveTriangles[indices[i]]++] = (uint32_t) (i / 3);
+
+    std::vector<glm::vec3> centroids(triangleCount);
+    for (uint32_t t = 0; t < triangleCount; ++t)
+    {
+        centroids[t] = (MeshletPosition(positions, positionStride, indices[t * 3 + 0]) +
+                        MeshletPosition(positions, positionStride, indices[t * 3 + 1]) +
+                        MeshletPosition(positions, positionStride, indices[t * 3 + 2])) / 3.0f;
+    }
+
+    std::vector<uint8_t> emitted(triangleCount, 0);
+    std::vector<uint8_t> localIndex(vertexCount, meshletUnusedVertex);
+    std::vector<uint32_t> order;
+    order.reserve(triangleCount);
+
+    Meshlet meshlet = {};
+    glm::vec3 positionSum = glm::vec3(0.0f);
+    uint32_t seed = 0;
+
+    auto newVertices = [&](uint32_t triangle) {
+        return (uint32_t) (localIndex[indices[triangle * 3 + 0]] == meshletUnusedVertex) +
+               (uint32_t) (localIndex[indices[triangle * 3 + 1]] == meshletUnusedVertex) +
+               (uint32_t) (localIndex[indices[triangle * 3 + 2]] == meshletUnusedVertex);
+    };
+
+    auto finishMeshlet = [&]() {
+        for (uint32_t i = 0; i < meshlet.vertexCount; ++i)
+            localIndex[data.vertices[meshlet.vertexOffset + i]] = meshletUnusedVertex;
+
+        data.meshlets.push_back(meshlet);
+        data.bounds.push_back(ComputeMeshletBounds(data, meshlet, positions, positionStride));
+
+        meshlet = {};
+        meshlet.vertexOffset = (uint32_t) data.vertices.size();
+        meshlet.triangleOffset = (uint32_t) data.triangles.size();
+        positionSum = glm::vec3(0.0f);
+    };
+
+    while (order.size() < triangleCount)
+    {
+        // Grow through the neighbour adding the fewest vertices, breaking ties by closeness to the meshlet
+        uint32_t best = meshletNoTriangle;
+        uint32_t bestNew = 4;
+        float bestDistance = std::numeric_limits<float>::max();
+        bool hasNeighbours = false;
+
+        const glm::vec3 center = meshlet.vertexCount > 0 ? positionSum / (float) meshlet.vertexCount : glm::vec3(0.0f);
+        for (uint32_t i = 0; i < meshlet.vertexCount; ++i)
+        {
+            const uint32_t vertex = data.vertices[meshlet.vertexOffset + i];
+            if (liveTriangles[vertex] == 0)
+                continue;
+
+            for (uint32_t a = offsets[vertex]; a < offsets[vertex + 1]; ++a)
+            {
+                const uint32_t triangle = adjacency[a];
+                if (emitted[triangle])
+                    continue;
+
+                hasNeighbours = true;
+                const uint32_t added = newVertices(triangle);
+                if (meshlet.vertexCount + added > maxVertices || meshlet.triangleCount >= maxTriangles)
+                    continue;
+
+                const glm::vec3 offset = centroids[triangle] - center;
+                const float distance = glm::dot(offset, offset);
+                if (added < bestNew || (added == bestNew && distance < bestDistance))
+                {
+                    best = triangle;
+                    bestNew = added;
+                    bestDistance = distance;
+                }
+            }
+        }
+
+        // Once its surface is exhausted a meshlet continues with the next triangle in index order,
+        // which after vertex cache optimization is usually nearby, merging small disconnected parts
+        if (best == meshletNoTriangle && !hasNeighbours)
+        {
+            while (emitted[seed])
+                ++seed;
+            if (meshlet.vertexCount + newVertices(seed) <= maxVertices && meshlet.triangleCount < maxTriangles)
+                best = seed;
+        }
+
+        if (best == meshletNoTriangle)
+        {
+            finishMeshlet();
+            continue;
+        }
+
+        for (uint32_t corner = 0; corner < 3; ++corner)
+        {
+            const uint32_t vertex = indices[best * 3 + corner];
+            if (localIndex[vertex] == meshletUnusedVertex)
+            {
+                localIndex[vertex] = (uint8_t) meshlet.vertexCount++;
+                data.vertices.push_back(vertex);
+                positionSum += MeshletPosition(positions, positionStride, vertex);
+            }
+            data.triangles.push_back(localIndex[vertex]);
+            --liveTriangles[vertex];
+        }
+
+        emitted[best] = 1;
+        order.push_back(best);
+        ++meshlet.triangleCount;
+    }
+    finishMeshlet();
+
+    // Indices follow the meshlets, letting a meshlet's triangles be drawn as one index range
+    std::vector<uint32_t> source(indices, indices + indexCount);
+    for (size_t i = 0; i < order.size(); ++i)
+    {
+        indices[i * 3 + 0] = source[order[i] * 3 + 0];
+        indices[i * 3 + 1] = source[order[i] * 3 + 1];
+        indices[i * 3 + 2] = source[order[i] * 3 + 2];
+    }
+
+    data.triangles.resize((data.triangles.size() + 3) & ~(size_t) 3, 0);
+    return data;
+}
+
+}
@@ -0,0 +1,76 @@
+//------------------------------------------------------------------------------
+//
+// File Name:	Meshlets.h
+// Author(s):	Jonathan Bourim (j.bourim)
+// Date:        10/19/2026
+//
+//------------------------------------------------------------------------------
+#pragma once
+
+namespace dm
+{
+
+/**
+ * Cluster of at most maxVertices vertices and maxTriangles triangles of a mesh.
+ * Meshlets cover consecutive triangles of the mesh's index buffer, so triangleOffset
+ * is both the meshlet's first local index and its first index within the mesh.
+ */
+struct Meshlet
+{
+    uint32_t vertexOffset;      //< First of the meshlet's entries in MeshletData::vertices
+    uint32_t triangleOffset;    //< First of the meshlet's local indices in MeshletData::triangles
+    uint32_t vertexCount;
+    uint32_t triangleCount;
+};
+
+/**
+ * Bounding sphere and normal cone of a meshlet, in the mesh's local space.
+ * The meshlet is backfacing from any position p where dot(normalize(coneApex - p), coneAxis) >= coneCutoff.
+ */
+struct MeshletBounds
+{
+    glm::vec3 center;
+    float radius;
+    glm::vec3 coneApex;
+    float coneCutoff;           //< Sine of the cone's half angle, 1 when the meshlet can't be backface culled
+    glm::vec3 coneAxis;
+    float pad;
+};
+
+struct MeshletData
+{
+    static constexpr uint32_t maxVertices = 64;
+    static constexpr uint32_t maxTriangles = 124;
+
+    std::vector<Meshlet> meshlets;
+    std::vector<MeshletBounds> bounds;      //< One per meshlet
+    std::vector<uint32_t> vertices;         //< Mesh vertex index of each meshlet's local vertices
+    std::vector<uint8_t> triangles;         //< Local vertex indices, three per triangle, zero padded to a multiple of 4
+
+    [[nodiscard]] uint32_t GetTriangleCount() const
+    {
+        return meshlets.empty() ? 0 : (meshlets.back().triangleOffset / 3 + meshlets.back().triangleCount);
+    }
+};
+
+/// \brief Split a triangle list into meshlets, growing each from a seed triangle through its neighbours
+///        to keep them compact for culling. Reorders indices in place into meshlet order.
+/// \param positions First vertex's position, three floats every positionStride bytes
+MeshletData BuildMeshlets(uint32_t* indices, size_t indexCount, const float* positions, size_t positionStride,
+                          uint32_t vertexCount, uint32_t maxVertices = MeshletData::maxVertices,
+                          uint32_t maxTriangles = MeshletData::maxTriangles);
+
+/// \brief Meshlets of the full detail level of mesh data, reordering its indices.
+///        LOD ranges past the first are left untouched.
+template<class VertexType>
+MeshletData BuildMeshlets(typename Mesh<VertexType>::Data& data, const std::vector<LodRange>& lods = {})
+{
+    const size_t indexCount = lods.empty() ? data.indices.size() : lods[0].indexCount;
+    if (indexCount == 0 || data.vertices.empty())
+        return {};
+
+    return BuildMeshlets(data.indices.data() + (lods.empty() ? 0 : lods[0].firstIndex), indexCount,
+                         &data.vertices[0].pos.x, sizeof(VertexType), (uint32_t) data.vertices.size());
+}
+
+}
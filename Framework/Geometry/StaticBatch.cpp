@@ -0,0 +1,125 @@
+//------------------------------------------------------------------------------
+//
+// File Name:	StaticBatch.cpp
+// Author(s):	Jonathan Bourim (j.bourim)
+// Date:        10/19/2026
+//
+//------------------------------------------------------------------------------
+
+#include "StaticBatch.h"
+
+namespace dm
+{
+
+namespace
+{
+
+uint64_t StaticBatchTableEnd(const StaticBatchHeader& header)
+{
+    return sizeof(StaticBatchHeader) + sizeof(StaticBatchChunk) * header.chunkCount;
+}
+
+void PartitionStaticBatchRange(detail::StaticBatchItem* begin, detail::StaticBatchItem* end,
+                               const StaticBatchSettings& settings, std::vector<uint32_t>& chunkSizes)
+{
+    const auto count = (uint32_t) (end - begin);
+    uint64_t vertices = 0;
+    uint64_t triangles = 0;
+    glm::vec3 centerMin(std::numeric_limits<float>::max());
+    glm::vec3 centerMax(std::numeric_limits<float>::lowest());
+    for (const detail::StaticBatchItem* item = begin; item != end; ++item)
+    {
+        vertices += item->vertexCount;
+        triangles += item->triangleCount;
+        centerMin = glm::min(centerMin, item->center);
+        centerMax = glm::max(centerMax, item->center);
+    }
+
+    if (count == 1 || (triangles <= settings.chunkTriangles && vertices <= settings.chunkVertices))
+    {
+        chunkSizes.push_back(count);
+        return;
+    }
+
+    const glm::vec3 extent = centerMax - centerMin;
+    const int axis = extent.x >= extent.y && extent.x >= extent.z ? 0 : (extent.y >= extent.z ? 1 : 2);
+    std::sort(begin, end, [axis](const detail::StaticBatchItem& a, const detail::StaticBatchItem& b)
+    {
+        return a.center[axis] < b.center[axis];
+    });
+
+    // Split where half the triangles lie on each side, so few large instances don't leave one side empty
+    uint64_t below = 0;
+    uint32_t split = 1;
+    for (; split < count - 1; ++split)
+    {
+        below += begin[split - 1].triangleCount;
+        if (below * 2 >= triangles)
+            break;
+    }
+
+    PartitionStaticBatchRange(begin, begin + split, settings, chunkSizes);
+    PartitionStaticBatchRange(begin + split, end, settings, chunkSizes);
+}
+
+}
+
+std::vector<uint32_t> detail::PartitionStaticBatch(std::vector<StaticBatchItem>& items, const StaticBatchSettings& settings)
+{
+    std::vector<uint32_t> chunkSizes;
+    if (!items.empty())
+        PartitionStaticBatchRange(items.data(), items.data() + items.size(), settings, chunkSizes);
+    return chunkSizes;
+}
+
+bool StaticBatchCache::WriteFile(const std::string& path, StaticBatchHeader header,
+                                 const std::vector<StaticBatchChunk>& chunks, const void* vertices,
+                                 const uint32_t* indices)
+{
+    header.chunkCount = (uint32_t) chunks.size();
+    const CacheFile::Layout layout = CacheFile::GetLayout(StaticBatchTableEnd(header), header.vertexStride, header.vertexCount);
+    header.vertexOffset = layout.vertexOffset;
+    header.indexOffset = layout.indexOffset;
+
+    return CacheFile::Write(path, {
+        { &header, sizeof(header) },
+        { chunks.data(), sizeof(StaticBatchChunk) * chunks.size() }
+    }, layout, vertices, (uint64_t) header.vertexStride * header.vertexCount, indices, header.indexCount);
+}
+
+bool StaticBatchCache::OpenFile(const std::string& path, uint64_t inputHash, uint32_t vertexStride)
+{
+    Close();
+    if (!CacheFile::Open(file, path, vertexStride, header, StaticBatchTableEnd) || header.inputHash != inputHash)
+    {
+        Close();
+        return false;
+    }
+
+    for (const StaticBatchChunk& chunk : GetChunks())
+    {
+        if ((uint64_t) chunk.firstIndex + chunk.indexCount > header.indexCount
+            || (uint64_t) chunk.vertexOffset + chunk.vertexCount > header.vertexCount)
+        {
+            Close();
+            return false;
+        }
+    }
+    return true;
+}
+
+void StaticBatchCache::Close()
+{
+    file.Close();
+    header = {};
+}
+
+std::vector<StaticBatchChunk> StaticBatchCache::GetChunks() const
+{
+    std::vector<StaticBatchChunk> chunks(header.chunkCount);
+    if (header.chunkCount > 0)
+        std::memcpy(chunks.data(), file.Data() + sizeof(StaticBatchHeader), sizeof(StaticBatchChunk) * header.chunkCount);
+    return chunks;
+}
+
+}
@@ -0,0 +1,336 @@
+//------------------------------------------------------------------------------
+//
+// File Name:	StaticBatch.h
+// Author(s):	Jonathan Bourim (j.bourim)
+// Date:        10/19/2026
+//
+//------------------------------------------------------------------------------
+#pragma once
+
+namespace dm
+{
+
+struct StaticBatchSettings
+{
+    uint32_t chunkTriangles = 16384;    //< Triangles chunks are split down to, the granularity they're culled at
+    uint32_t chunkVertices = 0xFFFF;    //< Most vertices of a chunk, keeping its local indices within 16 bits
+};
+
+/// \brief Part of a static batch drawn and culled as one
+struct StaticBatchChunk
+{
+    uint32_t firstIndex = 0;            //< Relative to the batch's first index
+    uint32_t indexCount = 0;
+    uint32_t vertexOffset = 0;          //< Added to the chunk's indices, which are local to its vertices
+    uint32_t vertexCount = 0;
+    primitives::Box bounds = {};        //< World space
+};
+
+template<class VertexType>
+struct StaticBatchInstance
+{
+    typename Mesh<VertexType>::View geometry;       //< Limited to LOD 0's indices for meshes with a LOD chain
+    glm::mat4 model = glm::mat4(1.0f);
+};
+
+template<class VertexType>
+struct StaticBatchData
+{
+    typename Mesh<VertexType>::Data geometry;       //< World space vertices, indices local to each chunk
+    std::vector<StaticBatchChunk> chunks;
+};
+
+namespace detail
+{
+
+struct StaticBatchItem
+{
+    glm::vec3 center;
+    uint32_t vertexCount;
+    uint32_t triangleCount;
+    uint32_t instance;
+};
+
+/// \brief Reorder items so the instances of each chunk are consecutive
+/// \return Item count of each chunk, in order
+std::vector<uint32_t> PartitionStaticBatch(std::vector<StaticBatchItem>& items, const StaticBatchSettings& settings);
+
+}
+
+/// \brief Bake instances' model matrices into their vertices and merge them into spatially coherent chunks.
+///        Instances are split at their median along the longest axis until each chunk fits the settings,
+///        and kept whole, so an instance larger than a chunk becomes a chunk of its own.
+///        Instances should share a pipeline and material, the batch is drawn with one of each.
+template<class VertexType>
+StaticBatchData<VertexType> BuildStaticBatch(const std::vector<StaticBatchInstance<VertexType>>& instances,
+                                             const StaticBatchSettings& settings = {})
+{
+    size_t vertexTotal = 0;
+    size_t indexTotal = 0;
+    std::vector<detail::StaticBatchItem> items;
+    items.reserve(instances.size());
+    for (uint32_t i = 0; i < (uint32_t) instances.size(); ++i)
+    {
+        const typename Mesh<VertexType>::View& geometry = instances[i].geometry;
+        if (geometry.vertexCount == 0)
+            continue;
+
+        // Instances are placed by the center of their local bounds, close enough to partition by
+        glm::vec3 boundsMin(std::numeric_limits<float>::max());
+        glm::vec3 boundsMax(std::numeric_limits<float>::lowest());
+        for (uint32_t v = 0; v < geometry.vertexCount; ++v)
+        {
+            boundsMin = glm::min(boundsMin, geometry.vertices[v].pos);
+            boundsMax = glm::max(boundsMax, geometry.vertices[v].pos);
+        }
+
+        const uint32_t indexCount = geometry.indexCount > 0 ? geometry.indexCount : geometry.vertexCount;
+        const glm::vec3 center = glm::vec3(instances[i].model * glm::vec4((boundsMin + boundsMax) * 0.5f, 1.0f));
+        items.push_back({ center, geometry.vertexCount, indexCount / 3, i });
+        vertexTotal += geometry.vertexCount;
+        indexTotal += indexCount - indexCount % 3;
+    }
+
+    StaticBatchData<VertexType> data;
+    data.geometry.vertices.reserve(vertexTotal);
+    data.geometry.indices.reserve(indexTotal);
+
+    const std::vector<uint32_t> chunkSizes = detail::PartitionStaticBatch(items, settings);
+    data.chunks.reserve(chunkSizes.size());
+
+    size_t item = 0;
+    for (uint32_t chunkSize : chunkSizes)
+    {
+        StaticBatchChunk chunk;
+        chunk.firstIndex = (uint32_t) data.geometry.indices.size();
+        chunk.vertexOffset = (uint32_t) data.geometry.vertices.size();
+
+        glm::vec3 boundsMin(std::numeric_limits<float>::max());
+        glm::vec3 boundsMax(std::numeric_limits<float>::lowest());
+        for (const size_t chunkEnd = item + chunkSize; item < chunkEnd; ++item)
+        {
+            const StaticBatchInstance<VertexType>& instance = instances[items[item].instance];
+            const typename Mesh<VertexType>::View& geometry = instance.geometry;
+            const glm::mat3 normalMatrix = glm::transpose(glm::inverse(glm::mat3(instance.model)));
+            const auto base = (uint32_t) (data.geometry.vertices.size() - chunk.vertexOffset);
+
+            for (uint32_t v = 0; v < geometry.vertexCount; ++v)
+            {
+                data.geometry.vertices.push_back(TransformVertex(geometry.vertices[v], instance.model, normalMatrix));
+                boundsMin = glm::min(boundsMin, data.geometry.vertices.back().pos);
+                boundsMax = glm::max(boundsMax, data.geometry.vertices.back().pos);
+            }
+
+            // Mirroring transforms reverse the winding, which is restored to keep the front faces
+            const bool mirrored = glm::determinant(glm::mat3(instance.model)) < 0.0f;
+            const uint32_t indexCount = geometry.indexCount > 0 ? geometry.indexCount : geometry.vertexCount;
+            for (uint32_t i = 0; i + 2 < indexCount; i += 3)
+            {
+                uint32_t corners[3] = { i, i + 1, i + 2 };
+                if (geometry.indexCount > 0)
+                {
+                    for (uint32_t& corner : corners)
+                        corner = geometry.indices[corner];
+                }
+                if (mirrored)
+                    std::swap(corners[1], corners[2]);
+
+                for (uint32_t corner : corners)
+                    data.geometry.indices.push_back(base + corner);
+            }
+        }
+
+        chunk.indexCount = (uint32_t) data.geometry.indices.size() - chunk.firstIndex;
+        chunk.vertexCount = (uint32_t) data.geometry.vertices.size() - chunk.vertexOffset;
+        chunk.bounds = { (boundsMin + boundsMax) * 0.5f, (boundsMax - boundsMin) * 0.5f };
+        data.chunks.push_back(chunk);
+    }
+    return data;
+}
+
+/// \brief Header of a static batch cache file, followed by its chunks, then the vertex and index blobs
+struct StaticBatchHeader
+{
+    static constexpr uint32_t magicValue = 0x42534D44;      //< "DMSB"
+    static constexpr uint32_t currentVersion = 1;
+
+    uint32_t magic = magicValue;
+    uint32_t version = currentVersion;
+    uint64_t inputHash = 0;                                 //< StaticBatchCache::Hash of what the batch was built from
+    uint32_t vertexStride = 0;
+    uint32_t chunkCount = 0;
+    uint32_t vertexCount = 0;
+    uint32_t indexCount = 0;
+    uint64_t vertexOffset = 0;                              //< Byte offset of the vertex blob from the start of the file
+    uint64_t indexOffset = 0;
+};
+
+/**
+ * Binary files holding built static batches, so later loads skip baking and partitioning.
+ * Files are keyed by a hash of everything the batch is built from, and are rebuilt when it,
+ * or the format version, no longer matches. Files are laid out and mapped as CacheFile describes.
+ */
+class StaticBatchCache
+{
+public:
+    static constexpr const char* extension = ".dbatch";
+
+    /// \brief Hash of the instances' geometry and model matrices, their vertex layout and the settings
+    template<class VertexType>
+    static uint64_t Hash(const std::vector<StaticBatchInstance<VertexType>>& instances, const StaticBatchSettings& settings)
+    {
+        static_assert(std::is_trivially_copyable<VertexType>::value, "Cached vertices are hashed and written by their bytes");
+
+        const uint32_t layout[3] = { (uint32_t) sizeof(VertexType), settings.chunkTriangles, settings.chunkVertices };
+        uint64_t hash = CacheFile::HashBytes(StaticBatchHeader::currentVersion, layout, sizeof(layout));
+        for (const VertexAttribute& attribute : VertexType::Attributes())
+        {
+            const uint32_t packed[2] = { (uint32_t) attribute.format, attribute.offset };
+            hash = CacheFile::HashBytes(hash, packed, sizeof(packed));
+        }
+
+        for (const StaticBatchInstance<VertexType>& instance : instances)
+        {
+            const uint32_t counts[2] = { instance.geometry.vertexCount, instance.geometry.indexCount };
+            hash = CacheFile::HashBytes(hash, counts, sizeof(counts));
+            hash = CacheFile::HashBytes(hash, &instance.model, sizeof(glm::mat4));
+            hash = CacheFile::HashBytes(hash, instance.geometry.vertices, sizeof(VertexType) * instance.geometry.vertexCount);
+            hash = CacheFile::HashBytes(hash, instance.geometry.indices, sizeof(uint32_t) * instance.geometry.indexCount);
+        }
+        return hash;
+    }
+
+    /// \brief Write a built batch to a cache file
+    /// \return False if the file couldn't be written
+    template<class VertexType>
+    static bool Write(const std::string& path, uint64_t inputHash, const StaticBatchData<VertexType>& data)
+    {
+        StaticBatchHeader header;
+        header.inputHash = inputHash;
+        header.vertexStride = sizeof(VertexType);
+        header.vertexCount = (uint32_t) data.geometry.vertices.size();
+        header.indexCount = (uint32_t) data.geometry.indices.size();
+        return WriteFile(path, header, data.chunks, data.geometry.vertices.data(), data.geometry.indices.data());
+    }
+
+    /// \brief Map a cache file, failing if it's missing, out of date or of another vertex layout
+    template<class VertexType>
+    bool Open(const std::string& path, uint64_t inputHash)
+    {
+        return OpenFile(path, inputHash, sizeof(VertexType));
+    }
+
+    void Close();
+
+    /// \brief Geometry of the open file, pointing into the mapping
+    template<class VertexType>
+    [[nodiscard]] typename Mesh<VertexType>::View GetView() const
+    {
+        DM_ASSERT_MSG(file.IsOpen() && header.vertexStride == sizeof(VertexType), "Static batch view of another vertex type");
+        return {
+            reinterpret_cast<const VertexType*>(file.Data() + header.vertexOffset), header.vertexCount,
+            reinterpret_cast<const uint32_t*>(file.Data() + header.indexOffset), header.indexCount
+        };
+    }
+
+    /// \brief Chunks of the open file
+    [[nodiscard]] std::vector<StaticBatchChunk> GetChunks() const;
+
+private:
+    static bool WriteFile(const std::string& path, StaticBatchHeader header, const std::vector<StaticBatchChunk>& chunks,
+                          const void* vertices, const uint32_t* indices);
+    bool OpenFile(const std::string& path, uint64_t inputHash, uint32_t vertexStride);
+
+    MappedFile file;
+    StaticBatchHeader header;
+};
+
+/**
+ * Static meshes merged into one mesh at load time, see BuildStaticBatch.
+ * The mesh is bound once and every chunk left visible by Cull is one indexed draw.
+ * Chunk indices are local to their vertices, so batches whose chunks fit in 65535
+ * vertices are drawn with 16 bit indices.
+ *
+ * Per frame: Cull, then Draw inside a render pass with the batch's pipeline bound.
+ */
+template<class VertexType>
+class StaticBatch
+{
+public:
+    /// \brief Create from the cache file at cachePath, building the instances into it
+    ///        when it's missing or was built from anything else
+    void Load(const std::string& cachePath, const std::vector<StaticBatchInstance<VertexType>>& instances,
+              Device* owner, const StaticBatchSettings& settings = {})
+    {
+        const uint64_t inputHash = StaticBatchCache::Hash(instances, settings);
+
+        StaticBatchCache cache;
+        if (cache.Open<VertexType>(cachePath, inputHash))
+        {
+            Create(cache.GetView<VertexType>(), cache.GetChunks(), owner);
+            return;
+        }
+
+        const StaticBatchData<VertexType> data = BuildStaticBatch(instances, settings);
+        StaticBatchCache::Write(cachePath, inputHash, data);
+        Create(data, owner);
+    }
+
+    void Create(const StaticBatchData<VertexType>& data, Device* owner)
+    {
+        Create({ data.geometry.vertices.data(), (uint32_t) data.geometry.vertices.size(),
+                 data.geometry.indices.data(), (uint32_t) data.geometry.indices.size() }, data.chunks, owner);
+    }
+
+    void Create(const typename Mesh<VertexType>::View& view, std::vector<StaticBatchChunk> inChunks, Device* owner)
+    {
+        DM_ASSERT_MSG(!inChunks.empty() && view.indexCount > 0, "Attempting to create an empty static batch");
+        mesh.Create(view, owner);
+        chunks = std::move(inChunks);
+
+        bounds.Clear();
+        bounds.Reserve((uint32_t) chunks.size());
+        visible.resize(chunks.size());
+        for (uint32_t i = 0; i < (uint32_t) chunks.size(); ++i)
+        {
+            bounds.Add(chunks[i].bounds);
+            visible[i] = i;
+        }
+    }
+
+    /// \brief Keep the chunks intersecting the frustum for Draw, every chunk is kept until the first Cull
+    /// \param pool Optional thread pool to cull with
+    void Cull(const Frustum& frustum, ThreadPool* pool = nullptr)
+    {
+        FrustumCull(frustum, bounds, visible, pool);
+    }
+
+    /// \brief Bind the batch and record a draw per visible chunk
+    void Draw(CommandRecorder& recorder, uint32_t instanceCount = 1, uint32_t firstInstance = 0) const
+    {
+        if (visible.empty())
+            return;
+
+        mesh.Bind(recorder);
+        for (uint32_t index : visible)
+        {
+            const StaticBatchChunk& chunk = chunks[index];
+            recorder.DrawIndexed(chunk.indexCount, instanceCount, mesh.GetFirstIndex() + chunk.firstIndex,
+                                 (int32_t) (mesh.GetVertexOffset() + chunk.vertexOffset), firstInstance);
+        }
+    }
+
+    [[nodiscard]] const Mesh<VertexType>& GetMesh() const { return mesh; }
+    [[nodiscard]] const std::vector<StaticBatchChunk>& GetChunks() const { return chunks; }
+
+    /// \brief Indices of the chunks left by the last Cull
+    [[nodiscard]] const std::vector<uint32_t>& GetVisible() const { return visible; }
+
+private:
+    Mesh<VertexType> mesh;
+    std::vector<StaticBatchChunk> chunks;
+    BoxBounds bounds;                       //< One per chunk
+    std::vector<uint32_t> visible;          //< Reused across frames
+};
+
+}
@@ -0,0 +1,283 @@
+//------------------------------------------------------------------------------
+//
+// File Name:	VertexDeduplication.h
+// Author(s):	Jonathan Bourim (j.bourim)
+// Date:        10/19/2026
+//
+//------------------------------------------------------------------------------
+#pragma once
+
+namespace dm
+{
+
+namespace detail
+{
+
+// Vertices are compared by their float components, with -0 and +0 as the same value
+inline uint32_t CanonicalVertexWord(uint32_t word)
+{
+    return word == 0x80000000u ? 0u : word;
+}
+
+// MurmurHash3 finalizer
+inline uint64_t MixVertexHash(uint64_t hash)
+{
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdull;
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53ull;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+}
+
+/// \brief Components a vertex is deduplicated by, packed as 32 bit words. Defaults to every component.
+template<class VertexType>
+struct VertexKey
+{
+    static_assert(sizeof(VertexType) % sizeof(uint32_t) == 0, "Vertices are keyed by 32 bit components");
+    static constexpr size_t wordCount = sizeof(VertexType) / sizeof(uint32_t);
+
+    static void Get(const VertexType& vertex, uint32_t* words)
+    {
+        std::memcpy(words, &vertex, sizeof(VertexType));
+    }
+};
+
+/// \brief Vertex leaves out its normal, as Vertex::operator== does
+template<>
+struct VertexKey<Vertex>
+{
+    static constexpr size_t wordCount = 8;
+
+    static void Get(const Vertex& vertex, uint32_t* words)
+    {
+        std::memcpy(words, &vertex.pos, sizeof(glm::vec3));
+        std::memcpy(words + 3, &vertex.color, sizeof(glm::vec3));
+        std::memcpy(words + 6, &vertex.texPos, sizeof(glm::vec2));
+    }
+};
+
+/// \brief 64 bit hash of a vertex's VertexKey
+template<class VertexType>
+uint64_t HashVertex(const VertexType& vertex)
+{
+    constexpr size_t wordCount = VertexKey<VertexType>::wordCount;
+
+    uint32_t words[wordCount];
+    VertexKey<VertexType>::Get(vertex, words);
+
+    uint64_t hash = sizeof(VertexType);
+    size_t i = 0;
+    for (; i + 1 < wordCount; i += 2)
+    {
+        const uint64_t pair = detail::CanonicalVertexWord(words[i]) |
+                              ((uint64_t) detail::CanonicalVertexWord(words[i + 1]) << 32);
+        hash = detail::MixVertexHash(hash + pair);
+    }
+    if (i < wordCount)
+        hash = detail::MixVertexHash(hash + detail::CanonicalVertexWord(words[i]));
+
+    return hash;
+}
+
+/// \brief Whether two vertices' keys are equal, matching component-wise operator== but for NaNs
+template<class VertexType>
+bool VertexComponentsEqual(const VertexType& a, const VertexType& b)
+{
+    constexpr size_t wordCount = VertexKey<VertexType>::wordCount;
+
+    uint32_t wordsA[wordCount];
+    uint32_t wordsB[wordCount];
+    VertexKey<VertexType>::Get(a, wordsA);
+    VertexKey<VertexType>::Get(b, wordsB);
+
+    for (size_t i = 0; i < wordCount; ++i)
+    {
+        // Equal bits, or both are zeroes of any sign
+        if (wordsA[i] != wordsB[i] && ((wordsA[i] | wordsB[i]) & 0x7fffffffu) != 0)
+            return false;
+    }
+    return true;
+}
+
+/**
+ * Open addressing, linear probing table of indices into a vertex array, keyed by the vertex they index.
+ * Vertices and their hashes live in arrays owned by the caller, so a slot is a single index.
+ */
+template<class VertexType>
+class VertexHashTable
+{
+public:
+    static constexpr uint32_t empty = ~0u;
+
+    void Reserve(size_t count)
+    {
+        size_t capacity = 16;
+        while (capacity < count * 2)
+            capacity *= 2;
+
+        slots.assign(capacity, empty);
+        mask = capacity - 1;
+        size = 0;
+    }
+
+    /// \brief Find a vertex equal to vertex, or insert it as vertices.size(), which the caller must then append.
+    /// \return Index of the equal or inserted vertex
+    uint32_t FindOrInsert(const VertexType& vertex, uint64_t hash,
+                          const std::vector<VertexType>& vertices, const std::vector<uint64_t>& hashes)
+    {
+        if ((size + 1) * 2 > slots.size())
+            Grow(hashes);
+
+        for (size_t slot = hash & mask;; slot = (slot + 1) & mask)
+        {
+            const uint32_t index = slots[slot];
+            if (index == empty)
+            {
+                slots[slot] = (uint32_t) vertices.size();
+                ++size;
+                return slots[slot];
+            }
+            if (hashes[index] == hash && VertexComponentsEqual(vertices[index], vertex))
+                return index;
+        }
+    }
+
+private:
+    void Grow(const std::vector<uint64_t>& hashes)
+    {
+        std::vector<uint32_t> old = std::move(slots);
+        slots.assign(old.size() * 2, empty);
+        mask = slots.size() - 1;
+
+        for (uint32_t index : old)
+        {
+            if (index == empty)
+                continue;
+
+            size_t slot = hashes[index] & mask;
+            while (slots[slot] != empty)
+                slot = (slot + 1) & mask;
+            slots[slot] = index;
+        }
+    }
+
+    std::vector<uint32_t> slots;
+    size_t mask = 0;
+    size_t size = 0;
+};
+
+/// \brief Deduplicate a stream of corners into unique vertices and the indices of each corner.
+///        Vertices are kept in order of first occurrence, so the output matches a serial pass whatever the thread count.
+///        Corner ranges are deduplicated on their own in parallel, then merged in order.
+/// \param buildCorners buildCorners(begin, end, out) writes the vertices of corners [begin, end) to out, called concurrently
+/// \param pool Optional thread pool, each thread deduplicates a contiguous range of corners
+template<class VertexType, class BuildCorners>
+void DeduplicateVertices(uint32_t cornerCount, const BuildCorners& buildCorners,
+                         std::vector<VertexType>& vertices, std::vector<uint32_t>& indices, ThreadPool* pool = nullptr)
+{
+    constexpr uint32_t MinCornersPerChunk = 1u << 16;
+    constexpr uint32_t BlockCorners = 4096;      //< Corners built at once, bounding the memory of built vertices
+
+    vertices.clear();
+    indices.resize(cornerCount);
+    if (cornerCount == 0)
+        return;
+
+    const uint32_t chunkCount = pool ? std::clamp(cornerCount / MinCornersPerChunk, 1u, pool->GetConcurrency()) : 1u;
+
+    struct Chunk
+    {
+        std::vector<VertexType> vertices;   //< Unique within the chunk, in order of first occurrence
+        std::vector<uint64_t> hashes;
+        std::vector<uint32_t> remap;        //< Chunk vertex to merged vertex
+        uint32_t begin = 0;
+        uint32_t end = 0;
+    };
+    std::vector<Chunk> chunks(chunkCount);
+
+    // Indices are first written as chunk vertex indices
+    auto deduplicateChunk = [&](uint32_t chunkIndex)
+    {
+        Chunk& chunk = chunks[chunkIndex];
+        chunk.begin = (uint32_t) ((uint64_t) cornerCount * chunkIndex / chunkCount);
+        chunk.end = (uint32_t) ((uint64_t) cornerCount * (chunkIndex + 1) / chunkCount);
+
+        // Closed meshes share each vertex between several corners
+        VertexHashTable<VertexType> table;
+        table.Reserve((chunk.end - chunk.begin) / 4);
+
+        std::vector<VertexType> block(std::min(BlockCorners, chunk.end - chunk.begin));
+        for (uint32_t blockBegin = chunk.begin; blockBegin < chunk.end; blockBegin += BlockCorners)
+        {
+            const uint32_t blockEnd = std::min(blockBegin + BlockCorners, chunk.end);
+            buildCorners(blockBegin, blockEnd, block.data());
+
+            for (uint32_t corner = blockBegin; corner < blockEnd; ++corner)
+            {
+                const VertexType& vertex = block[corner - blockBegin];
+                const uint64_t hash = HashVertex(vertex);
+                const uint32_t index = table.FindOrInsert(vertex, hash, chunk.vertices, chunk.hashes);
+                if (index == chunk.vertices.size())
+                {
+                    chunk.vertices.push_back(vertex);
+                    chunk.hashes.push_back(hash);
+                }
+                indices[corner] = index;
+            }
+        }
+    };
+
+    if (chunkCount == 1)
+    {
+        deduplicateChunk(0);
+        vertices = std::move(chunks[0].vertices);
+        return;
+    }
+
+    pool->Dispatch(chunkCount, deduplicateChunk);
+
+    // Merging chunks in order visits every vertex's first occurrence before any other
+    size_t chunkVertexCount = 0;
+    for (const Chunk& chunk : chunks)
+        chunkVertexCount += chunk.vertices.size();
+
+    std::vector<uint64_t> hashes;
+    VertexHashTable<VertexType> table;
+    table.Reserve(chunkVertexCount);
+    vertices.reserve(chunkVertexCount);
+    hashes.reserve(chunkVertexCount);
+    for (Chunk& chunk : chunks)
+    {
+        chunk.remap.resize(chunk.vertices.size());
+        for (size_t i = 0; i < chunk.vertices.size(); ++i)
+        {
+            const uint32_t index = table.FindOrInsert(chunk.vertices[i], chunk.hashes[i], vertices, hashes);
+            if (index == vertices.size())
+            {
+                vertices.push_back(chunk.vertices[i]);
+                hashes.push_back(chunk.hashes[i]);
+            }
+            chunk.remap[i] = index;
+        }
+
+        std::vector<VertexType>().swap(chunk.vertices);
+        std::vector<uint64_t>().swap(chunk.hashes);
+    }
+    vertices.shrink_to_fit();
+
+    pool->Dispatch(chunkCount, [&](uint32_t chunkIndex)
+    {
+        // The first chunk's vertices are merged in order, so its indices are already final
+        if (chunkIndex == 0)
+            return;
+
+        const Chunk& chunk = chunks[chunkIndex];
+        for (uint32_t corner = chunk.begin; corner < chunk.end; ++corner)
+            indices[corner] = chunk.remap[indices[corner]];
+    });
+}
+
+}
@@ -43,6 +43,7 @@ void Buffer::Destroy()
     if(created)
     {
         vmaDestroyBuffer(owner->allocator, VkCType(), allocation);
+        created = false;
     }
 }
 
@@ -94,22 +94,130 @@ DM_TYPE_OWNED_BODY(VertexBuffer<VertexType>, Buffer)
 
 	void Create(const std::vector<VertexType>& vertices, bool dynamic, Device* owner)
 	{
-		assert(!vertices.empty());
-		vertexCount = vertices.size();
+		Create(vertices.data(), vertices.size(), dynamic, owner);
+	}
+
+	void Create(const VertexType* vertices, size_t count, bool dynamic, Device* owner)
+	{
+		Create(vertices, count, dynamic, nullptr, owner);
+	}
+
+	// Static vertices copied by batch, usable once it completes
+	void Create(const VertexType* vertices, size_t count, UploadBatch& batch, Device* owner)
+	{
+		Create(vertices, count, false, &batch, owner);
+	}
+
+	void UpdateData(void* data, vk::DeviceSize size, uint32_t newVertexCount, bool submitToGPU)
+	{
+		vertexCount = newVertexCount;
+		Buffer::UpdateData(data, size, submitToGPU);
+	}
+
+	[[nodiscard]] uint32_t GetVertexCount() const
+	{
+		return vertexCount;
+	}
+
+private:
+	void Create(const VertexType* vertices, size_t count, bool dynamic, UploadBatch* batch, Device* owner)
+	{
+		assert(count != 0);
+		vertexCount = count;
 		Buffer::CreateStaged(
-			(void*) &vertices[0], vertices.size() * sizeof(VertexType),
+			(void*) vertices, count * sizeof(VertexType),
 			vk::BufferUsageFlagBits::eVertexBuffer,
 			VMA_MEMORY_USAGE_GPU_ONLY,
-			!dynamic,
+			!dynamic && batch == nullptr,
 			dynamic,
 			owner
 		);
+		if (batch != nullptr)
+			batch->Stage(*this);
 	}
 
-	void UpdateData(void* data, vk::DeviceSize size, uint32_t newVertexCount, bool submitToGPU)
+	uint32_t vertexCount = 0;
+};
+
+
+/**
+ * Static vertices deinterleaved per SplitVertex<VertexType>: a tightly packed position stream bound to
+ * VertexStream and a stream of the remaining attributes bound to AttributeStream.
+ */
+template<class VertexType>
+class SplitVertexBuffer
+{
+public:
+	void Create(const VertexType* vertices, size_t count, Device* owner)
 	{
-		vertexCount = newVertexCount;
-		Buffer::UpdateData(data, size, submitToGPU);
+		assert(count != 0);
+		static_assert(std::is_trivially_copyable<VertexType>::value, "Split vertices are copied by their bytes");
+		vertexCount = count;
+
+		const uint32_t positionStride = SplitVertex<VertexType>::PositionStride();
+		const uint32_t attributeStride = sizeof(VertexType) - positionStride;
+		std::vector<uint8_t> positionData((size_t) positionStride * count);
+		std::vector<uint8_t> attributeData((size_t) attributeStride * count);
+		const auto* source = reinterpret_cast<const uint8_t*>(vertices);
+		for (size_t i = 0; i < count; ++i)
+		{
+			std::memcpy(positionData.data() + positionStride * i, source + sizeof(VertexType) * i, positionStride);
+			std::memcpy(attributeData.data() + attributeStride * i, source + sizeof(VertexType) * i + positionStride, attributeStride);
+		}
+
+		positions.CreateStaged(
+			positionData.data(), positionData.size(),
+			vk::BufferUsageFlagBits::eVertexBuffer,
+			VMA_MEMORY_USAGE_GPU_ONLY,
+			true,
+			false,
+			owner
+		);
+		if (attributeStride > 0)
+		{
+			attributes.CreateStaged(
+				attributeData.data(), attributeData.size(),
+				vk::BufferUsageFlagBits::eVertexBuffer,
+				VMA_MEMORY_USAGE_GPU_ONLY,
+				true,
+				false,
+				owner
+			);
+		}
+	}
+
+	void Destroy()
+	{
+		positions.Destroy();
+		attributes.Destroy();
+		vertexCount = 0;
+	}
+
+	// Pipelines without a split layout must not be bound to these streams
+	void Bind(vk::CommandBuffer commandBuffer) const
+	{
+		vk::DeviceSize offset = 0;
+		commandBuffer.bindVertexBuffers(VertexStream, 1, &positions.VkType(), &offset);
+		if (attributes.VkType())
+			commandBuffer.bindVertexBuffers(AttributeStream, 1, &attributes.VkType(), &offset);
+	}
+
+	void Bind(CommandRecorder& recorder) const
+	{
+		recorder.BindVertexBuffer(VertexStream, positions.VkType());
+		if (attributes.VkType())
+			recorder.BindVertexBuffer(AttributeStream, attributes.VkType());
+	}
+
+	[[nodiscard]] vk::Buffer GetPositionBuffer() const
+	{
+		return positions.VkType();
+	}
+
+	// Null for layouts without attributes beyond their position
+	[[nodiscard]] vk::Buffer GetAttributeBuffer() const
+	{
+		return attributes.VkType();
 	}
 
 	[[nodiscard]] uint32_t GetVertexCount() const
@@ -118,10 +226,14 @@ DM_TYPE_OWNED_BODY(VertexBuffer<VertexType>, Buffer)
 	}
 
 private:
+	Buffer positions;
+	Buffer attributes;
 	uint32_t vertexCount = 0;
 };
 
 
+// Static index buffers are stored as 16 bit indices when every index fits, dynamic ones stay 32 bit
+// as their contents are rewritten in place.
 class IndexBuffer : public Buffer
 {
 public:
@@ -132,19 +244,23 @@ DM_TYPE_OWNED_BODY(IndexBuffer, Buffer)
 
 	void Create(const std::vector<uint32_t>& indices, bool dynamic, Device* owner)
 	{
-		assert(!indices.empty());
-		indexCount = indices.size();
-		Buffer::CreateStaged(
-			(void*) indices.data(), indices.size() * sizeof(uint32_t),
-			vk::BufferUsageFlagBits::eIndexBuffer,
-			VMA_MEMORY_USAGE_GPU_ONLY,
-			!dynamic,
-			dynamic,
-			owner);
+		Create(indices.data(), indices.size(), dynamic, owner);
+	}
+
+	void Create(const uint32_t* indices, size_t count, bool dynamic, Device* owner)
+	{
+		Create(indices, count, dynamic, nullptr, owner);
+	}
+
+	// Static indices copied by batch, usable once it completes
+	void Create(const uint32_t* indices, size_t count, UploadBatch& batch, Device* owner)
+	{
+		Create(indices, count, false, &batch, owner);
 	}
 
 	void UpdateData(void* data, vk::DeviceSize size, uint32_t newIndexCount, bool submitToGPU)
 	{
+		DM_ASSERT_MSG(indexType == vk::IndexType::eUint32, "Only dynamic, 32 bit index buffers are updated");
 		indexCount = newIndexCount;
 		Buffer::UpdateData(data, size, submitToGPU);
 	}
@@ -154,8 +270,44 @@ DM_TYPE_OWNED_BODY(IndexBuffer, Buffer)
 		return indexCount;
 	}
 
+	[[nodiscard]] vk::IndexType GetIndexType() const
+	{
+		return indexType;
+	}
+
+	[[nodiscard]] uint32_t GetIndexSize() const
+	{
+		return indexType == vk::IndexType::eUint16 ? sizeof(uint16_t) : sizeof(uint32_t);
+	}
+
 private:
+	void Create(const uint32_t* indices, size_t count, bool dynamic, UploadBatch* batch, Device* owner)
+	{
+		assert(count != 0);
+		indexCount = count;
+		indexType = vk::IndexType::eUint32;
+
+		// 0xFFFF is left free, it restarts primitives when primitive restart is enabled
+		std::vector<uint16_t> narrowed;
+		if (!dynamic && *std::max_element(indices, indices + count) < 0xFFFF)
+		{
+			narrowed.assign(indices, indices + count);
+			indexType = vk::IndexType::eUint16;
+		}
+
+		Buffer::CreateStaged(
+			narrowed.empty() ? (void*) indices : (void*) narrowed.data(), count * GetIndexSize(),
+			vk::BufferUsageFlagBits::eIndexBuffer,
+			VMA_MEMORY_USAGE_GPU_ONLY,
+			!dynamic && batch == nullptr,
+			dynamic,
+			owner);
+		if (batch != nullptr)
+			batch->Stage(*this);
+	}
+
 	uint32_t indexCount = 0;
+	vk::IndexType indexType = vk::IndexType::eUint32;
 };
 
 template <class T, size_t N>
@@ -185,8 +337,88 @@ struct InstancedBuffer : public Buffer
        return reinterpret_cast<T*>(allocationInfo.pMappedData);
     }
 
+    // Bound alongside a mesh, sourcing the shader's i_ prefixed inputs
+    void Bind(vk::CommandBuffer commandBuffer, uint32_t binding = InstanceStream) const
+    {
+        vk::DeviceSize offset = 0;
+        commandBuffer.bindVertexBuffers(binding, 1, &VkType(), &offset);
+    }
+
+    void Bind(CommandRecorder& recorder, uint32_t binding = InstanceStream) const
+    {
+        recorder.BindVertexBuffer(binding, VkType());
+    }
+
     constexpr size_t Count() { return N; }
     constexpr size_t MemorySize() { return sizeof(T) * N; };
 };
 
+/**
+ * Host visible instance data rewritten every frame, grown on demand.
+ * Growing recreates the buffer, so keep one per frame in flight and only
+ * reserve once the GPU has finished with that frame.
+ */
+template <class T>
+class InstanceStreamBuffer : public Buffer
+{
+public:
+    DM_TYPE_OWNED_BODY(InstanceStreamBuffer<T>, Buffer)
+    InstanceStreamBuffer& operator=(InstanceStreamBuffer&& other) noexcept = default;
+    InstanceStreamBuffer(InstanceStreamBuffer&& other) noexcept = default;
+    ~InstanceStreamBuffer() noexcept override = default;
+
+    void Create(size_t inCapacity, Device* owner)
+    {
+        DM_ASSERT(inCapacity != 0);
+        vk::BufferCreateInfo bufferCreateInfo;
+        bufferCreateInfo.usage = vk::BufferUsageFlagBits::eVertexBuffer;
+        bufferCreateInfo.size = sizeof(T) * inCapacity;
+
+        VmaAllocationCreateInfo allocCreateInfo = {};
+        allocCreateInfo.usage = VMA_MEMORY_USAGE_CPU_TO_GPU;
+        allocCreateInfo.flags = VMA_ALLOCATION_CREATE_MAPPED_BIT;
+
+        Buffer::Create(bufferCreateInfo, allocCreateInfo, owner);
+        capacity = inCapacity;
+    }
+
+    // Grows geometrically, discarding the current contents
+    void Reserve(size_t count)
+    {
+        if (count <= capacity)
+            return;
+
+        Device* device = owner;
+        Destroy();
+        Create(std::max(count, capacity * 2), device);
+    }
+
+    T* Data()
+    {
+        return reinterpret_cast<T*>(allocationInfo.pMappedData);
+    }
+
+    // Make the first count elements visible to the device, memory may not be host coherent
+    void Flush(size_t count)
+    {
+        vmaFlushAllocation(owner->allocator, allocation, 0, sizeof(T) * count);
+    }
+
+    void Bind(vk::CommandBuffer commandBuffer, uint32_t binding = InstanceStream) const
+    {
+        vk::DeviceSize offset = 0;
+        commandBuffer.bindVertexBuffers(binding, 1, &VkType(), &offset);
+    }
+
+    void Bind(CommandRecorder& recorder, uint32_t binding = InstanceStream) const
+    {
+        recorder.BindVertexBuffer(binding, VkType());
+    }
+
+    [[nodiscard]] size_t Capacity() const { return capacity; }
+
+private:
+    size_t capacity = 0;
+};
+
 }
\ No newline at end of file
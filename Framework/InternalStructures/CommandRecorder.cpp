@@ -0,0 +1,260 @@
+//------------------------------------------------------------------------------
+//
+// File Name:	CommandRecorder.cpp
+// Author(s):	Jonathan Bourim (j.bourim)
+// Date:        10/19/2026
+//
+//------------------------------------------------------------------------------
+
+#include "CommandRecorder.h"
+
+namespace dm
+{
+
+void CommandRecorder::Begin(vk::CommandBuffer inCommandBuffer)
+{
+    commandBuffer = inCommandBuffer;
+    Invalidate();
+    ResetStats();
+}
+
+void CommandRecorder::Invalidate()
+{
+    pipeline = {};
+    computePipeline = {};
+    graphicsSets = {};
+    computeSets = {};
+    vertexBuffers = {};
+    indexBuffer = {};
+    indexOffset = 0;
+    pushLayout = {};
+    pushStages = {};
+    pushBegin = pushEnd = 0;
+}
+
+CommandRecorder::BindPointState& CommandRecorder::GetBindPointState(vk::PipelineBindPoint bindPoint)
+{
+    DM_ASSERT_MSG(bindPoint == vk::PipelineBindPoint::eGraphics || bindPoint == vk::PipelineBindPoint::eCompute,
+                  "Command recorder only tracks graphics and compute bind points");
+    return bindPoint == vk::PipelineBindPoint::eCompute ? computeSets : graphicsSets;
+}
+
+void CommandRecorder::ForgetLayout(BindPointState& state, vk::PipelineLayout layout)
+{
+    // Layout compatibility isn't known, so sets bound through any other layout may have been disturbed
+    for (SetState& bound : state.bound)
+    {
+        if (!layout || bound.layout != layout)
+            bound = {};
+    }
+}
+
+void CommandRecorder::BindPipeline(vk::Pipeline inPipeline, vk::PipelineLayout layout, vk::PipelineBindPoint bindPoint)
+{
+    DM_ASSERT_MSG(commandBuffer, "Command recorder must begin before recording");
+
+    vk::Pipeline& bound = bindPoint == vk::PipelineBindPoint::eCompute ? computePipeline : pipeline;
+    if (bound == inPipeline)
+    {
+        ++stats.elided;
+        return;
+    }
+
+    commandBuffer.bindPipeline(bindPoint, inPipeline);
+    bound = inPipeline;
+    ++stats.issued;
+
+    ForgetLayout(GetBindPointState(bindPoint), layout);
+    if (!layout || pushLayout != layout)
+    {
+        pushLayout = {};
+        pushBegin = pushEnd = 0;
+    }
+}
+
+void CommandRecorder::BindDescriptorSet(vk::PipelineLayout layout, uint32_t setIndex, vk::DescriptorSet set,
+                                        vk::PipelineBindPoint bindPoint)
+{
+    DM_ASSERT_MSG(setIndex < maxDescriptorSets, "Descriptor set index exceeds the recorder's tracked sets");
+
+    BindPointState& state = GetBindPointState(bindPoint);
+    const uint32_t bit = 1u << setIndex;
+
+    // A pending bind replaced before being flushed is never recorded
+    if (state.pendingMask & bit)
+    {
+        state.pendingMask &= ~bit;
+        ++stats.elided;
+    }
+
+    const SetState& bound = state.bound[setIndex];
+    if (bound.set == set && bound.layout == layout)
+    {
+        ++stats.elided;
+        return;
+    }
+
+    state.pending[setIndex] = { layout, set };
+    state.pendingMask |= bit;
+}
+
+void CommandRecorder::FlushSets(vk::PipelineBindPoint bindPoint)
+{
+    BindPointState& state = GetBindPointState(bindPoint);
+    if (state.pendingMask == 0)
+        return;
+
+    std::array<vk::DescriptorSet, maxDescriptorSets> sets;
+    uint32_t index = 0;
+    while (index < maxDescriptorSets)
+    {
+        if (!(state.pendingMask & (1u << index)))
+        {
+            ++index;
+            continue;
+        }
+
+        // Merge the run of consecutive pending sets sharing a layout
+        const vk::PipelineLayout layout = state.pending[index].layout;
+        const uint32_t first = index;
+        uint32_t count = 0;
+        while (index < maxDescriptorSets
+               && (state.pendingMask & (1u << index))
+               && state.pending[index].layout == layout)
+        {
+            sets[count++] = state.pending[index].set;
+            ++index;
+        }
+
+        commandBuffer.bindDescriptorSets(bindPoint, layout, first, count, sets.data(), 0, nullptr);
+        ++stats.issued;
+        stats.elided += count - 1;
+
+        ForgetLayout(state, layout);
+        for (uint32_t i = first; i < first + count; ++i)
+            state.bound[i] = state.pending[i];
+    }
+
+    state.pendingMask = 0;
+}
+
+void CommandRecorder::Flush()
+{
+    FlushSets(vk::PipelineBindPoint::eGraphics);
+    FlushSets(vk::PipelineBindPoint::eCompute);
+}
+
+void CommandRecorder::BindVertexBuffer(uint32_t binding, vk::Buffer buffer, vk::DeviceSize offset)
+{
+    if (binding < maxVertexBindings)
+    {
+        VertexBufferState& bound = vertexBuffers[binding];
+        if (bound.buffer == buffer && bound.offset == offset)
+        {
+            ++stats.elided;
+            return;
+        }
+        bound = { buffer, offset };
+    }
+
+    commandBuffer.bindVertexBuffers(binding, 1, &buffer, &offset);
+    ++stats.issued;
+}
+
+void CommandRecorder::BindIndexBuffer(vk::Buffer buffer, vk::DeviceSize offset, vk::IndexType inIndexType)
+{
+    if (indexBuffer == buffer && indexOffset == offset && indexType == inIndexType)
+    {
+        ++stats.elided;
+        return;
+    }
+
+    commandBuffer.bindIndexBuffer(buffer, offset, inIndexType);
+    indexBuffer = buffer;
+    indexOffset = offset;
+    indexType = inIndexType;
+    ++stats.issued;
+}
+
+void CommandRecorder::PushConstants(vk::PipelineLayout layout, vk::ShaderStageFlags stageFlags,
+                                    uint32_t offset, uint32_t size, const void* values)
+{
+    const uint32_t end = offset + size;
+    const bool shadowed = end <= maxPushConstantSize;
+    if (shadowed && layout == pushLayout && stageFlags == pushStages
+        && offset >= pushBegin && end <= pushEnd
+        && std::memcmp(pushShadow.data() + offset, values, size) == 0)
+    {
+        ++stats.elided;
+        return;
+    }
+
+    commandBuffer.pushConstants(layout, stageFlags, offset, size, values);
+    ++stats.issued;
+
+    if (!shadowed)
+    {
+        pushLayout = {};
+        pushBegin = pushEnd = 0;
+        return;
+    }
+
+    // Extend the known range when this push touches it, otherwise restart it from this push
+    const bool extends = layout == pushLayout && stageFlags == pushStages
+                         && offset <= pushEnd && end >= pushBegin && pushBegin != pushEnd;
+    pushBegin = extends ? std::min(pushBegin, offset) : offset;
+    pushEnd = extends ? std::max(pushEnd, end) : end;
+    pushLayout = layout;
+    pushStages = stageFlags;
+    std::memcpy(pushShadow.data() + offset, values, size);
+}
+
+void CommandRecorder::Draw(uint32_t vertexCount, uint32_t instanceCount, uint32_t firstVertex, uint32_t firstInstance)
+{
+    FlushSets(vk::PipelineBindPoint::eGraphics);
+    commandBuffer.draw(vertexCount, instanceCount, firstVertex, firstInstance);
+    ++stats.issued;
+}
+
+void CommandRecorder::DrawIndexed(uint32_t indexCount, uint32_t instanceCount, uint32_t firstIndex,
+                                  int32_t vertexOffset, uint32_t firstInstance)
+{
+    FlushSets(vk::PipelineBindPoint::eGraphics);
+    commandBuffer.drawIndexed(indexCount, instanceCount, firstIndex, vertexOffset, firstInstance);
+    ++stats.issued;
+}
+
+void CommandRecorder::DrawIndexedIndirect(vk::Buffer buffer, vk::DeviceSize offset, uint32_t drawCount, uint32_t stride)
+{
+    FlushSets(vk::PipelineBindPoint::eGraphics);
+    commandBuffer.drawIndexedIndirect(buffer, offset, drawCount, stride);
+    ++stats.issued;
+}
+
+void CommandRecorder::DrawIndexedIndirectCount(vk::Buffer buffer, vk::DeviceSize offset, vk::Buffer countBuffer,
+                                               vk::DeviceSize countOffset, uint32_t maxDrawCount, uint32_t stride)
+{
+    FlushSets(vk::PipelineBindPoint::eGraphics);
+    commandBuffer.drawIndexedIndirectCountKHR(buffer, offset, countBuffer, countOffset, maxDrawCount, stride);
+    ++stats.issued;
+}
+
+void CommandRecorder::Dispatch(uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ)
+{
+    FlushSets(vk::PipelineBindPoint::eCompute);
+    commandBuffer.dispatch(groupCountX, groupCountY, groupCountZ);
+    ++stats.issued;
+}
+
+void CommandRecorder::DrawMeshTasks(uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ)
+{
+#ifdef VK_EXT_mesh_shader
+    FlushSets(vk::PipelineBindPoint::eGraphics);
+    commandBuffer.drawMeshTasksEXT(groupCountX, groupCountY, groupCountZ);
+    ++stats.issued;
+#else
+    DM_ASSERT_MSG(false, "Mesh shaders require Vulkan headers with VK_EXT_mesh_shader");
+#endif
+}
+
+}
@@ -0,0 +1,136 @@
+//------------------------------------------------------------------------------
+//
+// File Name:	CommandRecorder.h
+// Author(s):	Jonathan Bourim (j.bourim)
+// Date:        10/19/2026
+//
+//------------------------------------------------------------------------------
+#pragma once
+
+namespace dm
+{
+
+/**
+ * Records into a command buffer while tracking the bound pipeline, descriptor sets,
+ * vertex and index buffers and push constant contents, dropping calls that wouldn't change them.
+ * Descriptor set binds are deferred until the next draw or dispatch, where consecutive set
+ * indices sharing a layout are bound with a single call.
+ */
+class CommandRecorder
+{
+public:
+    static constexpr uint32_t maxDescriptorSets = 8;        //< Highest tracked set index + 1
+    static constexpr uint32_t maxVertexBindings = 16;       //< Guaranteed minimum of maxVertexInputBindings
+    static constexpr uint32_t maxPushConstantSize = 256;    //< Bytes shadowed, larger pushes are always issued
+
+    struct Stats
+    {
+        uint32_t issued = 0;    //< Commands recorded into the command buffer
+        uint32_t elided = 0;    //< Calls dropped as redundant, merged set binds count each set past the first
+    };
+
+    CommandRecorder() = default;
+    explicit CommandRecorder(vk::CommandBuffer inCommandBuffer) { Begin(inCommandBuffer); }
+
+    /// \brief Start tracking a command buffer, all state is assumed unbound and stats are reset.
+    ///        Call after the command buffer (or a render pass without inherited state) begins.
+    void Begin(vk::CommandBuffer inCommandBuffer);
+
+    /// \brief Forget all tracked state, for use after commands recorded around the recorder
+    void Invalidate();
+
+    /// \brief Bind a pipeline.
+    /// \param layout Layout the pipeline was created with, keeps tracked sets and push constants
+    ///        bound through the same layout. When null, all descriptor and push constant state is forgotten.
+    void BindPipeline(vk::Pipeline pipeline, vk::PipelineLayout layout = {},
+                      vk::PipelineBindPoint bindPoint = vk::PipelineBindPoint::eGraphics);
+
+    /// \brief Bind a descriptor set, deferred until the next draw or dispatch
+    void BindDescriptorSet(vk::PipelineLayout layout, uint32_t setIndex, vk::DescriptorSet set,
+                           vk::PipelineBindPoint bindPoint = vk::PipelineBindPoint::eGraphics);
+
+    void BindVertexBuffer(uint32_t binding, vk::Buffer buffer, vk::DeviceSize offset = 0);
+    void BindIndexBuffer(vk::Buffer buffer, vk::DeviceSize offset, vk::IndexType indexType);
+
+    void PushConstants(vk::PipelineLayout layout, vk::ShaderStageFlags stageFlags,
+                       uint32_t offset, uint32_t size, const void* values);
+
+    void Draw(uint32_t vertexCount, uint32_t instanceCount, uint32_t firstVertex, uint32_t firstInstance);
+    void DrawIndexed(uint32_t indexCount, uint32_t instanceCount, uint32_t firstIndex,
+                     int32_t vertexOffset, uint32_t firstInstance);
+    void DrawIndexedIndirect(vk::Buffer buffer, vk::DeviceSize offset, uint32_t drawCount, uint32_t stride);
+    /// \brief Requires VK_KHR_draw_indirect_count, see PhysicalDevice::drawIndirectCount
+    void DrawIndexedIndirectCount(vk::Buffer buffer, vk::DeviceSize offset, vk::Buffer countBuffer,
+                                  vk::DeviceSize countOffset, uint32_t maxDrawCount, uint32_t stride);
+    void Dispatch(uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ);
+    /// \brief Requires VK_EXT_mesh_shader, see PhysicalDevice::meshShader
+    void DrawMeshTasks(uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ);
+
+    /// \brief Record any deferred descriptor set binds, call before recording directly into the command buffer
+    void Flush();
+
+    /// \brief Command buffer being recorded, commands recorded into it directly aren't tracked
+    [[nodiscard]] vk::CommandBuffer GetCommandBuffer() const { return commandBuffer; }
+    [[nodiscard]] vk::Pipeline GetBoundPipeline() const { return pipeline; }
+    [[nodiscard]] const Stats& GetStats() const { return stats; }
+    void ResetStats() { stats = {}; }
+
+private:
+    struct SetState
+    {
+        vk::PipelineLayout layout = {};
+        vk::DescriptorSet set = {};
+    };
+
+    struct BindPointState
+    {
+        std::array<SetState, maxDescriptorSets> bound = {};     //< Sets known to be bound on the command buffer
+        std::array<SetState, maxDescriptorSets> pending = {};   //< Sets requested since the last flush
+        uint32_t pendingMask = 0;
+    };
+
+    struct VertexBufferState
+    {
+        vk::Buffer buffer = {};
+        vk::DeviceSize offset = 0;
+    };
+
+    BindPointState& GetBindPointState(vk::PipelineBindPoint bindPoint);
+    void FlushSets(vk::PipelineBindPoint bindPoint);
+    void ForgetLayout(BindPointState& state, vk::PipelineLayout layout);
+
+    vk::CommandBuffer commandBuffer = {};
+    vk::Pipeline pipeline = {};
+    vk::Pipeline computePipeline = {};
+    BindPointState graphicsSets;
+    BindPointState computeSets;
+
+    std::array<VertexBufferState, maxVertexBindings> vertexBuffers = {};
+    vk::Buffer indexBuffer = {};
+    vk::DeviceSize indexOffset = 0;
+    vk::IndexType indexType = vk::IndexType::eUint32;
+
+    vk::PipelineLayout pushLayout = {};
+    vk::ShaderStageFlags pushStages = {};
+    uint32_t pushBegin = 0;             //< Byte range of the shadow known to match the command buffer
+    uint32_t pushEnd = 0;
+    std::array<char, maxPushConstantSize> pushShadow = {};
+
+    Stats stats;
+};
+
+// Stage flags must cover every stage of the layout's push constant range, see IGraphicsPipeline::pushConstantRange
+inline void PushIdentityModel(
+    CommandRecorder& recorder,
+    vk::PipelineLayout pipelineLayout,
+    vk::ShaderStageFlags stageFlags = vk::ShaderStageFlagBits::eVertex
+)
+{
+    recorder.PushConstants(
+        pipelineLayout,
+        stageFlags,
+        0, sizeof(glm::mat4), &identityMatrix
+    );
+}
+
+}
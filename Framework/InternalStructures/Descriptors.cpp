@@ -10,6 +10,13 @@
 namespace dm
 {
 
+void DescriptorSetLayout::Create(const vk::DescriptorSetLayoutCreateInfo& createInfo, Device* inOwner)
+{
+    IOwned<Device>::CreateOwned(inOwner);
+    DM_ASSERT_VK(owner->createDescriptorSetLayout(&createInfo, nullptr, &VkType()));
+    owner->PipelineLibrary().RecordSetLayout(VkType(), createInfo);
+}
+
 void Descriptors::RecreateGlobalSet()
 {
     if (globalSet == nullptr)
@@ -116,6 +123,7 @@ void Descriptors::PipelineDescriptors::SetData::WriteSets(Device* device)
     for (int img = 0; img < imageCount; ++img)
     {
         SetBindingsDirty(false, img);
+        ++versions[img];
     }
 
     // Update the memory on the GPU
@@ -20,7 +20,13 @@ class DescriptorPool : public IVulkanType<vk::DescriptorPool>, public IOwned<Dev
 class DescriptorSetLayout : public IVulkanType<vk::DescriptorSetLayout>, public IOwned<Device>
 {
 	DM_TYPE_VULKAN_OWNED_BODY(DescriptorSetLayout, IOwned<Device>)
-	DM_TYPE_VULKAN_OWNED_GENERIC(DescriptorSetLayout, DescriptorSetLayout)
+	DescriptorSetLayout(DescriptorSetLayout&& other) noexcept = default;
+	DescriptorSetLayout& operator=(DescriptorSetLayout&& other) noexcept = default;
+
+	/// \brief Also records the layout's contents with the pipeline library, see PipelineLibrary::RecordSetLayout
+	void Create(const vk::DescriptorSetLayoutCreateInfo& createInfo, Device* inOwner);
+	void Destroy() { if (created) { owner->destroyDescriptorSetLayout(VkType()); created = false; } }
+	~DescriptorSetLayout() noexcept { Destroy(); }
 };
 
 enum DescriptorSetIndex : int
@@ -35,6 +41,8 @@ enum DescriptorSetIndex : int
     Count
 };
 
+static_assert(DescriptorSetIndex::Count <= CommandRecorder::maxDescriptorSets, "Command recorder must track every descriptor set index");
+
 enum GlobalDescriptors : int
 {
     ViewProjection = 0,
@@ -418,6 +426,7 @@ public:
                             DescriptorSetIndex setIndex)
             {
                 sets.resize(device->ImageCount());
+                versions.resize(device->ImageCount(), 0);
 
                 // Sets equal to max number of the class
                 int setCount = GetSetMax(setIndex);
@@ -490,6 +499,9 @@ public:
             // Descriptor sets per set per pipeline (memory mappings)
             ImageAsync<std::vector<vk::DescriptorSet>> sets;
 
+            // Incremented whenever any of an image's sets are written, invalidating recordings that bind them
+            ImageAsync<uint64_t> versions;
+
             // IDs returned to uniforms requested access to the pre-allocated set buffer above
             std::stack<int> freeIDs;
 
@@ -529,6 +541,10 @@ public:
 
         std::array<SetData, DescriptorSetIndex::Count> setData;
         std::vector<vk::VertexInputAttributeDescription> vertexDescriptions;
+        std::vector<vk::VertexInputBindingDescription> vertexBindings;     //< One per input rate present in the vertex shader, plus AttributeStream for split layouts
+        std::vector<VertexInputData> vertexInputs;
+        std::vector<SpecializationConstantData> specializationConstants;
+        PushConstantBlockData pushConstants;
     };
 
     void BindGlobalSet(int imageIndex, vk::CommandBuffer commandBuffer, vk::PipelineLayout pipelineLayout);
@@ -722,6 +738,30 @@ public:
         return pipelineDescriptors[ti].vertexDescriptions;
     }
 
+    template <class Pipeline>
+    std::vector<vk::VertexInputBindingDescription>& GetVertexBindingDescriptions()
+    {
+        std::type_index ti = typeid(Pipeline);
+        DM_ASSERT_MSG( PipelineExists<Pipeline>() &&
+                      !pipelineDescriptors[ti].vertexBindings.empty(),
+                      "Attempting to get non-existent vertex input binding description");
+
+        return pipelineDescriptors[ti].vertexBindings;
+    }
+
+    // Points into the pipeline's reflected descriptions, valid for as long as the pipeline's data is
+    template <class Pipeline>
+    vk::PipelineVertexInputStateCreateInfo GetVertexInputState()
+    {
+        auto& pipeline = GetPipelineDescriptors<Pipeline>();
+        vk::PipelineVertexInputStateCreateInfo vertexInputState = {};
+        vertexInputState.vertexBindingDescriptionCount = static_cast<uint32_t>(pipeline.vertexBindings.size());
+        vertexInputState.pVertexBindingDescriptions = pipeline.vertexBindings.data();
+        vertexInputState.vertexAttributeDescriptionCount = static_cast<uint32_t>(pipeline.vertexDescriptions.size());
+        vertexInputState.pVertexAttributeDescriptions = pipeline.vertexDescriptions.data();
+        return vertexInputState;
+    }
+
     template <class Pipeline>
     DescriptorSetLayout* GetLayout(DescriptorSetIndex set)
     {
@@ -816,6 +856,17 @@ public:
         );
     }
 
+    // Deferred by the recorder, merged with neighbouring set binds at the next draw
+    void Bind(
+        int imageIndex,
+        CommandRecorder& recorder,
+        vk::PipelineLayout pipelineLayout)
+    {
+        DM_ASSERT_MSG(descriptorID != -1, "Uniforms not initialized correctly");
+
+        recorder.BindDescriptorSet(pipelineLayout, SetIndex, *setData->GetSet(imageIndex, descriptorID));
+    }
+
     [[nodiscard]] DescriptorBinding& GetBinding(uint32_t index) const
     {
         auto it = std::find_if(bindingReferences.begin(), bindingReferences.end(),
@@ -904,6 +955,30 @@ public:
             writeSets.size(), writeSets.data(),
             0, nullptr
         );
+        ++setData->versions[imageIndex];
+    }
+
+    [[nodiscard]] vk::DescriptorSet GetSet(int imageIndex) const
+    {
+        return *setData->GetSet(imageIndex, descriptorID);
+    }
+
+    // Changes whenever a set of this image's pipeline set index is written, see RecordCache
+    [[nodiscard]] uint64_t GetVersion(int imageIndex) const
+    {
+        return setData->versions[imageIndex];
+    }
+
+    // Uniform buffer data set since its last upload, uploads are recorded through UploadUniforms
+    [[nodiscard]] bool HasPendingUpload(int imageIndex) const
+    {
+        for (const BindingReference& bindingRef : bindingReferences)
+        {
+            if (bindingRef.binding.GetType() == vk::DescriptorType::eUniformBuffer &&
+                bindingRef.binding.template Get<UniformBuffer>().buffers[imageIndex].dirty)
+                return true;
+        }
+        return false;
     }
 
     void SetDirtyBindings(bool dirty)
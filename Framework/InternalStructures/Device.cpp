@@ -33,6 +33,7 @@ void Device::Create(const vk::DeviceCreateInfo& createInfo, PhysicalDevice* inOw
 {
     IOwned::CreateOwned(inOwner);
 	DM_ASSERT_VK(owner->createDevice(&createInfo, nullptr, &VkType()));
+	VULKAN_HPP_DEFAULT_DISPATCHER.init(VkType());
 	const QueueFamilyIndices& indices = owner->GetQueueFamilyIndices();
 	getQueue(indices.graphics.value(), 0, &graphicsQueue);
 	getQueue(indices.present.value(), 0, &presentQueue);
@@ -59,6 +60,21 @@ DescriptorPool& Device::DescriptorPool()
     return OwnerGet<Renderer>().descriptorPool;
 }
 
+PipelineLibrary& Device::PipelineLibrary()
+{
+    return OwnerGet<Renderer>().pipelineLibrary;
+}
+
+GeometryPool& Device::GeometryPool()
+{
+    return OwnerGet<Renderer>().geometryPool;
+}
+
+AssetLoader& Device::AssetLoader()
+{
+    return OwnerGet<Renderer>().assetLoader;
+}
+
 int Device::ImageIndex() const
 {
     return OwnerGet<Renderer>().imageIndex;
@@ -11,6 +11,9 @@ namespace dm
 class Swapchain;
 class Descriptors;
 class DescriptorPool;
+class PipelineLibrary;
+class GeometryPool;
+class AssetLoader;
 
 class Device : public IVulkanType<vk::Device>, public IOwned<PhysicalDevice>
 {
@@ -27,6 +30,9 @@ DM_TYPE_VULKAN_OWNED_BODY(Device, IOwned<PhysicalDevice>)
     [[nodiscard]] Swapchain& Swapchain();
     [[nodiscard]] Descriptors& Descriptors();
     [[nodiscard]] DescriptorPool& DescriptorPool();
+    [[nodiscard]] PipelineLibrary& PipelineLibrary();
+    [[nodiscard]] GeometryPool& GeometryPool();
+    [[nodiscard]] AssetLoader& AssetLoader();
     [[nodiscard]] int ImageIndex() const;
 
     // Kept freeing behavior for descriptor sets, if we need it in the future
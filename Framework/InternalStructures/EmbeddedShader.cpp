@@ -0,0 +1,49 @@
+//------------------------------------------------------------------------------
+//
+// File Name:	EmbeddedShader.cpp
+// Author(s):	Jonathan Bourim (j.bourim)
+// Date:		10/19/2026
+//
+//------------------------------------------------------------------------------
+#include "EmbeddedShader.h"
+
+namespace dm
+{
+
+std::unordered_map<std::string, EmbeddedShader>& EmbeddedShaders::Registry()
+{
+    // Function local, registrars run during static initialization in any order
+    static std::unordered_map<std::string, EmbeddedShader> registry;
+    return registry;
+}
+
+std::string EmbeddedShaders::NormalizePath(std::string_view path)
+{
+    std::string normalized(path);
+    std::replace(normalized.begin(), normalized.end(), '\\', '/');
+    while (normalized.compare(0, 2, "./") == 0)
+        normalized.erase(0, 2);
+
+    return normalized;
+}
+
+void EmbeddedShaders::Register(const EmbeddedShader& shader)
+{
+    DM_ASSERT_MSG(shader.wordCount > 0 && shader.code[0] == SpvMagicNumber,
+                  ("Embedded shader " + std::string(shader.path) + " isn't valid SPIR-V").c_str());
+
+    auto [it, inserted] = Registry().try_emplace(NormalizePath(shader.path), shader);
+    DM_ASSERT_MSG(inserted, ("Shader " + std::string(shader.path) + " is embedded more than once").c_str());
+}
+
+const EmbeddedShader* EmbeddedShaders::Find(std::string_view path)
+{
+    auto& registry = Registry();
+    if (registry.empty())
+        return nullptr;
+
+    auto it = registry.find(NormalizePath(path));
+    return it != registry.end() ? &it->second : nullptr;
+}
+
+}
@@ -0,0 +1,51 @@
+//------------------------------------------------------------------------------
+//
+// File Name:	EmbeddedShader.h
+// Author(s):	Jonathan Bourim (j.bourim)
+// Date:        10/19/2026
+//
+//------------------------------------------------------------------------------
+#pragma once
+
+namespace dm
+{
+
+/**
+ * SPIR-V compiled into the binary through damascus_embed_shaders, or a view of a loaded file.
+ * Embedded shaders are registered under the path they'd otherwise be loaded from.
+ * Apart from the stage, nothing is reflected ahead of time, ReadShader reflects the code at load.
+ */
+struct EmbeddedShader
+{
+    std::string_view path;
+    const uint32_t* code = nullptr;
+    size_t wordCount = 0;
+    vk::ShaderStageFlags stage = {};    //< Stage known from the source extension at build time, empty if unknown
+
+    [[nodiscard]] size_t Size() const { return wordCount * sizeof(uint32_t); }
+};
+
+class EmbeddedShaders
+{
+public:
+    static void Register(const EmbeddedShader& shader);
+
+    /// \brief Finds the shader embedded under path, separators are normalized to /
+    /// \return Embedded shader, nullptr if none was embedded under path
+    [[nodiscard]] static const EmbeddedShader* Find(std::string_view path);
+
+private:
+    static std::string NormalizePath(std::string_view path);
+    static std::unordered_map<std::string, EmbeddedShader>& Registry();
+};
+
+// Registers a shader during static initialization, used by the generated EmbeddedShaders.inl
+struct EmbeddedShaderRegistrar
+{
+    EmbeddedShaderRegistrar(const char* path, const uint32_t* code, size_t wordCount, vk::ShaderStageFlags stage)
+    {
+        EmbeddedShaders::Register({ path, code, wordCount, stage });
+    }
+};
+
+}
@@ -33,6 +33,21 @@ void Image::Create2D(
 	vk::ImageAspectFlags aspectMask,
 	Device* owner
 )
+{
+	Create2D(size, format, mipLevels, tiling, usage, dstLayout, aspectMask, vk::CommandBuffer(), owner);
+}
+
+void Image::Create2D(
+	glm::uvec2 size,
+	vk::Format format,
+	uint32_t mipLevels,
+	vk::ImageTiling tiling,
+	vk::ImageUsageFlags usage,
+	vk::ImageLayout dstLayout,
+	vk::ImageAspectFlags aspectMask,
+	vk::CommandBuffer commandBuffer,
+	Device* owner
+)
 {
 	vk::ImageCreateInfo imageCreateInfo = {};
 
@@ -62,7 +77,10 @@ void Image::Create2D(
 
 	Create(imageCreateInfo, allocInfo, owner);
 
-	TransitionLayout(vk::ImageLayout::eUndefined, dstLayout, aspectMask, mipLevels);
+	if (commandBuffer)
+		TransitionLayout(commandBuffer, vk::ImageLayout::eUndefined, dstLayout, aspectMask, mipLevels);
+	else
+		TransitionLayout(vk::ImageLayout::eUndefined, dstLayout, aspectMask, mipLevels);
 }
 
 void Image::CreateDepthImage(glm::vec2 size, Device* owner)
@@ -200,9 +218,11 @@ void Image::TransitionLayout(
 		// Scenario: transfer destination -> shader resource
 	else if (oldLayout == vk::ImageLayout::eTransferDstOptimal && newLayout == vk::ImageLayout::eShaderReadOnlyOptimal)
 	{
+		// Copies recorded in the same command buffer must land before shaders sample the image
+		barrier.srcAccessMask = vk::AccessFlagBits::eTransferWrite;
 		barrier.dstAccessMask = vk::AccessFlagBits::eShaderRead | vk::AccessFlagBits::eShaderWrite;
 
-		srcFlags = vk::PipelineStageFlagBits::eTopOfPipe;
+		srcFlags = vk::PipelineStageFlagBits::eTransfer;
 		dstFlags = vk::PipelineStageFlagBits::eFragmentShader;
 	}
 		// Unhandled layout transition
@@ -36,6 +36,19 @@ public:
 		Device* owner
 	);
 
+	// Transition recorded into commandBuffer rather than submitted and waited on
+	void Create2D(
+		glm::uvec2 size,
+		vk::Format format,
+		uint32_t mipLevels,
+		vk::ImageTiling tiling,
+		vk::ImageUsageFlags usage,
+		vk::ImageLayout dstLayout,
+		vk::ImageAspectFlags aspectMask,
+		vk::CommandBuffer commandBuffer,
+		Device* owner
+	);
+
 	void CreateDepthImage(glm::vec2 size, Device* owner);
 
 	void TransitionLayout(
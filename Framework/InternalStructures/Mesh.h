@@ -17,8 +17,7 @@ struct hash<dm::Vertex>
 {
 	size_t operator()(dm::Vertex const& vertex) const
 	{
-		return ((hash<glm::vec3>()(vertex.pos) ^ (hash<glm::vec3>()(vertex.color) << 1)) >> 1) ^
-			   (hash<glm::vec2>()(vertex.texPos) << 1);
+		return static_cast<size_t>(dm::HashVertex(vertex));
 	}
 };
 }
@@ -26,6 +25,13 @@ struct hash<dm::Vertex>
 namespace dm
 {
 
+// Index range of one detail level, LODs of a mesh share its vertices, see GenerateLods
+struct LodRange
+{
+	uint32_t firstIndex = 0;	//< Relative to the mesh's first index
+	uint32_t indexCount = 0;
+	float error = 0.0f;			//< Deviation from the full detail surface, in mesh units
+};
 
 template<class VertexType = Vertex>
 class Mesh : public IOwned<Device>
@@ -63,7 +69,7 @@ public:
         IOwned<Device>::CreateOwned(inOwner);
 		vertexBuffer.Create(vertices, dynamic, owner);
 		indexBuffer.Create(indices, dynamic, owner);
-        sortKey = MeshSortKey<Mesh<VertexType>>::GetUnique();
+        AssignSortKey();
 	}
 
 	void Create(
@@ -74,9 +80,67 @@ public:
 	{
         IOwned<Device>::CreateOwned(inOwner);
 		vertexBuffer.Create(vertices, dynamic, owner);
-        sortKey = MeshSortKey<Mesh<VertexType>>::GetUnique();
+        AssignSortKey();
     }
 
+	// Static geometry suballocated from a shared pool, drawn at its offsets in the pool's buffers
+	void Create(
+		const std::vector<VertexType>& vertices,
+		const std::vector<uint32_t>& indices,
+		GeometryPool& pool
+	)
+	{
+		IOwned<Device>::CreateOwned(pool.owner);
+		geometry = GeometryHandle(&pool, pool.Allocate(vertices, indices));
+		AssignSortKey();
+	}
+
+	// Geometry read in place, such as a memory mapped MeshCache
+	void Create(const View& view, Device* inOwner, bool dynamic = false)
+	{
+		IOwned<Device>::CreateOwned(inOwner);
+		vertexBuffer.Create(view.vertices, view.vertexCount, dynamic, owner);
+		if (view.indexCount > 0)
+			indexBuffer.Create(view.indices, view.indexCount, dynamic, owner);
+		AssignSortKey();
+	}
+
+	// Static geometry copied by batch without waiting on the GPU, drawable once the batch completes
+	void Create(const View& view, UploadBatch& batch)
+	{
+		IOwned<Device>::CreateOwned(batch.owner);
+		vertexBuffer.Create(view.vertices, view.vertexCount, batch, owner);
+		if (view.indexCount > 0)
+			indexBuffer.Create(view.indices, view.indexCount, batch, owner);
+		AssignSortKey();
+	}
+
+	void Create(const View& view, GeometryPool& pool)
+	{
+		IOwned<Device>::CreateOwned(pool.owner);
+		geometry = GeometryHandle(&pool, pool.Allocate(view.vertices, view.vertexCount, view.indices, view.indexCount));
+		AssignSortKey();
+	}
+
+	// Static geometry with deinterleaved positions, drawn by pipelines reading SplitVertex<VertexType>
+	void CreateSplit(const View& view, Device* inOwner)
+	{
+		IOwned<Device>::CreateOwned(inOwner);
+		splitVertices.Create(view.vertices, view.vertexCount, owner);
+		if (view.indexCount > 0)
+			indexBuffer.Create(view.indices, view.indexCount, false, owner);
+		AssignSortKey();
+	}
+
+	void CreateSplit(
+		const std::vector<VertexType>& vertices,
+		const std::vector<uint32_t>& indices,
+		Device* inOwner
+	)
+	{
+		CreateSplit({ vertices.data(), (uint32_t) vertices.size(), indices.data(), (uint32_t) indices.size() }, inOwner);
+	}
+
 	Mesh& operator=(const Mesh& other) noexcept = delete;
 	Mesh(const Mesh& other) noexcept = delete;
 
@@ -90,7 +154,7 @@ public:
 	)
 	{
 		vertexBuffer.UpdateData(vertices.data(), vertices.size() * sizeof(VertexType), vertices.size(), false);
-		indexBuffer.UpdateData(vertices.data(), vertices.size() * sizeof(uint32_t), indices.size(), false);
+		indexBuffer.UpdateData(indices.data(), indices.size() * sizeof(uint32_t), indices.size(), false);
 	}
 
 	void UpdateDynamic(std::vector<VertexType>& vertices)
@@ -124,12 +188,21 @@ public:
 		return std::move(data);
 	}
 
+	// Widened to 32 bits whatever the buffer's index type
 	[[nodiscard]] std::vector<uint32_t> GetIndexBufferDataCopy() const
 	{
 		std::vector<uint32_t> data;
-		const auto* buffer = reinterpret_cast<const char*>(indexBuffer.GetMappedData());
+		const void* buffer = indexBuffer.GetMappedData();
 		data.resize(GetIndexCount());
-		memcpy(data.data(), buffer, sizeof(uint32_t) * GetIndexCount());
+		if (GetIndexType() == vk::IndexType::eUint16)
+		{
+			const auto* narrow = reinterpret_cast<const uint16_t*>(buffer);
+			std::copy(narrow, narrow + GetIndexCount(), data.begin());
+		}
+		else
+		{
+			memcpy(data.data(), buffer, sizeof(uint32_t) * GetIndexCount());
+		}
 		return std::move(data);
 	}
 
@@ -143,8 +216,10 @@ public:
 		return reinterpret_cast<VertexType*>(vertexBuffer.GetMappedData());
 	}
 
+	// Mapped indices are only kept by dynamic meshes, which are always 32 bit
 	uint32_t* GetIndexBufferData()
 	{
+		DM_ASSERT_MSG(GetIndexType() == vk::IndexType::eUint32, "16 bit indices can't be viewed as 32 bit");
 		return reinterpret_cast<uint32_t*>(indexBuffer.GetMappedData());
 	}
 
@@ -155,6 +230,7 @@ public:
 
 	[[nodiscard]] const uint32_t* GetIndexBufferData() const
 	{
+		DM_ASSERT_MSG(GetIndexType() == vk::IndexType::eUint32, "16 bit indices can't be viewed as 32 bit");
 		return reinterpret_cast<const uint32_t*>(indexBuffer.GetMappedData());
 	}
 
@@ -175,7 +251,9 @@ public:
 		}
 	}
 
-	static Mesh::Data LoadModel(const std::string& path);
+	/// \brief Load an OBJ file, deduplicating its vertices
+	/// \param pool Optional thread pool, corners are deduplicated in parallel with identical output
+	static Mesh::Data LoadModel(const std::string& path, ThreadPool* pool = nullptr);
 
 	void CreateModel(const std::string& path, bool dynamic, Device* owner)
 	{
@@ -185,21 +263,91 @@ public:
 	void Bind(vk::CommandBuffer commandBuffer) const
 	{
 		vk::DeviceSize offset = 0;
-		commandBuffer.bindVertexBuffers(0, 1, &vertexBuffer.VkType(), &offset);
+		vk::Buffer vertices = GetVertexBufferHandle();
+		commandBuffer.bindVertexBuffers(VertexStream, 1, &vertices, &offset);
+		if (vk::Buffer attributes = GetAttributeBufferHandle())
+		{
+			commandBuffer.bindVertexBuffers(AttributeStream, 1, &attributes, &offset);
+		}
 		bool hasIndex = GetIndexCount() > 0;
 		if (hasIndex)
 		{
-			commandBuffer.bindIndexBuffer(GetIndexBuffer().VkType(), 0, vk::IndexType::eUint32);
+			commandBuffer.bindIndexBuffer(GetIndexBufferHandle(), 0, GetIndexType());
+		}
+	}
+
+	// Pooled meshes of the same vertex type share their binds, letting the recorder elide them
+	void Bind(CommandRecorder& recorder) const
+	{
+		recorder.BindVertexBuffer(VertexStream, GetVertexBufferHandle());
+		if (vk::Buffer attributes = GetAttributeBufferHandle())
+		{
+			recorder.BindVertexBuffer(AttributeStream, attributes);
+		}
+		if (GetIndexCount() > 0)
+		{
+			recorder.BindIndexBuffer(GetIndexBufferHandle(), 0, GetIndexType());
 		}
 	}
 
-	void Draw(vk::CommandBuffer commandBuffer) const
+	void Draw(vk::CommandBuffer commandBuffer, uint32_t lod = 0) const
+	{
+		DrawInstanced(commandBuffer, 1, 0, lod);
+	}
+
+	void Draw(CommandRecorder& recorder, uint32_t lod = 0) const
+	{
+		DrawInstanced(recorder, 1, 0, lod);
+	}
+
+	// Instance data is expected to already be bound to InstanceStream
+	void DrawInstanced(vk::CommandBuffer commandBuffer, uint32_t instanceCount, uint32_t firstInstance = 0, uint32_t lod = 0) const
 	{
 		bool hasIndex = GetIndexCount() > 0;
 		hasIndex ?
-		commandBuffer.drawIndexed(GetIndexCount(), 1, 0, 0, 0)
+		commandBuffer.drawIndexed(GetLodIndexCount(lod), instanceCount, GetLodFirstIndex(lod), (int32_t) GetVertexOffset(), firstInstance)
 				 :
-		commandBuffer.draw(GetVertexCount(), 1, 0, 0);
+		commandBuffer.draw(GetVertexCount(), instanceCount, GetVertexOffset(), firstInstance);
+	}
+
+	void DrawInstanced(CommandRecorder& recorder, uint32_t instanceCount, uint32_t firstInstance = 0, uint32_t lod = 0) const
+	{
+		bool hasIndex = GetIndexCount() > 0;
+		hasIndex ?
+		recorder.DrawIndexed(GetLodIndexCount(lod), instanceCount, GetLodFirstIndex(lod), (int32_t) GetVertexOffset(), firstInstance)
+				 :
+		recorder.Draw(GetVertexCount(), instanceCount, GetVertexOffset(), firstInstance);
+	}
+
+	// Ranges of a LOD chain appended to the mesh's indices, LOD 0 draws every index without one
+	void SetLods(std::vector<LodRange> inLods)
+	{
+		DM_ASSERT_MSG(inLods.empty() || inLods.back().firstIndex + inLods.back().indexCount <= GetIndexCount(),
+					  "LOD ranges exceed the mesh's indices");
+		lods = std::move(inLods);
+	}
+
+	[[nodiscard]] const std::vector<LodRange>& GetLods() const
+	{
+		return lods;
+	}
+
+	[[nodiscard]] uint32_t GetLodCount() const
+	{
+		return lods.empty() ? 1 : (uint32_t) lods.size();
+	}
+
+	[[nodiscard]] uint32_t GetLodIndexCount(uint32_t lod) const
+	{
+		DM_ASSERT_MSG(lod < GetLodCount(), "LOD out of range");
+		return lods.empty() ? GetIndexCount() : lods[lod].indexCount;
+	}
+
+	// Includes the mesh's first index, for drawing from the bound index buffer
+	[[nodiscard]] uint32_t GetLodFirstIndex(uint32_t lod) const
+	{
+		DM_ASSERT_MSG(lod < GetLodCount(), "LOD out of range");
+		return GetFirstIndex() + (lods.empty() ? 0 : lods[lod].firstIndex);
 	}
 
 	void SetModel(const glm::mat4& model)
@@ -207,9 +355,56 @@ public:
 		this->model = model;
 	}
 
+	// Indices of every LOD
 	[[nodiscard]] uint32_t GetIndexCount() const
 	{
-		return indexBuffer.GetIndexCount();
+		return geometry ? geometry.Get().indexCount : indexBuffer.GetIndexCount();
+	}
+
+	[[nodiscard]] bool IsPooled() const
+	{
+		return (bool) geometry;
+	}
+
+	[[nodiscard]] bool IsSplit() const
+	{
+		return splitVertices.GetVertexCount() > 0;
+	}
+
+	// Offsets into the bound buffers, non-zero only for pooled meshes
+	[[nodiscard]] uint32_t GetVertexOffset() const
+	{
+		return geometry ? geometry.Get().vertexOffset : 0;
+	}
+
+	[[nodiscard]] uint32_t GetFirstIndex() const
+	{
+		return geometry ? geometry.Get().firstIndex : 0;
+	}
+
+	// Position stream of split meshes
+	[[nodiscard]] vk::Buffer GetVertexBufferHandle() const
+	{
+		if (IsSplit())
+			return splitVertices.GetPositionBuffer();
+		return geometry ? geometry.GetPool()->GetVertexBuffer(geometry.Get().arena) : vertexBuffer.VkType();
+	}
+
+	// Bound to AttributeStream, null unless split
+	[[nodiscard]] vk::Buffer GetAttributeBufferHandle() const
+	{
+		return IsSplit() ? splitVertices.GetAttributeBuffer() : vk::Buffer();
+	}
+
+	[[nodiscard]] vk::Buffer GetIndexBufferHandle() const
+	{
+		return geometry ? geometry.GetPool()->GetIndexBuffer() : indexBuffer.VkType();
+	}
+
+	// Pooled indices share the pool's 32 bit index buffer
+	[[nodiscard]] vk::IndexType GetIndexType() const
+	{
+		return geometry ? vk::IndexType::eUint32 : indexBuffer.GetIndexType();
 	}
 
 	[[nodiscard]] const IndexBuffer& GetIndexBuffer() const
@@ -219,7 +414,9 @@ public:
 
 	[[nodiscard]] uint32_t GetVertexCount() const
 	{
-		return vertexBuffer.GetVertexCount();
+		if (IsSplit())
+			return splitVertices.GetVertexCount();
+		return geometry ? geometry.Get().vertexCount : vertexBuffer.GetVertexCount();
 	}
 
 	[[nodiscard]] std::weak_ptr<VertexBuffer < VertexType>> GetVertexBuffer() const
@@ -227,7 +424,7 @@ public:
 		return vertexBuffer;
 	}
 
-    [[nodiscard]] MeshSortKey<VertexType> GetSortKey() const
+    [[nodiscard]] MeshSortKey<Mesh<VertexType>> GetSortKey() const
     {
         return sortKey;
     }
@@ -236,6 +433,7 @@ public:
     void DestroyVertexBuffer()
 	{
 		vertexBuffer.Destroy();
+		splitVertices.Destroy();
 	}
 
 	[[nodiscard]] std::vector<glm::vec3> AggregateVertexPositions() const
@@ -302,9 +500,26 @@ public:
 
 	glm::vec3 GetFurthestVertexPosition(const glm::vec3& direction) const;
 
+	// Each mesh keeps the key it was first created with, the element's 8 bits hold one key per mesh ever created
+	void AssignSortKey()
+	{
+		if (sortKeyAssigned)
+			return;
+
+		static uint64_t assignedKeys = 0;
+		DM_ASSERT_MSG(assignedKeys++ <= MeshSortKey<Mesh<VertexType>>::maxKey,
+					  "Mesh count exceeds the range of the mesh sort key");
+		sortKey = MeshSortKey<Mesh<VertexType>>::GetUnique();
+		sortKeyAssigned = true;
+	}
+
 	VertexBuffer <VertexType> vertexBuffer;
 	IndexBuffer indexBuffer;
+	GeometryHandle geometry;	//< Pool allocation, replaces the buffers above when valid
+	SplitVertexBuffer<VertexType> splitVertices;	//< Replaces vertexBuffer when created through CreateSplit
+	std::vector<LodRange> lods;		//< Empty without a LOD chain
     MeshSortKey<Mesh<VertexType>> sortKey;
+	bool sortKeyAssigned = false;
 };
 
 template<class VertexType>
@@ -354,13 +569,13 @@ struct SimpleMesh
 };
 
 template<class VertexType>
-inline typename Mesh<VertexType>::Data Mesh<VertexType>::LoadModel(const std::string& path)
+inline typename Mesh<VertexType>::Data Mesh<VertexType>::LoadModel(const std::string& path, ThreadPool* pool)
 {
 	DM_ASSERT_MSG(false, "No template specialization for loading a model with this vertex type");
 }
 
 template<>
-inline typename Mesh<Vertex>::Data Mesh<Vertex>::LoadModel(const std::string& path)
+inline typename Mesh<Vertex>::Data Mesh<Vertex>::LoadModel(const std::string& path, ThreadPool* pool)
 {
 	tinyobj::attrib_t attrib;
 	std::vector<tinyobj::shape_t> shapes;
@@ -372,16 +587,23 @@ inline typename Mesh<Vertex>::Data Mesh<Vertex>::LoadModel(const std::string& pa
 		("Failed to load model at " + path).c_str()
 	);
 
-	std::unordered_map<Vertex, uint32_t> uniqueVerts;
-	std::vector<Vertex> vertices;
-	std::vector<uint32_t> indices;
+	// Corners of every shape form one stream, shapeCorners[i] is the first corner of shape i
+	std::vector<uint32_t> shapeCorners(shapes.size() + 1, 0);
+	for (size_t i = 0; i < shapes.size(); ++i)
+		shapeCorners[i + 1] = shapeCorners[i] + (uint32_t) shapes[i].mesh.indices.size();
+
 	bool hasTextureCoords = !attrib.texcoords.empty();
 	bool hasNormals = !attrib.normals.empty();
 	bool hasColors = !attrib.colors.empty();
-	for (const auto& shape : shapes)
+	auto buildCorners = [&](uint32_t begin, uint32_t end, Vertex* out)
 	{
-		for (const auto& index : shape.mesh.indices)
+		size_t shape = std::upper_bound(shapeCorners.begin(), shapeCorners.end(), begin) - shapeCorners.begin() - 1;
+		for (uint32_t corner = begin; corner < end; ++corner)
 		{
+			while (corner >= shapeCorners[shape + 1])
+				++shape;
+
+			const tinyobj::index_t& index = shapes[shape].mesh.indices[corner - shapeCorners[shape]];
 			Vertex vertex{};
 
 			vertex.pos = {
@@ -390,7 +612,7 @@ inline typename Mesh<Vertex>::Data Mesh<Vertex>::LoadModel(const std::string& pa
 				attrib.vertices[3 * index.vertex_index + 2]
 			};
 
-			if (hasTextureCoords)
+			if (hasTextureCoords && index.texcoord_index >= 0)
 			{
 				vertex.texPos = {
 					attrib.texcoords[2 * index.texcoord_index + 0],
@@ -408,7 +630,7 @@ inline typename Mesh<Vertex>::Data Mesh<Vertex>::LoadModel(const std::string& pa
 					};
 			}
 
-			if (hasNormals)
+			if (hasNormals && index.normal_index >= 0)
 			{
 				vertex.normal =
 					{
@@ -418,15 +640,13 @@ inline typename Mesh<Vertex>::Data Mesh<Vertex>::LoadModel(const std::string& pa
 					};
 			}
 
-			if (uniqueVerts.count(vertex) == 0)
-			{
-				uniqueVerts[vertex] = static_cast<uint32_t>(vertices.size());
-				vertices.push_back(vertex);
-			}
-
-			indices.push_back(uniqueVerts[vertex]);
+			out[corner - begin] = vertex;
 		}
-	}
+	};
+
+	std::vector<Vertex> vertices;
+	std::vector<uint32_t> indices;
+	DeduplicateVertices(shapeCorners.back(), buildCorners, vertices, indices, pool);
 
 	return {std::move(vertices), std::move(indices)};
 }
@@ -40,15 +40,6 @@ bool PhysicalDevice::IsDeviceSuitable(vk::PhysicalDevice device) const
 		device.getSurfacePresentModesKHR(surface).empty())
 		return false;
 
-    vk::PhysicalDeviceProperties physicalDeviceProperties;
-    device.getProperties(&physicalDeviceProperties);
-#ifndef OS_Mac
-    if (physicalDeviceProperties.deviceType != vk::PhysicalDeviceType::eDiscreteGpu)
-    {
-        return false;
-    }
-#endif
-
 	return true;
 }
 
@@ -59,16 +50,87 @@ void PhysicalDevice::Create(Renderer* owner)
 	std::vector<vk::PhysicalDevice> devices = OwnerGet<Renderer>().instance.enumeratePhysicalDevices();
 	assert(!devices.empty());
 
-	auto it = std::find_if(devices.begin(), devices.end(), [this](const auto& device) -> bool
+	// Prefer a discrete GPU, falling back to any suitable device (integrated, or software such as lavapipe)
+	auto isDiscrete = [](vk::PhysicalDevice device)
+	{
+		vk::PhysicalDeviceProperties physicalDeviceProperties;
+		device.getProperties(&physicalDeviceProperties);
+		return physicalDeviceProperties.deviceType == vk::PhysicalDeviceType::eDiscreteGpu;
+	};
+
+	auto it = std::find_if(devices.begin(), devices.end(), [this, &isDiscrete](const auto& device) -> bool
 	{
-		return IsDeviceSuitable(device);
+		return isDiscrete(device) && IsDeviceSuitable(device);
 	});
 
+	if (it == devices.end())
+	{
+		it = std::find_if(devices.begin(), devices.end(), [this](const auto& device) -> bool
+		{
+			return IsDeviceSuitable(device);
+		});
+	}
+
 	assert(it != devices.end());
 
 	VkType() = *it;
 	queueFamilyIndices = FindQueueFamilies(&OwnerGet<Renderer>(), VkType());
 	getProperties(&properties);
+	QueryOptionalSupport();
+}
+
+void PhysicalDevice::QueryOptionalSupport()
+{
+	enabledExtensions = deviceExtensions;
+	getFeatures(&supportedFeatures);
+
+	std::vector<vk::ExtensionProperties> available = enumerateDeviceExtensionProperties();
+	for (const char* extension : optionalDeviceExtensions)
+	{
+		auto it = std::find_if(available.begin(), available.end(), [extension](const vk::ExtensionProperties& properties)
+		{
+			return strcmp(properties.extensionName, extension) == 0;
+		});
+
+		if (it != available.end())
+			enabledExtensions.emplace_back(extension);
+	}
+
+#ifdef VK_EXT_graphics_pipeline_library
+	if (IsExtensionEnabled(VK_EXT_GRAPHICS_PIPELINE_LIBRARY_EXTENSION_NAME) &&
+		IsExtensionEnabled(VK_KHR_PIPELINE_LIBRARY_EXTENSION_NAME))
+	{
+		vk::PhysicalDeviceGraphicsPipelineLibraryFeaturesEXT libraryFeatures = {};
+		vk::PhysicalDeviceFeatures2 features = {};
+		features.pNext = &libraryFeatures;
+		getFeatures2(&features);
+		graphicsPipelineLibrary = libraryFeatures.graphicsPipelineLibrary == VK_TRUE;
+	}
+#endif
+
+#ifdef VK_KHR_draw_indirect_count
+	drawIndirectCount = IsExtensionEnabled(VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME);
+#endif
+
+#ifdef VK_EXT_mesh_shader
+	if (IsExtensionEnabled(VK_EXT_MESH_SHADER_EXTENSION_NAME) &&
+		IsExtensionEnabled(VK_KHR_SPIRV_1_4_EXTENSION_NAME))
+	{
+		vk::PhysicalDeviceMeshShaderFeaturesEXT meshShaderFeatures = {};
+		vk::PhysicalDeviceFeatures2 features = {};
+		features.pNext = &meshShaderFeatures;
+		getFeatures2(&features);
+		meshShader = meshShaderFeatures.taskShader == VK_TRUE && meshShaderFeatures.meshShader == VK_TRUE;
+	}
+#endif
+}
+
+bool PhysicalDevice::IsExtensionEnabled(const char* extension) const
+{
+	return std::any_of(enabledExtensions.begin(), enabledExtensions.end(), [extension](const char* enabled)
+	{
+		return strcmp(enabled, extension) == 0;
+	});
 }
 
 
@@ -43,8 +43,15 @@ DM_TYPE_VULKAN_OWNED_BODY(PhysicalDevice, IOwned<Renderer>)
 
 	vk::DeviceSize GetMinimumUniformBufferOffset() const;
 
+	[[nodiscard]] bool IsExtensionEnabled(const char* extension) const;
+
 	QueueFamilyIndices queueFamilyIndices;
 	vk::PhysicalDeviceProperties properties;
+	std::vector<const char*> enabledExtensions;     //< Required extensions and the supported optional extensions
+	bool graphicsPipelineLibrary = false;           //< VK_EXT_graphics_pipeline_library is enabled and its feature supported
+	bool drawIndirectCount = false;                 //< VK_KHR_draw_indirect_count is enabled
+	bool meshShader = false;                        //< VK_EXT_mesh_shader is enabled and its task and mesh shader features supported
+	vk::PhysicalDeviceFeatures supportedFeatures;
 
 private:
 	static QueueFamilyIndices FindQueueFamilies(Renderer* renderer, vk::PhysicalDevice pd);
@@ -52,6 +59,8 @@ private:
 	[[nodiscard]] bool IsDeviceSuitable(vk::PhysicalDevice) const;
 
 	[[nodiscard]] bool CheckDeviceExtensionSupport(vk::PhysicalDevice) const;
+
+	void QueryOptionalSupport();
 };
 
 }
\ No newline at end of file
@@ -15,6 +15,25 @@ void IGraphicsPipeline::Destroy()
 {
     if (created)
     {
+        // Wait on any outstanding link before releasing the parts it's linking from
+        if (optimizedPipeline.valid())
+        {
+            vk::Pipeline optimized = optimizedPipeline.get();
+            if (optimized)
+                owner->destroyPipeline(optimized);
+            optimizedPipeline = {};
+        }
+        if (fastLinkedPipeline)
+        {
+            owner->destroyPipeline(fastLinkedPipeline);
+            fastLinkedPipeline = nullptr;
+        }
+        if (linkedFromLibrary)
+        {
+            owner->PipelineLibrary().Release(libraryParts);
+            linkedFromLibrary = false;
+        }
+
         renderPass.Destroy();
         pipelineLayout.Destroy();
         frameBuffers.clear();
@@ -31,6 +50,8 @@ Renderer& IGraphicsPipeline::Renderer()
 
 vk::CommandBuffer IGraphicsPipeline::Begin()
 {
+    SwapOptimizedPipeline();
+
     auto commandBuffer = drawBuffers[owner->ImageIndex()];
     vk::CommandBufferBeginInfo beginInfo = {};
     DM_ASSERT_VK(commandBuffer.begin(&beginInfo));
@@ -41,6 +62,37 @@ vk::CommandBuffer IGraphicsPipeline::Begin()
 void IGraphicsPipeline::End()
 {
     GetCommandBufferPtr()->end();
+    if (recordCache.IsTracking())
+        recordCache.Recorded();
+}
+
+RecordCache& IGraphicsPipeline::TrackInputs()
+{
+    // Swapping in the optimized link changes the pipeline the recording binds
+    SwapOptimizedPipeline();
+
+    const int imageIndex = owner->ImageIndex();
+    recordCache.Begin(imageIndex);
+    recordCache.Track(VkType());
+    recordCache.Track(renderPass.VkType());
+    recordCache.Track(frameBuffers[imageIndex].VkType());
+    return recordCache;
+}
+
+void IGraphicsPipeline::SwapOptimizedPipeline()
+{
+    if (!optimizedPipeline.valid() ||
+        optimizedPipeline.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+        return;
+
+    vk::Pipeline optimized = optimizedPipeline.get();
+    optimizedPipeline = {};
+    if (!optimized)
+        return;
+
+    // Previously recorded frames may still reference the fast link, so it lives until Destroy
+    fastLinkedPipeline = VkType();
+    VkType() = optimized;
 }
 
 vk::CommandBuffer* IGraphicsPipeline::GetCommandBufferPtr()
@@ -38,6 +38,11 @@ DM_TYPE_VULKAN_OWNED_BODY(IGraphicsPipeline, IOwned < Device >);
     vk::CommandBuffer Begin();
     void End();
 
+    /// \brief Start tracking the current image's inputs in recordCache, including the pipeline, render pass and frame buffer.
+    ///        Track the recording's other inputs, then Begin only if recordCache.NeedsRecord(), otherwise return
+    ///        GetCommandBufferPtr() to submit the previous recording. End marks the image recorded.
+    RecordCache& TrackInputs();
+
     template <size_t AttachmentCount>
     void Create(
         const vk::CommandBufferAllocateInfo& commandBufferAllocateInfo,
@@ -55,7 +60,16 @@ DM_TYPE_VULKAN_OWNED_BODY(IGraphicsPipeline, IOwned < Device >);
     )
     {
         IOwned<Device>::CreateOwned(inOwner);
+        // Kept when the pipeline is recreated with the swapchain, so existing draws still sort with it
+        if (!sortKeyAssigned)
+        {
+            sortKey = PipelineSortKey<IGraphicsPipeline>::GetUnique();
+            DM_ASSERT_MSG(sortKey.key <= PipelineSortKey<IGraphicsPipeline>::maxKey,
+                          "Pipeline count exceeds the range of the pipeline sort key");
+            sortKeyAssigned = true;
+        }
         drawBuffers.Create(commandBufferAllocateInfo, commandPool);
+        recordCache.Create(owner->ImageCount());
         frameBuffers.resize(owner->ImageCount());
 
         for(auto& semaphore : semaphores)
@@ -63,7 +77,20 @@ DM_TYPE_VULKAN_OWNED_BODY(IGraphicsPipeline, IOwned < Device >);
 
 
         renderPass.Create(renderPassCreateInfo, extent, clearValues, inOwner);
-        pipelineLayout.Create(pipelineLayoutCreateInfo, inOwner);
+
+        // Source the push constant range from reflection unless the pipeline declares its own
+        vk::PipelineLayoutCreateInfo layoutCreateInfo = pipelineLayoutCreateInfo;
+        if (layoutCreateInfo.pushConstantRangeCount == 0 && reflection != nullptr && !reflection->pushConstants.IsEmpty())
+        {
+            pushConstantRange = reflection->pushConstants.GetRange();
+            DM_ASSERT_MSG(pushConstantRange.offset + pushConstantRange.size <=
+                          OwnerGet<PhysicalDevice>().GetProperties().limits.maxPushConstantsSize,
+                          "Push constant block exceeds the device's maximum push constant size");
+
+            layoutCreateInfo.pushConstantRangeCount = 1;
+            layoutCreateInfo.pPushConstantRanges = &pushConstantRange;
+        }
+        pipelineLayout.Create(layoutCreateInfo, inOwner);
         graphicsPipelineCreateInfo.renderPass = renderPass.VkType();                            // Render pass description the pipeline is compatible with
         graphicsPipelineCreateInfo.layout = pipelineLayout.VkType();
 
@@ -76,13 +103,77 @@ DM_TYPE_VULKAN_OWNED_BODY(IGraphicsPipeline, IOwned < Device >);
             frameBuffers[i].Create(frameBufferCreateInfo, inOwner);
         }
 
-        DM_ASSERT_VK(owner->createGraphicsPipelines(vk::PipelineCache(), 1, &graphicsPipelineCreateInfo, nullptr, &VkType()));
+        // Apply this variant's specialization constants to each stage that doesn't provide its own
+        std::vector<vk::PipelineShaderStageCreateInfo> stages(
+            graphicsPipelineCreateInfo.pStages,
+            graphicsPipelineCreateInfo.pStages + graphicsPipelineCreateInfo.stageCount);
+        for (auto& stage : stages)
+        {
+            if (stage.pSpecializationInfo == nullptr)
+                stage.pSpecializationInfo = specialization.GetInfo();
+        }
+        const vk::PipelineShaderStageCreateInfo* inStages = graphicsPipelineCreateInfo.pStages;
+        graphicsPipelineCreateInfo.pStages = stages.data();
+
+        // Link from cached library parts when supported, swapping to the optimized link once it's ready
+        PipelineLibrary& library = owner->PipelineLibrary();
+        if (library.IsEnabled())
+        {
+            PipelineLibrary::LinkedPipeline linked = library.Link(graphicsPipelineCreateInfo, layoutCreateInfo, renderPassCreateInfo);
+            VkType() = linked.pipeline;
+            optimizedPipeline = std::move(linked.optimized);
+            libraryParts = linked.parts;
+            linkedFromLibrary = true;
+        }
+        else
+        {
+            DM_ASSERT_VK(owner->createGraphicsPipelines(vk::PipelineCache(), 1, &graphicsPipelineCreateInfo, nullptr, &VkType()));
+        }
+        graphicsPipelineCreateInfo.pStages = inStages;
     }
 
-    template <class PipelineType>
+    /// \brief Reflects the pipeline's descriptor sets, vertex input and specialization constants.
+    /// \tparam VertexType Structure bound to VertexStream, SplitVertex to deinterleave it, void to pack the shader's inputs tightly
+    /// \tparam InstanceType Structure bound to InstanceStream for i_ prefixed inputs, void to pack them tightly
+    template <class PipelineType, class VertexType = void, class InstanceType = void>
     void ReadShader(const std::vector<std::string>& modulePaths)
     {
+        // Embedded shaders are used in place, anything else is read from disk for the duration of reflection
+        std::vector<std::vector<char>> sources;
+        std::vector<EmbeddedShader> shaders;
+        sources.reserve(modulePaths.size());
+        for (auto& path : modulePaths)
+        {
+            if (const EmbeddedShader* embedded = EmbeddedShaders::Find(path))
+            {
+                shaders.emplace_back(*embedded);
+                continue;
+            }
+
+            std::vector<char>& source = sources.emplace_back(utils::ReadFile(path));
+            EmbeddedShader& shader = shaders.emplace_back();
+            shader.path = path;
+            shader.code = reinterpret_cast<const uint32_t*>(source.data());
+            shader.wordCount = source.size() / sizeof(uint32_t);
+        }
+
+        ReadShader<PipelineType, VertexType, InstanceType>(shaders.data(), shaders.size());
+    }
+
+    template <class PipelineType, class VertexType = void, class InstanceType = void>
+    void ReadShader(std::initializer_list<EmbeddedShader> shaders)
+    {
+        ReadShader<PipelineType, VertexType, InstanceType>(shaders.begin(), shaders.size());
+    }
+
+    template <class PipelineType, class VertexType = void, class InstanceType = void>
+    void ReadShader(const EmbeddedShader* shaders, size_t shaderCount)
+    {
+        std::vector<VertexInputData> vertexInputs;
+        std::vector<vk::VertexInputBindingDescription> vertexBindings;
         std::vector<vk::VertexInputAttributeDescription> vertexAttributeDescriptions;
+        std::vector<SpecializationConstantData> specializationConstants;
+        PushConstantBlockData pushConstants;
         // Create an array of layout data per set, of which there are 4
         std::array<DescriptorSetLayoutData, DescriptorSetIndex::Count> setLayoutData;
         auto findBinding = [&setLayoutData](uint32_t setNumber, uint32_t bindingIndex) mutable {
@@ -95,12 +186,12 @@ DM_TYPE_VULKAN_OWNED_BODY(IGraphicsPipeline, IOwned < Device >);
 
         Descriptors& descriptors = owner->Descriptors();
 
-        for (auto& path : modulePaths)
+        for (size_t i_shader = 0; i_shader < shaderCount; ++i_shader)
         {
-            std::vector<char> source = utils::ReadFile(path);
+            const EmbeddedShader& shader = shaders[i_shader];
 
             // Construct spir-v shader module from the source
-            spv_reflect::ShaderModule shaderModule(source.size(), source.data());
+            spv_reflect::ShaderModule shaderModule(shader.Size(), shader.code);
             assert(shaderModule.GetResult() == SPV_REFLECT_RESULT_SUCCESS);
 
             SpvReflectShaderStageFlagBits stageFlags = shaderModule.GetShaderStage();
@@ -112,54 +203,16 @@ DM_TYPE_VULKAN_OWNED_BODY(IGraphicsPipeline, IOwned < Device >);
             result = shaderModule.EnumerateDescriptorSets(&count, sets.data());
             assert(result == SPV_REFLECT_RESULT_SUCCESS);
 
+            ReflectSpecializationConstants(
+                shader.code,
+                shader.wordCount,
+                static_cast<vk::ShaderStageFlagBits>(stageFlags),
+                specializationConstants);
+            ReflectPushConstants(shaderModule, static_cast<vk::ShaderStageFlagBits>(stageFlags), pushConstants);
+
             // If vertex shader, gather vertex pipeline data
             if (stageFlags == SPV_REFLECT_SHADER_STAGE_VERTEX_BIT)
-            {
-                // Enumerate vertices
-                result = shaderModule.EnumerateInputVariables(&count, nullptr);
-                assert(result == SPV_REFLECT_RESULT_SUCCESS);
-
-                std::vector<SpvReflectInterfaceVariable*> inputVariables(count);
-                result = shaderModule.EnumerateInputVariables(&count, inputVariables.data());
-                assert(result == SPV_REFLECT_RESULT_SUCCESS);
-
-                // Sort input vertices by location
-                std::sort(inputVariables.begin(), inputVariables.end(),
-                          [](const auto* a, const auto* b) {
-                              return a->location < b->location;
-                          });
-
-                // @Jon TODO: Support instanced vertex bindings
-                // Get vertex descriptions, updating offsets while iterating
-                uint32_t offset = 0;
-                int instancedBinding = 1;
-                for (int i = 0; i < count; ++i)
-                {
-                    auto* var = inputVariables[i];
-                    const char * instancedPrefixLocation = strstr(var->name, "i_");
-                    auto& desc = vertexAttributeDescriptions.emplace_back();
-
-                    bool instanced = instancedPrefixLocation != nullptr;
-
-                    // Binding 1+ if instanced, else binding 0
-                    desc.binding = instanced ? instancedBinding++ : 0;
-                    desc.location = var->location;
-                    desc.format = static_cast<vk::Format>(var->format);
-
-                    // Offset is previous vector's size if normal vector
-                    // Else 0, as we pack our instanced vertex buffers fully
-                    desc.offset = instanced ? 0 : offset;
-
-                    // Get the size of this vector, add it to the existing offset
-                    if (!instanced)
-                    {
-                        uint32_t size = var->numeric.vector.component_count * sizeof(float);
-                        DM_ASSERT_MSG(size, "Only vectors of floats are supported as input attributes at this time for non-instanced variables");
-
-                        offset += instanced ? 0 : size;
-                    }
-                }
-            }
+                ReflectVertexInputs(shaderModule, vertexInputs);
 
             // Magically acquire each descriptor set in the shader source (copied from spir-v docs)
             for (auto& set : sets)
@@ -214,10 +267,35 @@ DM_TYPE_VULKAN_OWNED_BODY(IGraphicsPipeline, IOwned < Device >);
             setLayouts[i].Create(createInfo, owner);
         }
 
+        BuildVertexInputLayout(
+            vertexInputs,
+            DeclaredVertexAttributes<VertexType>(),
+            DeclaredVertexStride<VertexType>(),
+            DeclaredPositionStride<VertexType>(),
+            DeclaredVertexAttributes<InstanceType>(),
+            DeclaredVertexStride<InstanceType>(),
+            vertexBindings,
+            vertexAttributeDescriptions);
+
         descriptors.PushData<PipelineType>(
             std::move(setLayouts),
             std::move(setLayoutData),
             std::move(vertexAttributeDescriptions));
+
+        // Variants start from the shader's defaults, override through specialization.Set before Create
+        auto& pipelineDescriptors = descriptors.GetPipelineDescriptors<PipelineType>();
+        pipelineDescriptors.vertexBindings = std::move(vertexBindings);
+        pipelineDescriptors.vertexInputs = std::move(vertexInputs);
+        pipelineDescriptors.pushConstants = std::move(pushConstants);
+        reflection = &pipelineDescriptors;
+        pipelineDescriptors.specializationConstants = std::move(specializationConstants);
+        specialization.Create(pipelineDescriptors.specializationConstants);
+    }
+
+    [[nodiscard]] const PushConstantBlockData& GetPushConstantBlock() const
+    {
+        DM_ASSERT_MSG(reflection != nullptr, "Attempting to get push constants of a pipeline that hasn't read its shaders");
+        return reflection->pushConstants;
     }
 
     void Destroy();
@@ -229,8 +307,108 @@ DM_TYPE_VULKAN_OWNED_BODY(IGraphicsPipeline, IOwned < Device >);
     ImageAsync<FrameBuffer> frameBuffers = {};
     FrameAsync<Semaphore> semaphores = {};
     CommandBufferVector drawBuffers = {};
+    RecordCache recordCache = {};                       //< Inputs drawBuffers were last recorded with, see TrackInputs
     vk::PushConstantRange pushConstantRange = {};
+    SpecializationConstants specialization = {};
     vk::PipelineStageFlags stageFlags = vk::PipelineStageFlagBits::eColorAttachmentOutput;
+    PipelineSortKey<IGraphicsPipeline> sortKey = {};    //< Pipeline element of the RenderSortKeys of draws using this pipeline
+    const Descriptors::PipelineDescriptors* reflection = nullptr;  //< Data reflected by ReadShader, owned by Descriptors
+
+private:
+    void SwapOptimizedPipeline();
+
+    bool sortKeyAssigned = false;
+    std::shared_future<vk::Pipeline> optimizedPipeline;     //< Pending background link of this pipeline
+    vk::Pipeline fastLinkedPipeline = {};                   //< Replaced fast link, kept alive for in flight frames
+    PipelineLibrary::PartKeys libraryParts = {};            //< Library parts referenced while linkedFromLibrary
+    bool linkedFromLibrary = false;
+};
+
+/**
+ * Typed push constant data for a pipeline, T mirrors the shader's push constant block.
+ * Validated against the reflected block once the pipeline is created. If T declares
+ * a static Members() function, member offsets are validated by name as well.
+ */
+template <class T>
+class PushConstants
+{
+public:
+    static_assert(std::is_trivially_copyable<T>::value, "Push constant data must be trivially copyable");
+
+    void Create(const IGraphicsPipeline& pipeline)
+    {
+        DM_ASSERT_MSG(pipeline.pipelineLayout.created, "Push constants must be created after their pipeline");
+        const PushConstantBlockData& block = pipeline.GetPushConstantBlock();
+        DM_ASSERT_MSG(!block.IsEmpty(), "Attempting to create push constants for a pipeline without a push constant block");
+
+        // T covers the whole block from offset 0, any extra size may only be trailing alignment
+        const uint32_t blockEnd = block.offset + block.size;
+        DM_ASSERT_MSG(sizeof(T) >= blockEnd, ("Push constant type is smaller than shader block " + block.name).c_str());
+        DM_ASSERT_MSG(sizeof(T) - blockEnd < alignof(T), ("Push constant type is larger than shader block " + block.name).c_str());
+
+        if constexpr (HasPushConstantMembers<T>::value)
+        {
+            const PushConstantMembers declared = T::Members();
+            DM_ASSERT_MSG(declared.size() == block.members.size(),
+                          ("Push constant type declares a different member count than shader block " + block.name).c_str());
+            for (const PushConstantMember& member : declared)
+            {
+                auto it = std::find_if(block.members.begin(), block.members.end(),
+                                       [&member](const PushConstantMemberData& data)
+                                       {
+                                           return data.name == member.name;
+                                       });
+                DM_ASSERT_MSG(it != block.members.end(),
+                              ("Push constant member " + std::string(member.name) + " isn't present in the shader").c_str());
+                DM_ASSERT_MSG(it->offset == member.offset,
+                              ("Push constant member " + it->name + " is at a different offset than in the shader").c_str());
+            }
+        }
+
+        layout = pipeline.pipelineLayout.VkType();
+        range = block.GetRange();
+    }
+
+    void Push(vk::CommandBuffer commandBuffer) const
+    {
+        DM_ASSERT_MSG(layout, "Attempting to push constants that haven't been created");
+        commandBuffer.pushConstants(
+            layout,
+            range.stageFlags,
+            range.offset, range.size,
+            reinterpret_cast<const char*>(&data) + range.offset
+        );
+    }
+
+    void Push(vk::CommandBuffer commandBuffer, const T& value)
+    {
+        data = value;
+        Push(commandBuffer);
+    }
+
+    // Skipped when the block's contents are unchanged since the last push through recorder
+    void Push(CommandRecorder& recorder) const
+    {
+        DM_ASSERT_MSG(layout, "Attempting to push constants that haven't been created");
+        recorder.PushConstants(
+            layout,
+            range.stageFlags,
+            range.offset, range.size,
+            reinterpret_cast<const char*>(&data) + range.offset
+        );
+    }
+
+    void Push(CommandRecorder& recorder, const T& value)
+    {
+        data = value;
+        Push(recorder);
+    }
+
+    T data = {};
+
+private:
+    vk::PipelineLayout layout = {};
+    vk::PushConstantRange range = {};
 };
 
 }
\ No newline at end of file
@@ -0,0 +1,537 @@
+//------------------------------------------------------------------------------
+//
+// File Name:	PipelineLibrary.cpp
+// Author(s):	Jonathan Bourim (j.bourim)
+// Date:		10/19/2026
+//
+//------------------------------------------------------------------------------
+#include "PipelineLibrary.h"
+
+namespace dm
+{
+
+namespace
+{
+
+// FNV-1a over the pipeline state making up a part, pointers are followed rather than hashed
+class StateHasher
+{
+public:
+    template <class T>
+    StateHasher& Add(const T& value)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "Only plain state may be hashed directly");
+        return AddBytes(&value, sizeof(T));
+    }
+
+    template <class T>
+    StateHasher& Add(const T* values, uint32_t count)
+    {
+        Add(count);
+        return values != nullptr ? AddBytes(values, sizeof(T) * count) : *this;
+    }
+
+    StateHasher& Add(const char* string)
+    {
+        return string != nullptr ? AddBytes(string, strlen(string)) : *this;
+    }
+
+    StateHasher& AddBytes(const void* data, size_t size)
+    {
+        const auto* bytes = static_cast<const uint8_t*>(data);
+        for (size_t i = 0; i < size; ++i)
+        {
+            hash ^= bytes[i];
+            hash *= 1099511628211ull;
+        }
+        return *this;
+    }
+
+    [[nodiscard]] uint64_t Get() const { return hash; }
+
+private:
+    uint64_t hash = 14695981039346656037ull;
+};
+
+// Render passes are compatible when they differ only in load and store ops and image layouts,
+// so references are hashed by the format and sample count of the attachment they reference
+uint64_t GetRenderPassKey(const vk::RenderPassCreateInfo& createInfo, uint32_t subpass)
+{
+    StateHasher hasher;
+    hasher.Add(createInfo.flags).Add(createInfo.attachmentCount).Add(subpass);
+    auto addReference = [&hasher, &createInfo](const vk::AttachmentReference& reference)
+    {
+        if (reference.attachment == VK_ATTACHMENT_UNUSED)
+        {
+            hasher.Add(reference.attachment);
+            return;
+        }
+        const vk::AttachmentDescription& attachment = createInfo.pAttachments[reference.attachment];
+        hasher.Add(attachment.format).Add(attachment.samples);
+    };
+
+    for (uint32_t i = 0; i < createInfo.attachmentCount; ++i)
+        hasher.Add(createInfo.pAttachments[i].format).Add(createInfo.pAttachments[i].samples);
+
+    hasher.Add(createInfo.subpassCount);
+    for (uint32_t i = 0; i < createInfo.subpassCount; ++i)
+    {
+        const vk::SubpassDescription& description = createInfo.pSubpasses[i];
+        hasher.Add(description.flags).Add(description.pipelineBindPoint);
+        hasher.Add(description.inputAttachmentCount);
+        for (uint32_t j = 0; j < description.inputAttachmentCount; ++j)
+            addReference(description.pInputAttachments[j]);
+        hasher.Add(description.colorAttachmentCount);
+        for (uint32_t j = 0; j < description.colorAttachmentCount; ++j)
+        {
+            addReference(description.pColorAttachments[j]);
+            if (description.pResolveAttachments != nullptr)
+                addReference(description.pResolveAttachments[j]);
+        }
+        if (description.pDepthStencilAttachment != nullptr)
+            addReference(*description.pDepthStencilAttachment);
+        else
+            hasher.Add(VK_ATTACHMENT_UNUSED);
+    }
+
+    hasher.Add(createInfo.pDependencies, createInfo.dependencyCount);
+    return hasher.Get();
+}
+
+}
+
+void PipelineLibrary::Create(Device* inOwner)
+{
+    IOwned<Device>::CreateOwned(inOwner);
+#ifdef VK_EXT_graphics_pipeline_library
+    enabled = OwnerGet<PhysicalDevice>().graphicsPipelineLibrary;
+#endif
+
+    if (enabled)
+    {
+        stopWorker = false;
+        worker = std::thread(&PipelineLibrary::RunWorker, this);
+    }
+}
+
+void PipelineLibrary::Destroy()
+{
+    if (!created)
+        return;
+
+    if (worker.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> lock(jobMutex);
+            stopWorker = true;
+        }
+        jobCondition.notify_one();
+        worker.join();
+    }
+
+    // Anyone still waiting on an optimized link falls back to their fast linked pipeline
+    while (!jobs.empty())
+    {
+        jobs.front().result.set_value(vk::Pipeline());
+        jobs.pop();
+    }
+
+    for (auto& cache : parts)
+    {
+        for (auto& [key, part] : cache)
+            owner->destroyPipeline(part.pipeline);
+        cache.clear();
+    }
+    unusedParts = 0;
+
+    enabled = false;
+    created = false;
+}
+
+PipelineLibrary::~PipelineLibrary() noexcept
+{
+    Destroy();
+}
+
+PipelineLibrary::LinkedPipeline PipelineLibrary::Link(
+    const vk::GraphicsPipelineCreateInfo& createInfo,
+    const vk::PipelineLayoutCreateInfo& layoutCreateInfo,
+    const vk::RenderPassCreateInfo& renderPassCreateInfo
+)
+{
+    DM_ASSERT_MSG(enabled, "Attempting to link a pipeline without graphics pipeline library support");
+    LinkedPipeline linked;
+
+#ifdef VK_EXT_graphics_pipeline_library
+    std::vector<vk::PipelineShaderStageCreateInfo> preRasterizationStages;
+    std::vector<vk::PipelineShaderStageCreateInfo> fragmentStages;
+    for (uint32_t i = 0; i < createInfo.stageCount; ++i)
+    {
+        const auto& stage = createInfo.pStages[i];
+        (stage.stage == vk::ShaderStageFlagBits::eFragment ? fragmentStages : preRasterizationStages).emplace_back(stage);
+    }
+
+    // Dynamic states outside of a part's subset are ignored, so every part receives all of them
+    const vk::PipelineDynamicStateCreateInfo* dynamicState = createInfo.pDynamicState;
+    auto beginHash = [dynamicState]()
+    {
+        StateHasher hasher;
+        if (dynamicState != nullptr)
+            hasher.Add(dynamicState->pDynamicStates, dynamicState->dynamicStateCount);
+        return hasher;
+    };
+
+    const vk::PipelineMultisampleStateCreateInfo* multisample = createInfo.pMultisampleState;
+    auto hashMultisample = [multisample](StateHasher& hasher)
+    {
+        if (multisample == nullptr)
+            return;
+
+        hasher.Add(multisample->rasterizationSamples).Add(multisample->sampleShadingEnable)
+              .Add(multisample->minSampleShading).Add(multisample->alphaToCoverageEnable)
+              .Add(multisample->alphaToOneEnable);
+        if (multisample->pSampleMask != nullptr)
+            hasher.Add(*multisample->pSampleMask);
+    };
+
+    // Layouts, render passes and modules are recreated along with their pipelines, so parts are keyed by their contents
+    const uint64_t layoutKey = GetLayoutKey(layoutCreateInfo);
+    const uint64_t renderPassKey = GetRenderPassKey(renderPassCreateInfo, createInfo.subpass);
+
+    std::array<vk::Pipeline, PartCount> linkParts;
+    PartKeys partKeys;
+
+    // Vertex input interface
+    {
+        StateHasher hasher = beginHash();
+        if (const auto* vertexInput = createInfo.pVertexInputState)
+        {
+            hasher.Add(vertexInput->pVertexBindingDescriptions, vertexInput->vertexBindingDescriptionCount);
+            hasher.Add(vertexInput->pVertexAttributeDescriptions, vertexInput->vertexAttributeDescriptionCount);
+        }
+        if (const auto* inputAssembly = createInfo.pInputAssemblyState)
+            hasher.Add(inputAssembly->topology).Add(inputAssembly->primitiveRestartEnable);
+
+        vk::GraphicsPipelineCreateInfo partCreateInfo = {};
+        partCreateInfo.pVertexInputState = createInfo.pVertexInputState;
+        partCreateInfo.pInputAssemblyState = createInfo.pInputAssemblyState;
+        partCreateInfo.pDynamicState = dynamicState;
+        partKeys[VertexInput] = hasher.Get();
+        linkParts[VertexInput] = GetPart(VertexInput, partKeys[VertexInput], partCreateInfo);
+    }
+
+    // Pre-rasterization shaders
+    {
+        StateHasher hasher = beginHash();
+        hasher.Add(layoutKey).Add(renderPassKey).Add(GetStagesKey(preRasterizationStages));
+        if (const auto* viewport = createInfo.pViewportState)
+        {
+            hasher.Add(viewport->pViewports, viewport->viewportCount);
+            hasher.Add(viewport->pScissors, viewport->scissorCount);
+        }
+        if (const auto* rasterization = createInfo.pRasterizationState)
+        {
+            hasher.Add(rasterization->depthClampEnable).Add(rasterization->rasterizerDiscardEnable)
+                  .Add(rasterization->polygonMode).Add(rasterization->cullMode).Add(rasterization->frontFace)
+                  .Add(rasterization->depthBiasEnable).Add(rasterization->depthBiasConstantFactor)
+                  .Add(rasterization->depthBiasClamp).Add(rasterization->depthBiasSlopeFactor)
+                  .Add(rasterization->lineWidth);
+        }
+        if (const auto* tessellation = createInfo.pTessellationState)
+            hasher.Add(tessellation->patchControlPoints);
+
+        vk::GraphicsPipelineCreateInfo partCreateInfo = {};
+        partCreateInfo.stageCount = static_cast<uint32_t>(preRasterizationStages.size());
+        partCreateInfo.pStages = preRasterizationStages.data();
+        partCreateInfo.pViewportState = createInfo.pViewportState;
+        partCreateInfo.pRasterizationState = createInfo.pRasterizationState;
+        partCreateInfo.pTessellationState = createInfo.pTessellationState;
+        partCreateInfo.pDynamicState = dynamicState;
+        partCreateInfo.layout = createInfo.layout;
+        partCreateInfo.renderPass = createInfo.renderPass;
+        partCreateInfo.subpass = createInfo.subpass;
+        partKeys[PreRasterization] = hasher.Get();
+        linkParts[PreRasterization] = GetPart(PreRasterization, partKeys[PreRasterization], partCreateInfo);
+    }
+
+    // Fragment shader
+    {
+        StateHasher hasher = beginHash();
+        hasher.Add(layoutKey).Add(renderPassKey).Add(GetStagesKey(fragmentStages));
+        hashMultisample(hasher);
+        if (const auto* depthStencil = createInfo.pDepthStencilState)
+        {
+            hasher.Add(depthStencil->depthTestEnable).Add(depthStencil->depthWriteEnable)
+                  .Add(depthStencil->depthCompareOp).Add(depthStencil->depthBoundsTestEnable)
+                  .Add(depthStencil->stencilTestEnable).Add(depthStencil->front).Add(depthStencil->back)
+                  .Add(depthStencil->minDepthBounds).Add(depthStencil->maxDepthBounds);
+        }
+
+        vk::GraphicsPipelineCreateInfo partCreateInfo = {};
+        partCreateInfo.stageCount = static_cast<uint32_t>(fragmentStages.size());
+        partCreateInfo.pStages = fragmentStages.data();
+        partCreateInfo.pDepthStencilState = createInfo.pDepthStencilState;
+        partCreateInfo.pMultisampleState = multisample;
+        partCreateInfo.pDynamicState = dynamicState;
+        partCreateInfo.layout = createInfo.layout;
+        partCreateInfo.renderPass = createInfo.renderPass;
+        partCreateInfo.subpass = createInfo.subpass;
+        partKeys[FragmentShader] = hasher.Get();
+        linkParts[FragmentShader] = GetPart(FragmentShader, partKeys[FragmentShader], partCreateInfo);
+    }
+
+    // Fragment output interface
+    {
+        StateHasher hasher = beginHash();
+        hasher.Add(renderPassKey);
+        hashMultisample(hasher);
+        if (const auto* colorBlend = createInfo.pColorBlendState)
+        {
+            hasher.Add(colorBlend->logicOpEnable).Add(colorBlend->logicOp).Add(colorBlend->blendConstants);
+            hasher.Add(colorBlend->pAttachments, colorBlend->attachmentCount);
+        }
+
+        vk::GraphicsPipelineCreateInfo partCreateInfo = {};
+        partCreateInfo.pColorBlendState = createInfo.pColorBlendState;
+        partCreateInfo.pMultisampleState = multisample;
+        partCreateInfo.pDynamicState = dynamicState;
+        partCreateInfo.renderPass = createInfo.renderPass;
+        partCreateInfo.subpass = createInfo.subpass;
+        partKeys[FragmentOutput] = hasher.Get();
+        linkParts[FragmentOutput] = GetPart(FragmentOutput, partKeys[FragmentOutput], partCreateInfo);
+    }
+
+    linked.pipeline = LinkParts(linkParts, createInfo.layout, createInfo.flags, false);
+    linked.parts = partKeys;
+
+    // Queue the optimized link, the fast linked pipeline is used until it completes
+    LinkJob job;
+    job.parts = linkParts;
+    job.layout = createInfo.layout;
+    job.flags = createInfo.flags;
+    linked.optimized = job.result.get_future().share();
+    {
+        std::lock_guard<std::mutex> lock(jobMutex);
+        jobs.emplace(std::move(job));
+    }
+    jobCondition.notify_one();
+#endif
+
+    return linked;
+}
+
+vk::Pipeline PipelineLibrary::GetPart(PartIndex index, uint64_t key, vk::GraphicsPipelineCreateInfo partCreateInfo)
+{
+    {
+        std::lock_guard<std::mutex> lock(partMutex);
+        auto it = parts[index].find(key);
+        if (it != parts[index].end())
+        {
+            ++stats.partsReused;
+            return AddReference(it->second);
+        }
+    }
+
+    vk::Pipeline pipeline = {};
+#ifdef VK_EXT_graphics_pipeline_library
+    static constexpr vk::GraphicsPipelineLibraryFlagBitsEXT partFlags[PartCount] = {
+        vk::GraphicsPipelineLibraryFlagBitsEXT::eVertexInputInterface,
+        vk::GraphicsPipelineLibraryFlagBitsEXT::ePreRasterizationShaders,
+        vk::GraphicsPipelineLibraryFlagBitsEXT::eFragmentShader,
+        vk::GraphicsPipelineLibraryFlagBitsEXT::eFragmentOutputInterface
+    };
+
+    vk::GraphicsPipelineLibraryCreateInfoEXT libraryCreateInfo = {};
+    libraryCreateInfo.flags = partFlags[index];
+    partCreateInfo.pNext = &libraryCreateInfo;
+    partCreateInfo.flags = vk::PipelineCreateFlagBits::eLibraryKHR |
+                           vk::PipelineCreateFlagBits::eRetainLinkTimeOptimizationInfoEXT;
+
+    // Compiled outside of the lock, so parts for different pipelines may compile concurrently
+    DM_ASSERT_VK(owner->createGraphicsPipelines(vk::PipelineCache(), 1, &partCreateInfo, nullptr, &pipeline));
+#endif
+
+    std::lock_guard<std::mutex> lock(partMutex);
+    auto [it, inserted] = parts[index].try_emplace(key, Part{ pipeline });
+    if (!inserted)
+    {
+        // Another thread created the same part first
+        owner->destroyPipeline(pipeline);
+        ++stats.partsReused;
+        return AddReference(it->second);
+    }
+
+    ++stats.partsCreated;
+    it->second.references = 1;
+    return pipeline;
+}
+
+vk::Pipeline PipelineLibrary::AddReference(Part& part)
+{
+    if (part.references++ == 0)
+        --unusedParts;
+    return part.pipeline;
+}
+
+vk::Pipeline PipelineLibrary::LinkParts(
+    const std::array<vk::Pipeline, PartCount>& linkParts,
+    vk::PipelineLayout layout,
+    vk::PipelineCreateFlags flags,
+    bool optimize
+)
+{
+    vk::Pipeline pipeline = {};
+#ifdef VK_EXT_graphics_pipeline_library
+    vk::PipelineLibraryCreateInfoKHR libraryInfo = {};
+    libraryInfo.libraryCount = static_cast<uint32_t>(linkParts.size());
+    libraryInfo.pLibraries = linkParts.data();
+
+    vk::GraphicsPipelineCreateInfo linkCreateInfo = {};
+    linkCreateInfo.pNext = &libraryInfo;
+    linkCreateInfo.layout = layout;
+    linkCreateInfo.flags = flags;
+    if (optimize)
+        linkCreateInfo.flags |= vk::PipelineCreateFlagBits::eLinkTimeOptimizationEXT;
+
+    DM_ASSERT_VK(owner->createGraphicsPipelines(vk::PipelineCache(), 1, &linkCreateInfo, nullptr, &pipeline));
+
+    std::lock_guard<std::mutex> lock(partMutex);
+    ++(optimize ? stats.optimizedLinks : stats.fastLinks);
+#endif
+    return pipeline;
+}
+
+void PipelineLibrary::RunWorker()
+{
+    while (true)
+    {
+        LinkJob job;
+        {
+            std::unique_lock<std::mutex> lock(jobMutex);
+            jobCondition.wait(lock, [this]() { return stopWorker || !jobs.empty(); });
+            if (stopWorker)
+                return;
+
+            job = std::move(jobs.front());
+            jobs.pop();
+        }
+
+        job.result.set_value(LinkParts(job.parts, job.layout, job.flags, true));
+    }
+}
+
+void PipelineLibrary::RecordSetLayout(vk::DescriptorSetLayout setLayout, const vk::DescriptorSetLayoutCreateInfo& createInfo)
+{
+    StateHasher hasher;
+    hasher.Add(createInfo.flags).Add(createInfo.bindingCount);
+    for (uint32_t i = 0; i < createInfo.bindingCount; ++i)
+    {
+        const auto& binding = createInfo.pBindings[i];
+        hasher.Add(binding.binding).Add(binding.descriptorType).Add(binding.descriptorCount).Add(binding.stageFlags);
+        hasher.Add(binding.pImmutableSamplers, binding.pImmutableSamplers != nullptr ? binding.descriptorCount : 0);
+    }
+
+    // A handle reused after its set layout was destroyed is recorded again with its new contents
+    std::lock_guard<std::mutex> lock(partMutex);
+    setLayoutKeys[static_cast<VkDescriptorSetLayout>(setLayout)] = hasher.Get();
+}
+
+uint64_t PipelineLibrary::GetLayoutKey(const vk::PipelineLayoutCreateInfo& layoutCreateInfo) const
+{
+    StateHasher hasher;
+    hasher.Add(layoutCreateInfo.flags).Add(layoutCreateInfo.setLayoutCount);
+    {
+        std::lock_guard<std::mutex> lock(partMutex);
+        for (uint32_t i = 0; i < layoutCreateInfo.setLayoutCount; ++i)
+        {
+            const vk::DescriptorSetLayout setLayout = layoutCreateInfo.pSetLayouts[i];
+            auto it = setLayoutKeys.find(static_cast<VkDescriptorSetLayout>(setLayout));
+            DM_ASSERT_MSG(it != setLayoutKeys.end(), "Pipeline layout references a set layout that wasn't recorded");
+            hasher.Add(it->second);
+        }
+    }
+    hasher.Add(layoutCreateInfo.pPushConstantRanges, layoutCreateInfo.pushConstantRangeCount);
+    return hasher.Get();
+}
+
+void PipelineLibrary::RecordShaderModule(vk::ShaderModule module, const vk::ShaderModuleCreateInfo& createInfo)
+{
+    StateHasher hasher;
+    hasher.Add(createInfo.flags).Add(createInfo.codeSize).AddBytes(createInfo.pCode, createInfo.codeSize);
+
+    // A handle reused after its module was destroyed is recorded again with its new code
+    std::lock_guard<std::mutex> lock(partMutex);
+    moduleKeys[static_cast<VkShaderModule>(module)] = hasher.Get();
+}
+
+uint64_t PipelineLibrary::GetStagesKey(const std::vector<vk::PipelineShaderStageCreateInfo>& stages) const
+{
+    StateHasher hasher;
+    hasher.Add(static_cast<uint32_t>(stages.size()));
+    for (const auto& stage : stages)
+    {
+        hasher.Add(stage.flags).Add(stage.stage).Add(stage.pName);
+        {
+            std::lock_guard<std::mutex> lock(partMutex);
+            auto it = moduleKeys.find(static_cast<VkShaderModule>(stage.module));
+            DM_ASSERT_MSG(it != moduleKeys.end(), "Shader stage references a module that wasn't recorded");
+            hasher.Add(it->second);
+        }
+        if (const vk::SpecializationInfo* info = stage.pSpecializationInfo)
+        {
+            hasher.Add(info->pMapEntries, info->mapEntryCount);
+            hasher.Add(info->dataSize).AddBytes(info->pData, info->dataSize);
+        }
+    }
+    return hasher.Get();
+}
+
+void PipelineLibrary::Release(const PartKeys& keys)
+{
+    std::lock_guard<std::mutex> lock(partMutex);
+    for (uint32_t index = 0; index < PartCount; ++index)
+    {
+        auto it = parts[index].find(keys[index]);
+        DM_ASSERT_MSG(it != parts[index].end() && it->second.references > 0, "Releasing a part that isn't referenced");
+        if (--it->second.references == 0)
+        {
+            it->second.lastReleased = ++releaseCount;
+            ++unusedParts;
+        }
+    }
+
+    TrimUnusedParts();
+}
+
+void PipelineLibrary::TrimUnusedParts()
+{
+    // Unreferenced parts are kept for the next pipeline that needs them, the least recently released go first
+    while (unusedParts > maxUnusedParts)
+    {
+        std::unordered_map<uint64_t, Part>* oldestCache = nullptr;
+        std::unordered_map<uint64_t, Part>::iterator oldest;
+        for (auto& cache : parts)
+        {
+            for (auto it = cache.begin(); it != cache.end(); ++it)
+            {
+                if (it->second.references == 0 && (oldestCache == nullptr || it->second.lastReleased < oldest->second.lastReleased))
+                {
+                    oldestCache = &cache;
+                    oldest = it;
+                }
+            }
+        }
+
+        owner->destroyPipeline(oldest->second.pipeline);
+        oldestCache->erase(oldest);
+        --unusedParts;
+    }
+}
+
+PipelineLibrary::Stats PipelineLibrary::GetStats() const
+{
+    std::lock_guard<std::mutex> lock(partMutex);
+    return stats;
+}
+
+}
@@ -0,0 +1,125 @@
+//------------------------------------------------------------------------------
+//
+// File Name:	PipelineLibrary.h
+// Author(s):	Jonathan Bourim (j.bourim)
+// Date:        10/19/2026
+//
+//------------------------------------------------------------------------------
+#pragma once
+
+namespace dm
+{
+
+/**
+ * Builds graphics pipelines from VK_EXT_graphics_pipeline_library parts.
+ * The vertex input, pre-rasterization, fragment shader and fragment output parts
+ * of a pipeline are compiled once and cached by their state, so new variants only
+ * compile the parts that changed. Pipelines are fast linked for immediate use,
+ * and an optimized link is produced on a background thread to replace it.
+ *
+ * Parts are keyed by content rather than handles: shaders by their SPIR-V, layouts by their
+ * set layouts' bindings and push constants, and render passes by what makes them compatible.
+ * Linked pipelines reference their parts until released, after which up to maxUnusedParts
+ * are kept for later links, such as those of pipelines recreated with the swapchain.
+ */
+class PipelineLibrary : public IOwned<Device>
+{
+public:
+DM_TYPE_OWNED_BODY(PipelineLibrary, IOwned<Device>)
+    ~PipelineLibrary() noexcept override;
+
+    enum PartIndex : uint32_t
+    {
+        VertexInput = 0,
+        PreRasterization,
+        FragmentShader,
+        FragmentOutput,
+        PartCount
+    };
+
+    using PartKeys = std::array<uint64_t, PartCount>;
+
+    static constexpr uint32_t maxUnusedParts = 256;   //< Parts no pipeline references, kept for later links
+
+    struct LinkedPipeline
+    {
+        vk::Pipeline pipeline = {};                 //< Fast linked pipeline, usable immediately
+        std::shared_future<vk::Pipeline> optimized; //< Link time optimized pipeline, once the background link completes
+        PartKeys parts = {};                        //< Parts the pipeline references, see Release
+    };
+
+    void Create(Device* inOwner);
+    void Destroy();
+
+    /// \brief Whether the device supports pipeline libraries, when false pipelines must be created directly
+    [[nodiscard]] bool IsEnabled() const { return enabled; }
+
+    /// \brief Links a complete graphics pipeline from cached parts, creating any parts not yet cached.
+    ///        createInfo's state pointers only need to remain valid for the duration of the call.
+    /// \param layoutCreateInfo Description of createInfo.layout, parts are shared between identically defined layouts
+    /// \param renderPassCreateInfo Description of createInfo.renderPass, parts are shared between compatible render passes
+    LinkedPipeline Link(const vk::GraphicsPipelineCreateInfo& createInfo, const vk::PipelineLayoutCreateInfo& layoutCreateInfo,
+                        const vk::RenderPassCreateInfo& renderPassCreateInfo);
+
+    /// \brief Release a linked pipeline's references to its parts, once its optimized link has completed
+    void Release(const PartKeys& keys);
+
+    /// \brief Records the contents of a set layout, so pipeline layouts are keyed by what their set layouts hold
+    void RecordSetLayout(vk::DescriptorSetLayout setLayout, const vk::DescriptorSetLayoutCreateInfo& createInfo);
+
+    /// \brief Records the code of a shader module, so stages are keyed by their SPIR-V
+    void RecordShaderModule(vk::ShaderModule module, const vk::ShaderModuleCreateInfo& createInfo);
+
+    struct Stats
+    {
+        uint32_t partsCreated = 0;
+        uint32_t partsReused = 0;
+        uint32_t fastLinks = 0;
+        uint32_t optimizedLinks = 0;
+    };
+
+    [[nodiscard]] Stats GetStats() const;
+
+private:
+    struct Part
+    {
+        vk::Pipeline pipeline = {};
+        uint32_t references = 0;            //< Linked pipelines not yet released
+        uint64_t lastReleased = 0;          //< Release order once unreferenced, the oldest is destroyed first
+    };
+
+    struct LinkJob
+    {
+        std::array<vk::Pipeline, PartCount> parts;
+        vk::PipelineLayout layout;
+        vk::PipelineCreateFlags flags;
+        std::promise<vk::Pipeline> result;
+    };
+
+    vk::Pipeline GetPart(PartIndex index, uint64_t key, vk::GraphicsPipelineCreateInfo partCreateInfo);
+    vk::Pipeline AddReference(Part& part);
+    uint64_t GetLayoutKey(const vk::PipelineLayoutCreateInfo& layoutCreateInfo) const;
+    uint64_t GetStagesKey(const std::vector<vk::PipelineShaderStageCreateInfo>& stages) const;
+    void TrimUnusedParts();
+    vk::Pipeline LinkParts(const std::array<vk::Pipeline, PartCount>& parts, vk::PipelineLayout layout,
+                           vk::PipelineCreateFlags flags, bool optimize);
+    void RunWorker();
+
+    bool enabled = false;
+
+    std::array<std::unordered_map<uint64_t, Part>, PartCount> parts;
+    std::unordered_map<VkDescriptorSetLayout, uint64_t> setLayoutKeys;
+    std::unordered_map<VkShaderModule, uint64_t> moduleKeys;
+    uint32_t unusedParts = 0;
+    uint64_t releaseCount = 0;
+    mutable std::mutex partMutex;
+    Stats stats;
+
+    std::thread worker;
+    std::queue<LinkJob> jobs;
+    std::mutex jobMutex;
+    std::condition_variable jobCondition;
+    bool stopWorker = false;
+};
+
+}
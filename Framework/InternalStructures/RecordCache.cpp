@@ -0,0 +1,139 @@
+//------------------------------------------------------------------------------
+//
+// File Name:	RecordCache.cpp
+// Author(s):	Jonathan Bourim (j.bourim)
+// Date:        10/19/2026
+//
+//------------------------------------------------------------------------------
+
+#include "RecordCache.h"
+
+namespace dm
+{
+
+namespace
+{
+
+// 64 bit FNV-1a
+constexpr uint64_t FingerprintBasis = 14695981039346656037ull;
+constexpr uint64_t FingerprintPrime = 1099511628211ull;
+
+}
+
+void RecordCache::Create(uint32_t imageCount)
+{
+    fingerprints.assign(imageCount, 0);
+    valid.assign(imageCount, false);
+    imageIndex = -1;
+    forceRecord = false;
+    stats = {};
+}
+
+void RecordCache::Begin(int inImageIndex)
+{
+    DM_ASSERT_MSG(inImageIndex >= 0 && inImageIndex < (int) valid.size(), "Record cache image index out of range");
+    imageIndex = inImageIndex;
+    fingerprint = FingerprintBasis;
+    forceRecord = false;
+}
+
+void RecordCache::TrackBytes(const void* data, size_t size)
+{
+    DM_ASSERT_MSG(IsTracking(), "Record cache inputs must be tracked after Begin");
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < size; ++i)
+        fingerprint = (fingerprint ^ bytes[i]) * FingerprintPrime;
+
+    // Separates inputs, so adjacent values can't shift bytes between each other
+    fingerprint = (fingerprint ^ size) * FingerprintPrime;
+}
+
+void RecordCache::InvalidateAll()
+{
+    std::fill(valid.begin(), valid.end(), false);
+}
+
+bool RecordCache::NeedsRecord()
+{
+    DM_ASSERT_MSG(IsTracking(), "Record cache must Begin an image before checking it");
+    if (forceRecord || !valid[imageIndex] || fingerprints[imageIndex] != fingerprint)
+        return true;
+
+    ++stats.reused;
+    imageIndex = -1;
+    return false;
+}
+
+void RecordCache::Recorded()
+{
+    DM_ASSERT_MSG(IsTracking(), "Record cache must Begin an image before it's recorded");
+
+    // Replaying forced work, such as uploads of unchanged staging data, is harmless so the recording stays reusable
+    fingerprints[imageIndex] = fingerprint;
+    valid[imageIndex] = true;
+    ++stats.recorded;
+    imageIndex = -1;
+}
+
+SecondaryCommandCache::~SecondaryCommandCache() noexcept
+{
+    Destroy();
+}
+
+void SecondaryCommandCache::Create(CommandPool* inOwner)
+{
+    IOwned<CommandPool>::CreateOwned(inOwner);
+
+    vk::CommandBufferAllocateInfo allocateInfo = {};
+    allocateInfo.commandPool = owner->VkType();
+    allocateInfo.level = vk::CommandBufferLevel::eSecondary;
+    allocateInfo.commandBufferCount = OwnerGet<Device>().ImageCount();
+    commandBuffers.Create(allocateInfo, inOwner);
+    cache.Create(allocateInfo.commandBufferCount);
+}
+
+void SecondaryCommandCache::Destroy()
+{
+    if (created)
+    {
+        commandBuffers.Destroy();
+        created = false;
+    }
+}
+
+void SecondaryCommandCache::Begin(int inImageIndex, vk::RenderPass renderPass, uint32_t subpass, vk::Framebuffer framebuffer)
+{
+    imageIndex = inImageIndex;
+    inheritance = vk::CommandBufferInheritanceInfo(renderPass, subpass, framebuffer);
+
+    cache.Begin(imageIndex);
+    cache.Track(renderPass);
+    cache.Track(subpass);
+    cache.Track(framebuffer);
+}
+
+vk::CommandBuffer SecondaryCommandCache::Record()
+{
+    DM_ASSERT_MSG(cache.IsTracking(), "Secondary command buffers are only recorded after NeedsRecord returns true");
+
+    vk::CommandBuffer commandBuffer = commandBuffers[imageIndex];
+    vk::CommandBufferBeginInfo beginInfo = {};
+    beginInfo.flags = vk::CommandBufferUsageFlagBits::eRenderPassContinue;
+    beginInfo.pInheritanceInfo = &inheritance;
+    DM_ASSERT_VK(commandBuffer.begin(&beginInfo));
+    return commandBuffer;
+}
+
+void SecondaryCommandCache::End()
+{
+    commandBuffers[imageIndex].end();
+    cache.Recorded();
+}
+
+void SecondaryCommandCache::Execute(vk::CommandBuffer primary)
+{
+    DM_ASSERT_MSG(imageIndex >= 0, "Secondary command cache must Begin an image before executing it");
+    primary.executeCommands(1, &commandBuffers[imageIndex]);
+}
+
+}
@@ -0,0 +1,146 @@
+//------------------------------------------------------------------------------
+//
+// File Name:	RecordCache.h
+// Author(s):	Jonathan Bourim (j.bourim)
+// Date:        10/19/2026
+//
+//------------------------------------------------------------------------------
+#pragma once
+
+namespace dm
+{
+
+/**
+ * Skips recording a per image command buffer when nothing it depends on changed since it was
+ * last recorded for that image, so the previous recording is submitted again.
+ *
+ * Each frame, Begin the image, Track every input the recording reads, then check NeedsRecord:
+ *
+ *     cache.Begin(imageIndex);
+ *     cache.Track(mesh);
+ *     cache.Track(uniforms, imageIndex);
+ *     if (cache.NeedsRecord())
+ *     {
+ *         ...record...
+ *         cache.Recorded();
+ *     }
+ *
+ * Inputs are folded into a fingerprint compared against the image's last recording. Anything recorded
+ * that isn't tracked, such as per frame push constants, must be tracked by value or Invalidate the cache.
+ */
+class RecordCache
+{
+public:
+    struct Stats
+    {
+        uint32_t recorded = 0;
+        uint32_t reused = 0;
+    };
+
+    void Create(uint32_t imageCount);
+
+    /// \brief Start declaring the inputs of imageIndex's recording
+    void Begin(int imageIndex);
+
+    /// \brief Track a value or Vulkan handle by its bytes
+    template<class T>
+    void Track(const T& value)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "Tracked values are compared by their bytes");
+        TrackBytes(&value, sizeof(T));
+    }
+
+    /// \brief Track the buffers and ranges a mesh draws from.
+    ///        Meshes with data waiting to be staged force a record, as staging is recorded with the draws.
+    template<class VertexType>
+    void Track(const Mesh<VertexType>& mesh)
+    {
+        Track(mesh.GetVertexBufferHandle());
+        Track(mesh.GetAttributeBufferHandle());
+        Track(mesh.GetIndexBufferHandle());
+        Track(mesh.GetVertexOffset());
+        Track(mesh.GetFirstIndex());
+        Track(mesh.GetVertexCount());
+        Track(mesh.GetIndexCount());
+        if (mesh.IsPooled())
+            Track(mesh.geometry.GetPool()->GetGeneration());
+        else if (mesh.vertexBuffer.dirty || mesh.indexBuffer.dirty)
+            Invalidate();
+    }
+
+    /// \brief Track a uniform set's descriptor set and its descriptor writes.
+    ///        Sets with uniform data waiting to be uploaded force a record, as uploads are recorded with the draws.
+    template<class Pipeline, DescriptorSetIndex SetIndex>
+    void Track(const UniformSet<Pipeline, SetIndex>& uniforms, int imageIndex)
+    {
+        Track(uniforms.GetSet(imageIndex));
+        Track(uniforms.GetVersion(imageIndex));
+        if (uniforms.HasPendingUpload(imageIndex))
+            Invalidate();
+    }
+
+    /// \brief Force the current image to be recorded
+    void Invalidate() { forceRecord = true; }
+
+    /// \brief Force every image to be recorded, e.g. after resources were recreated and may reuse handles
+    void InvalidateAll();
+
+    /// \brief Whether the current image's inputs differ from its last recording, counting the image as reused if not
+    [[nodiscard]] bool NeedsRecord();
+
+    /// \brief Mark the current image as recorded with the inputs tracked since Begin
+    void Recorded();
+
+    /// \brief Whether an image began tracking and hasn't been recorded or found unchanged since
+    [[nodiscard]] bool IsTracking() const { return imageIndex >= 0; }
+
+    [[nodiscard]] const Stats& GetStats() const { return stats; }
+    void ResetStats() { stats = {}; }
+
+private:
+    void TrackBytes(const void* data, size_t size);
+
+    ImageAsync<uint64_t> fingerprints;
+    ImageAsync<bool> valid;
+    uint64_t fingerprint = 0;
+    int imageIndex = -1;
+    bool forceRecord = false;
+    Stats stats;
+};
+
+/**
+ * Per image secondary command buffers for a static sub-range of a render pass, recorded only when the
+ * inputs tracked in their RecordCache change, so the primary command buffer can be re-recorded every
+ * frame around them. The subpass must begin with vk::SubpassContents::eSecondaryCommandBuffers.
+ */
+class SecondaryCommandCache : public IOwned<CommandPool>
+{
+public:
+DM_TYPE_OWNED_BODY(SecondaryCommandCache, IOwned<CommandPool>)
+    ~SecondaryCommandCache() noexcept override;
+
+    void Create(CommandPool* inOwner);
+    void Destroy();
+
+    /// \brief Start tracking imageIndex's inputs, tracking the render pass state the recording inherits.
+    ///        Track any further inputs through Inputs() before NeedsRecord.
+    void Begin(int imageIndex, vk::RenderPass renderPass, uint32_t subpass, vk::Framebuffer framebuffer);
+
+    [[nodiscard]] RecordCache& Inputs() { return cache; }
+    [[nodiscard]] bool NeedsRecord() { return cache.NeedsRecord(); }
+
+    /// \brief Begin recording the current image's secondary command buffer, only when NeedsRecord
+    vk::CommandBuffer Record();
+    void End();
+
+    /// \brief Execute the current image's secondary command buffer from the primary command buffer
+    void Execute(vk::CommandBuffer primary);
+
+private:
+    CommandBufferVector commandBuffers;
+    RecordCache cache;
+    vk::CommandBufferInheritanceInfo inheritance = {};
+    int imageIndex = -1;
+};
+
+}
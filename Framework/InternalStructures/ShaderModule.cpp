@@ -10,17 +10,32 @@ namespace dm
 
 vk::PipelineShaderStageCreateInfo ShaderModule::Load(const std::string& path, vk::ShaderStageFlagBits stageFlags, Device* inOwner)
 {
+	if (const EmbeddedShader* embedded = EmbeddedShaders::Find(path))
+		return Load(*embedded, stageFlags, inOwner);
+
+	auto src = utils::ReadFile(path);
+	EmbeddedShader shader = {};
+	shader.path = path;
+	shader.code = reinterpret_cast<const uint32_t*>(src.data());
+	shader.wordCount = src.size() / sizeof(uint32_t);
+	return Load(shader, stageFlags, inOwner);
+}
+
+vk::PipelineShaderStageCreateInfo ShaderModule::Load(const EmbeddedShader& shader, vk::ShaderStageFlagBits stageFlags, Device* inOwner)
+{
+	DM_ASSERT_MSG(!shader.stage || shader.stage == stageFlags,
+				  ("Shader " + std::string(shader.path) + " is loaded as a different stage than it was built for").c_str());
+
 	if (created)
 	{
 		owner->destroyShaderModule(VkType());
 	}
 
-	auto src = utils::ReadFile(path);
-
 	vk::ShaderModuleCreateInfo shaderInfo;
-	shaderInfo.codeSize = src.size();
-	shaderInfo.pCode = reinterpret_cast<const uint32_t*>(src.data());
+	shaderInfo.codeSize = shader.Size();
+	shaderInfo.pCode = shader.code;
 	Create(shaderInfo, inOwner);
+	owner->PipelineLibrary().RecordShaderModule(VkType(), shaderInfo);
 	stage = stageFlags;
 
 	return vk::PipelineShaderStageCreateInfo(
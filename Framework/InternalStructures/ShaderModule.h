@@ -17,12 +17,19 @@ DM_TYPE_VULKAN_OWNED_BODY(ShaderModule, IOwned<Device>)
 DM_TYPE_VULKAN_OWNED_GENERIC(ShaderModule, ShaderModule)
 
 
+	// Loads from the shader embedded under path when there is one, otherwise from disk
 	vk::PipelineShaderStageCreateInfo Load(
 		const std::string& path,
 		vk::ShaderStageFlagBits stageFlags,
 		Device* inOwner
 	);
 
+	vk::PipelineShaderStageCreateInfo Load(
+		const EmbeddedShader& shader,
+		vk::ShaderStageFlagBits stageFlags,
+		Device* inOwner
+	);
+
 	vk::ShaderStageFlagBits stage = {};
 };
 
@@ -0,0 +1,560 @@
+//------------------------------------------------------------------------------
+//
+// File Name:	ShaderReflection.cpp
+// Author(s):	Jonathan Bourim (j.bourim)
+// Date:		10/19/2026
+//
+//------------------------------------------------------------------------------
+#include "ShaderReflection.h"
+
+namespace dm
+{
+
+void ReflectSpecializationConstants(
+    const uint32_t* code,
+    size_t wordCount,
+    vk::ShaderStageFlagBits stage,
+    std::vector<SpecializationConstantData>& constants
+)
+{
+    // SPIR-V-Reflect doesn't expose specialization constants, so walk the instruction stream ourselves
+    DM_ASSERT_MSG(wordCount > 5 && code[0] == SpvMagicNumber, "Attempting to reflect an invalid SPIR-V module");
+
+    struct ScalarType
+    {
+        uint32_t width = 0;
+        SpecializationConstantType type = SpecializationConstantType::UInt;
+    };
+
+    struct Constant
+    {
+        uint32_t typeID = 0;
+        uint64_t defaultValue = 0;
+        bool found = false;
+    };
+
+    std::unordered_map<uint32_t, std::string> names;
+    std::unordered_map<uint32_t, uint32_t> specIDs;
+    std::unordered_map<uint32_t, ScalarType> types;
+    std::unordered_map<uint32_t, Constant> values;
+
+    // Skip the header (magic, version, generator, bound, schema)
+    size_t i = 5;
+    while (i < wordCount)
+    {
+        const uint32_t instruction = code[i];
+        const uint32_t length = instruction >> 16u;
+        const auto opcode = static_cast<SpvOp>(instruction & 0xFFFFu);
+        DM_ASSERT_MSG(length > 0 && i + length <= wordCount, "Malformed SPIR-V instruction while reflecting");
+
+        const uint32_t* operands = code + i + 1;
+        switch (opcode)
+        {
+            case SpvOpName:
+                names[operands[0]] = reinterpret_cast<const char*>(operands + 1);
+                break;
+            case SpvOpDecorate:
+                if (operands[1] == SpvDecorationSpecId)
+                    specIDs[operands[0]] = operands[2];
+                break;
+            case SpvOpTypeBool:
+                // Booleans are passed as VkBool32
+                types[operands[0]] = { 32, SpecializationConstantType::Bool };
+                break;
+            case SpvOpTypeInt:
+                types[operands[0]] = { operands[1], operands[2] != 0 ? SpecializationConstantType::SInt
+                                                                     : SpecializationConstantType::UInt };
+                break;
+            case SpvOpTypeFloat:
+                types[operands[0]] = { operands[1], SpecializationConstantType::Float };
+                break;
+            case SpvOpSpecConstantTrue:
+            case SpvOpSpecConstantFalse:
+                values[operands[1]] = { operands[0], opcode == SpvOpSpecConstantTrue ? 1u : 0u, true };
+                break;
+            case SpvOpSpecConstant:
+            {
+                Constant& constant = values[operands[1]];
+                constant.typeID = operands[0];
+                constant.defaultValue = operands[2];
+                // 64-bit literals span two words, low order first
+                if (length > 4)
+                    constant.defaultValue |= static_cast<uint64_t>(operands[3]) << 32u;
+                constant.found = true;
+                break;
+            }
+            // Types and constants are fully declared before any function body
+            case SpvOpFunction:
+                i = wordCount;
+                continue;
+            default:
+                break;
+        }
+
+        i += length;
+    }
+
+    for (auto& [resultID, specID] : specIDs)
+    {
+        auto valueIt = values.find(resultID);
+        if (valueIt == values.end() || !valueIt->second.found)
+            continue;
+
+        auto typeIt = types.find(valueIt->second.typeID);
+        DM_ASSERT_MSG(typeIt != types.end(), "Specialization constant declared with a non-scalar type");
+        const uint32_t size = typeIt->second.width / 8;
+
+        auto existing = std::find_if(constants.begin(), constants.end(),
+                                     [id = specID](const SpecializationConstantData& data)
+                                     {
+                                         return data.constantID == id;
+                                     });
+
+        // Same constant declared in another stage, mask the stage in and validate it agrees
+        if (existing != constants.end())
+        {
+            DM_ASSERT_MSG(existing->size == size && existing->type == typeIt->second.type,
+                          "Specialization constant shares an ID across stages with a different type");
+            existing->stageFlags |= stage;
+            continue;
+        }
+
+        SpecializationConstantData& data = constants.emplace_back();
+        auto nameIt = names.find(resultID);
+        data.name = nameIt != names.end() ? nameIt->second : std::string();
+        data.constantID = specID;
+        data.size = size;
+        data.type = typeIt->second.type;
+        data.stageFlags = stage;
+        data.defaultValue = valueIt->second.defaultValue;
+    }
+
+    std::sort(constants.begin(), constants.end(),
+              [](const SpecializationConstantData& a, const SpecializationConstantData& b)
+              {
+                  return a.constantID < b.constantID;
+              });
+}
+
+static vk::Format GetInputFormat(VertexNumericType numericType, uint32_t componentCount, uint32_t width)
+{
+    static constexpr vk::Format floatFormats[] = {
+        vk::Format::eR32Sfloat, vk::Format::eR32G32Sfloat, vk::Format::eR32G32B32Sfloat, vk::Format::eR32G32B32A32Sfloat
+    };
+    static constexpr vk::Format sintFormats[] = {
+        vk::Format::eR32Sint, vk::Format::eR32G32Sint, vk::Format::eR32G32B32Sint, vk::Format::eR32G32B32A32Sint
+    };
+    static constexpr vk::Format uintFormats[] = {
+        vk::Format::eR32Uint, vk::Format::eR32G32Uint, vk::Format::eR32G32B32Uint, vk::Format::eR32G32B32A32Uint
+    };
+    static constexpr vk::Format halfFormats[] = {
+        vk::Format::eR16Sfloat, vk::Format::eR16G16Sfloat, vk::Format::eR16G16B16Sfloat, vk::Format::eR16G16B16A16Sfloat
+    };
+    static constexpr vk::Format shortFormats[] = {
+        vk::Format::eR16Sint, vk::Format::eR16G16Sint, vk::Format::eR16G16B16Sint, vk::Format::eR16G16B16A16Sint
+    };
+    static constexpr vk::Format ushortFormats[] = {
+        vk::Format::eR16Uint, vk::Format::eR16G16Uint, vk::Format::eR16G16B16Uint, vk::Format::eR16G16B16A16Uint
+    };
+
+    DM_ASSERT_MSG(componentCount >= 1 && componentCount <= 4, "Shader input with an unsupported component count");
+    const bool narrow = width == 16;
+    switch (numericType)
+    {
+        case VertexNumericType::SInt:
+            return (narrow ? shortFormats : sintFormats)[componentCount - 1];
+        case VertexNumericType::UInt:
+            return (narrow ? ushortFormats : uintFormats)[componentCount - 1];
+        default:
+            return (narrow ? halfFormats : floatFormats)[componentCount - 1];
+    }
+}
+
+void ReflectVertexInputs(const spv_reflect::ShaderModule& shaderModule, std::vector<VertexInputData>& inputs)
+{
+    uint32_t count = 0;
+    auto result = shaderModule.EnumerateInputVariables(&count, nullptr);
+    DM_ASSERT(result == SPV_REFLECT_RESULT_SUCCESS);
+
+    std::vector<SpvReflectInterfaceVariable*> inputVariables(count);
+    result = shaderModule.EnumerateInputVariables(&count, inputVariables.data());
+    DM_ASSERT(result == SPV_REFLECT_RESULT_SUCCESS);
+
+    for (const SpvReflectInterfaceVariable* var : inputVariables)
+    {
+        // gl_VertexIndex, gl_InstanceIndex etc. aren't fed by vertex buffers
+        if (var->decoration_flags & SPV_REFLECT_DECORATION_BUILT_IN)
+            continue;
+
+        const SpvReflectTypeDescription& type = *var->type_description;
+        // Declared layouts may feed 32-bit inputs from narrower normalized, half or integer formats,
+        // 16-bit inputs need storageInputOutput16
+        const uint32_t width = var->numeric.scalar.width;
+        DM_ASSERT_MSG(width == 32 || width == 16, "Only 16 and 32-bit shader inputs are supported as vertex attributes");
+
+        VertexNumericType numericType = VertexNumericType::Float;
+        if (!(type.type_flags & SPV_REFLECT_TYPE_FLAG_FLOAT))
+            numericType = var->numeric.scalar.signedness ? VertexNumericType::SInt : VertexNumericType::UInt;
+
+        // Scalars report 0 components, matrices consume a location per column
+        uint32_t componentCount = std::max(var->numeric.vector.component_count, 1u);
+        uint32_t columnCount = 1;
+        if (type.type_flags & SPV_REFLECT_TYPE_FLAG_MATRIX)
+        {
+            componentCount = var->numeric.matrix.row_count;
+            columnCount = var->numeric.matrix.column_count;
+        }
+
+        uint32_t elementCount = 1;
+        for (uint32_t i_dim = 0; i_dim < var->array.dims_count; ++i_dim)
+            elementCount *= var->array.dims[i_dim];
+
+        const bool instanced = strncmp(var->name, "i_", 2) == 0;
+        const vk::Format format = GetInputFormat(numericType, componentCount, width);
+        for (uint32_t location = 0; location < elementCount * columnCount; ++location)
+        {
+            VertexInputData& input = inputs.emplace_back();
+            input.name = var->name;
+            input.location = var->location + location;
+            input.format = format;
+            input.numericType = numericType;
+            input.inputRate = instanced ? vk::VertexInputRate::eInstance : vk::VertexInputRate::eVertex;
+        }
+    }
+
+    std::sort(inputs.begin(), inputs.end(),
+              [](const VertexInputData& a, const VertexInputData& b)
+              {
+                  return a.location < b.location;
+              });
+}
+
+void BuildVertexInputLayout(
+    const std::vector<VertexInputData>& inputs,
+    const VertexAttributes& vertexAttributes,
+    uint32_t vertexStride,
+    uint32_t positionStride,
+    const VertexAttributes& instanceAttributes,
+    uint32_t instanceStride,
+    std::vector<vk::VertexInputBindingDescription>& bindings,
+    std::vector<vk::VertexInputAttributeDescription>& attributes
+)
+{
+    struct Stream
+    {
+        vk::VertexInputRate inputRate;
+        VertexBindingIndex binding;
+        const VertexAttributes& declared;
+        uint32_t declaredStride;
+    };
+
+    const Stream streams[] = {
+        { vk::VertexInputRate::eVertex, VertexStream, vertexAttributes, vertexStride },
+        { vk::VertexInputRate::eInstance, InstanceStream, instanceAttributes, instanceStride }
+    };
+
+    for (const Stream& stream : streams)
+    {
+        // Inputs are sorted, the first of each rate is the structure's first attribute
+        auto first = std::find_if(inputs.begin(), inputs.end(),
+                                  [&stream](const VertexInputData& input)
+                                  {
+                                      return input.inputRate == stream.inputRate;
+                                  });
+        if (first == inputs.end())
+            continue;
+
+        const bool declared = stream.declaredStride != 0;
+        const bool split = stream.binding == VertexStream && positionStride != 0;
+        DM_ASSERT_MSG(!split || declared, "Only declared vertex layouts can be split");
+        const uint32_t baseLocation = first->location;
+        uint32_t packedOffset = 0;
+        bool readsAttributes = false;
+
+        for (auto it = first; it != inputs.end(); ++it)
+        {
+            const VertexInputData& input = *it;
+            if (input.inputRate != stream.inputRate)
+                continue;
+
+            vk::VertexInputAttributeDescription& desc = attributes.emplace_back();
+            desc.binding = stream.binding;
+            desc.location = input.location;
+
+            if (declared)
+            {
+                const uint32_t index = input.location - baseLocation;
+                DM_ASSERT_MSG(index < stream.declared.size(),
+                              ("Shader input " + input.name + " has no matching attribute in the declared layout").c_str());
+
+                const VertexAttribute& attribute = stream.declared[index];
+                DM_ASSERT_MSG(GetFormatNumericType(attribute.format) == input.numericType,
+                              ("Declared format for " + input.name + " doesn't match the shader input's numeric type").c_str());
+                DM_ASSERT_MSG(attribute.offset + GetFormatSize(attribute.format) <= stream.declaredStride,
+                              ("Declared attribute for " + input.name + " lies outside of its structure").c_str());
+
+                desc.format = attribute.format;
+                desc.offset = attribute.offset;
+
+                if (split && index == 0)
+                {
+                    DM_ASSERT_MSG(attribute.offset + GetFormatSize(attribute.format) <= positionStride,
+                                  ("Split position " + input.name + " lies outside of the position stream").c_str());
+                }
+                else if (split)
+                {
+                    DM_ASSERT_MSG(attribute.offset >= positionStride,
+                                  ("Split attribute " + input.name + " overlaps the position stream").c_str());
+                    desc.binding = AttributeStream;
+                    desc.offset = attribute.offset - positionStride;
+                    readsAttributes = true;
+                }
+            }
+            else
+            {
+                // No declared structure, so pack tightly in location order
+                desc.format = input.format;
+                desc.offset = packedOffset;
+                packedOffset += GetFormatSize(input.format);
+            }
+        }
+
+        vk::VertexInputBindingDescription& binding = bindings.emplace_back();
+        binding.binding = stream.binding;
+        binding.stride = split ? positionStride : declared ? stream.declaredStride : packedOffset;
+        binding.inputRate = stream.inputRate;
+
+        // Position only pipelines leave the attribute stream unbound
+        if (readsAttributes)
+        {
+            vk::VertexInputBindingDescription& attributeBinding = bindings.emplace_back();
+            attributeBinding.binding = AttributeStream;
+            attributeBinding.stride = stream.declaredStride - positionStride;
+            attributeBinding.inputRate = stream.inputRate;
+        }
+    }
+}
+
+void ReflectPushConstants(
+    const spv_reflect::ShaderModule& shaderModule,
+    vk::ShaderStageFlagBits stage,
+    PushConstantBlockData& block
+)
+{
+    uint32_t count = 0;
+    auto result = shaderModule.EnumeratePushConstantBlocks(&count, nullptr);
+    DM_ASSERT(result == SPV_REFLECT_RESULT_SUCCESS);
+    if (count == 0)
+        return;
+
+    DM_ASSERT_MSG(count == 1, "Only a single push constant block is allowed per shader stage");
+    SpvReflectBlockVariable* reflectedBlock = nullptr;
+    result = shaderModule.EnumeratePushConstantBlocks(&count, &reflectedBlock);
+    DM_ASSERT(result == SPV_REFLECT_RESULT_SUCCESS);
+
+    if (block.name.empty() && reflectedBlock->name != nullptr)
+        block.name = reflectedBlock->name;
+    block.stageFlags |= stage;
+
+    for (uint32_t i_member = 0; i_member < reflectedBlock->member_count; ++i_member)
+    {
+        const SpvReflectBlockVariable& reflectedMember = reflectedBlock->members[i_member];
+        auto it = std::find_if(block.members.begin(), block.members.end(),
+                               [&reflectedMember](const PushConstantMemberData& member)
+                               {
+                                   return member.offset == reflectedMember.offset;
+                               });
+
+        // Member already declared by another stage, the stages must agree on what lives there
+        if (it != block.members.end())
+        {
+            DM_ASSERT_MSG(it->size == reflectedMember.size,
+                          ("Push constant member " + it->name + " differs in size between shader stages").c_str());
+            continue;
+        }
+
+        PushConstantMemberData& member = block.members.emplace_back();
+        member.name = reflectedMember.name != nullptr ? reflectedMember.name : std::string();
+        member.offset = reflectedMember.offset;
+        member.size = reflectedMember.size;
+    }
+
+    std::sort(block.members.begin(), block.members.end(),
+              [](const PushConstantMemberData& a, const PushConstantMemberData& b)
+              {
+                  return a.offset < b.offset;
+              });
+
+    // Range spans from the first to the end of the last member in use by any stage
+    if (!block.members.empty())
+    {
+        const PushConstantMemberData& last = block.members.back();
+        block.offset = block.members.front().offset;
+        block.size = last.offset + last.size - block.offset;
+    }
+}
+
+uint32_t GetFormatSize(vk::Format format)
+{
+    switch (format)
+    {
+        case vk::Format::eR8Unorm:
+        case vk::Format::eR8Snorm:
+        case vk::Format::eR8Uint:
+        case vk::Format::eR8Sint:
+            return 1;
+        case vk::Format::eR8G8Unorm:
+        case vk::Format::eR8G8Snorm:
+        case vk::Format::eR8G8Uint:
+        case vk::Format::eR8G8Sint:
+        case vk::Format::eR16Unorm:
+        case vk::Format::eR16Snorm:
+        case vk::Format::eR16Uint:
+        case vk::Format::eR16Sint:
+        case vk::Format::eR16Sfloat:
+            return 2;
+        case vk::Format::eR8G8B8Unorm:
+        case vk::Format::eR8G8B8Snorm:
+        case vk::Format::eR8G8B8Uint:
+        case vk::Format::eR8G8B8Sint:
+            return 3;
+        case vk::Format::eR8G8B8A8Unorm:
+        case vk::Format::eR8G8B8A8Snorm:
+        case vk::Format::eR8G8B8A8Uint:
+        case vk::Format::eR8G8B8A8Sint:
+        case vk::Format::eB8G8R8A8Unorm:
+        case vk::Format::eA2B10G10R10UnormPack32:
+        case vk::Format::eA2B10G10R10SnormPack32:
+        case vk::Format::eR16G16Unorm:
+        case vk::Format::eR16G16Snorm:
+        case vk::Format::eR16G16Uint:
+        case vk::Format::eR16G16Sint:
+        case vk::Format::eR16G16Sfloat:
+        case vk::Format::eR32Uint:
+        case vk::Format::eR32Sint:
+        case vk::Format::eR32Sfloat:
+            return 4;
+        case vk::Format::eR16G16B16Unorm:
+        case vk::Format::eR16G16B16Snorm:
+        case vk::Format::eR16G16B16Uint:
+        case vk::Format::eR16G16B16Sint:
+        case vk::Format::eR16G16B16Sfloat:
+            return 6;
+        case vk::Format::eR16G16B16A16Unorm:
+        case vk::Format::eR16G16B16A16Snorm:
+        case vk::Format::eR16G16B16A16Uint:
+        case vk::Format::eR16G16B16A16Sint:
+        case vk::Format::eR16G16B16A16Sfloat:
+        case vk::Format::eR32G32Uint:
+        case vk::Format::eR32G32Sint:
+        case vk::Format::eR32G32Sfloat:
+            return 8;
+        case vk::Format::eR32G32B32Uint:
+        case vk::Format::eR32G32B32Sint:
+        case vk::Format::eR32G32B32Sfloat:
+            return 12;
+        case vk::Format::eR32G32B32A32Uint:
+        case vk::Format::eR32G32B32A32Sint:
+        case vk::Format::eR32G32B32A32Sfloat:
+            return 16;
+        default:
+            DM_ASSERT_MSG(false, "Unsupported vertex attribute format");
+            return 0;
+    }
+}
+
+VertexNumericType GetFormatNumericType(vk::Format format)
+{
+    switch (format)
+    {
+        case vk::Format::eR8Sint:
+        case vk::Format::eR8G8Sint:
+        case vk::Format::eR8G8B8Sint:
+        case vk::Format::eR8G8B8A8Sint:
+        case vk::Format::eR16Sint:
+        case vk::Format::eR16G16Sint:
+        case vk::Format::eR16G16B16Sint:
+        case vk::Format::eR16G16B16A16Sint:
+        case vk::Format::eR32Sint:
+        case vk::Format::eR32G32Sint:
+        case vk::Format::eR32G32B32Sint:
+        case vk::Format::eR32G32B32A32Sint:
+            return VertexNumericType::SInt;
+        case vk::Format::eR8Uint:
+        case vk::Format::eR8G8Uint:
+        case vk::Format::eR8G8B8Uint:
+        case vk::Format::eR8G8B8A8Uint:
+        case vk::Format::eR16Uint:
+        case vk::Format::eR16G16Uint:
+        case vk::Format::eR16G16B16Uint:
+        case vk::Format::eR16G16B16A16Uint:
+        case vk::Format::eR32Uint:
+        case vk::Format::eR32G32Uint:
+        case vk::Format::eR32G32B32Uint:
+        case vk::Format::eR32G32B32A32Uint:
+            return VertexNumericType::UInt;
+        default:
+            // Float, normalized and scaled formats are all read as floating point
+            return VertexNumericType::Float;
+    }
+}
+
+void SpecializationConstants::Create(const std::vector<SpecializationConstantData>& inReflection)
+{
+    reflection = &inReflection;
+    entries.clear();
+    data.clear();
+
+    // Lay every constant out tightly, initialized with the shader's default values
+    uint32_t offset = 0;
+    for (const auto& constant : inReflection)
+    {
+        auto& entry = entries.emplace_back();
+        entry.constantID = constant.constantID;
+        entry.offset = offset;
+        entry.size = constant.size;
+        offset += constant.size;
+    }
+
+    data.resize(offset);
+    for (size_t i = 0; i < entries.size(); ++i)
+    {
+        // Little endian, the low order bytes hold the value for 32-bit constants
+        std::memcpy(data.data() + entries[i].offset, &inReflection[i].defaultValue, entries[i].size);
+    }
+}
+
+const vk::SpecializationInfo* SpecializationConstants::GetInfo() const
+{
+    if (IsEmpty())
+        return nullptr;
+
+    // Pointed at the vectors on every call, so copies and moves never hand out another object's storage
+    info.mapEntryCount = static_cast<uint32_t>(entries.size());
+    info.pMapEntries = entries.data();
+    info.dataSize = data.size();
+    info.pData = data.data();
+    return &info;
+}
+
+uint32_t SpecializationConstants::FindConstant(const std::string& name) const
+{
+    DM_ASSERT_MSG(reflection, "Specialization constants used before the shader was reflected");
+
+    auto it = std::find_if(reflection->begin(), reflection->end(),
+                           [&name](const SpecializationConstantData& constant)
+                           {
+                               return constant.name == name;
+                           });
+    DM_ASSERT_MSG(it != reflection->end(), ("No specialization constant named " + name).c_str());
+
+    return it->constantID;
+}
+
+void SpecializationConstants::Write(const vk::SpecializationMapEntry& entry, const void* value, size_t size)
+{
+    DM_ASSERT_MSG(entry.size == size, "Specialization constant value doesn't match the size declared in the shader");
+    std::memcpy(data.data() + entry.offset, value, size);
+}
+
+}
@@ -0,0 +1,256 @@
+//------------------------------------------------------------------------------
+//
+// File Name:	ShaderReflection.h
+// Author(s):	Jonathan Bourim (j.bourim)
+// Date:        10/19/2026
+//
+//------------------------------------------------------------------------------
+#pragma once
+#include "spirv_reflect/spirv_reflect.h"
+
+namespace dm
+{
+
+enum class VertexNumericType
+{
+    Float,  //< Float, normalized and scaled formats
+    SInt,
+    UInt
+};
+
+struct VertexInputData
+{
+    std::string name;
+    uint32_t location = 0;                          //< Location of this element, matrices produce one per column
+    vk::Format format = vk::Format::eUndefined;     //< Format as consumed by the shader
+    VertexNumericType numericType = VertexNumericType::Float;
+    vk::VertexInputRate inputRate = vk::VertexInputRate::eVertex;
+};
+
+struct PushConstantMemberData
+{
+    std::string name;
+    uint32_t offset = 0;    //< Byte offset from the start of the block
+    uint32_t size = 0;
+};
+
+/**
+ * The pipeline's push constant block. Every stage aliases the same push constant memory,
+ * so blocks from each stage are merged into a single range visible to all of them.
+ */
+struct PushConstantBlockData
+{
+    std::string name;
+    uint32_t offset = 0;                    //< Offset of the first member used by any stage
+    uint32_t size = 0;                      //< Byte size from offset to the end of the last member, 0 if there is no block
+    vk::ShaderStageFlags stageFlags = {};   //< Every stage declaring the block
+    std::vector<PushConstantMemberData> members;
+
+    [[nodiscard]] bool IsEmpty() const { return size == 0; }
+    [[nodiscard]] vk::PushConstantRange GetRange() const { return { stageFlags, offset, size }; }
+};
+
+enum class SpecializationConstantType
+{
+    Bool,
+    SInt,
+    UInt,
+    Float
+};
+
+struct SpecializationConstantData
+{
+    std::string name;
+    uint32_t constantID = 0;
+    uint32_t size = 0;                      //< Byte size of the constant, booleans are VkBool32 sized
+    SpecializationConstantType type = SpecializationConstantType::UInt;
+    vk::ShaderStageFlags stageFlags = {};   //< Every stage declaring the constant
+    uint64_t defaultValue = 0;              //< Raw bits of the default value declared in the shader
+};
+
+/// \brief Reflects every OpSpecConstant* decorated with a SpecId from a SPIR-V module,
+///        merging the results into constants (matching IDs across stages are combined).
+/// \param code SPIR-V words
+/// \param wordCount Number of words in code
+/// \param stage Stage of the module, masked into the stage flags of each found constant
+/// \param constants Output list of specialization constants, sorted by constant ID
+void ReflectSpecializationConstants(
+    const uint32_t* code,
+    size_t wordCount,
+    vk::ShaderStageFlagBits stage,
+    std::vector<SpecializationConstantData>& constants
+);
+
+/// \brief Reflects the vertex shader's input locations, skipping built-ins.
+///        Inputs prefixed with i_ are per-instance, matrices and arrays are expanded into a location each.
+/// \param shaderModule Reflected vertex shader
+/// \param inputs Output list of inputs, sorted by location
+void ReflectVertexInputs(const spv_reflect::ShaderModule& shaderModule, std::vector<VertexInputData>& inputs);
+
+/// \brief Pairs reflected inputs with the declared storage layouts of the vertex and instance structures.
+///        Per-vertex inputs are sourced from VertexStream, per-instance inputs from InstanceStream.
+///        A layout with a stride of 0 isn't declared, and is packed tightly from the reflected formats instead.
+/// \param positionStride Non-zero splits the vertex layout, see SplitVertex. Its first attribute is sourced from
+///        VertexStream at this stride and the others from AttributeStream, bound only if the shader reads them.
+void BuildVertexInputLayout(
+    const std::vector<VertexInputData>& inputs,
+    const VertexAttributes& vertexAttributes,
+    uint32_t vertexStride,
+    uint32_t positionStride,
+    const VertexAttributes& instanceAttributes,
+    uint32_t instanceStride,
+    std::vector<vk::VertexInputBindingDescription>& bindings,
+    std::vector<vk::VertexInputAttributeDescription>& attributes
+);
+
+/// \brief Reflects the push constant block of a module, merging it into block.
+/// \param shaderModule Reflected shader of any stage
+/// \param stage Stage of the module, masked into the block's stage flags
+/// \param block Merged push constant block of the pipeline
+void ReflectPushConstants(
+    const spv_reflect::ShaderModule& shaderModule,
+    vk::ShaderStageFlagBits stage,
+    PushConstantBlockData& block
+);
+
+[[nodiscard]] uint32_t GetFormatSize(vk::Format format);
+[[nodiscard]] VertexNumericType GetFormatNumericType(vk::Format format);
+
+template <class T, class = void>
+struct HasVertexAttributes : std::false_type {};
+
+template <class T>
+struct HasVertexAttributes<T, std::void_t<decltype(T::Attributes())>> : std::true_type {};
+
+// Structure a layout passed to ReadShader stores its vertices in, unwrapping SplitVertex
+template <class T>
+struct VertexLayoutTraits
+{
+    using Type = T;
+    static constexpr bool split = false;
+};
+
+template <class T>
+struct VertexLayoutTraits<SplitVertex<T>>
+{
+    using Type = T;
+    static constexpr bool split = true;
+};
+
+template <class T>
+VertexAttributes DeclaredVertexAttributes()
+{
+    using Type = typename VertexLayoutTraits<T>::Type;
+    if constexpr (std::is_void<Type>::value)
+    {
+        return {};
+    }
+    else
+    {
+        static_assert(HasVertexAttributes<Type>::value, "Vertex layouts must declare their attributes through a static Attributes() function");
+        return Type::Attributes();
+    }
+}
+
+template <class T>
+constexpr uint32_t DeclaredVertexStride()
+{
+    using Type = typename VertexLayoutTraits<T>::Type;
+    if constexpr (std::is_void<Type>::value)
+        return 0;
+    else
+        return sizeof(Type);
+}
+
+template <class T>
+uint32_t DeclaredPositionStride()
+{
+    if constexpr (VertexLayoutTraits<T>::split)
+        return T::PositionStride();
+    else
+        return 0;
+}
+
+struct PushConstantMember
+{
+    const char* name;
+    uint32_t offset;
+};
+
+using PushConstantMembers = std::vector<PushConstantMember>;
+
+template <class T, class = void>
+struct HasPushConstantMembers : std::false_type {};
+
+template <class T>
+struct HasPushConstantMembers<T, std::void_t<decltype(T::Members())>> : std::true_type {};
+
+/**
+ * Specialization constant values for a single pipeline variant.
+ * Created from reflection, defaults to the values declared in the shader and
+ * applied to every stage at pipeline creation.
+ */
+class SpecializationConstants
+{
+public:
+    void Create(const std::vector<SpecializationConstantData>& inReflection);
+
+    template <class T>
+    void Set(const std::string& name, T value)
+    {
+        Set(FindConstant(name), value);
+    }
+
+    template <class T>
+    void Set(uint32_t constantID, T value)
+    {
+        static_assert(std::is_arithmetic<T>::value, "Specialization constants must be scalar values");
+
+        auto it = std::find_if(entries.begin(), entries.end(),
+                               [constantID](const vk::SpecializationMapEntry& entry)
+                               {
+                                   return entry.constantID == constantID;
+                               });
+        DM_ASSERT_MSG(it != entries.end(), "Attempting to set a specialization constant not present in the shader");
+        DM_ASSERT_MSG((*reflection)[it - entries.begin()].type == GetType<T>(),
+                      "Specialization constant value doesn't match the type declared in the shader");
+
+        if constexpr (std::is_same<T, bool>::value)
+        {
+            VkBool32 boolValue = value ? VK_TRUE : VK_FALSE;
+            Write(*it, &boolValue, sizeof(VkBool32));
+        }
+        else
+        {
+            Write(*it, &value, sizeof(T));
+        }
+    }
+
+    [[nodiscard]] bool IsEmpty() const { return entries.empty(); }
+    /// \brief Info pointing at this object's constants, valid until it's modified, moved or destroyed
+    [[nodiscard]] const vk::SpecializationInfo* GetInfo() const;
+    [[nodiscard]] uint32_t FindConstant(const std::string& name) const;
+
+private:
+    template <class T>
+    static constexpr SpecializationConstantType GetType()
+    {
+        if constexpr (std::is_same<T, bool>::value)
+            return SpecializationConstantType::Bool;
+        else if constexpr (std::is_floating_point<T>::value)
+            return SpecializationConstantType::Float;
+        else if constexpr (std::is_signed<T>::value)
+            return SpecializationConstantType::SInt;
+        else
+            return SpecializationConstantType::UInt;
+    }
+
+    void Write(const vk::SpecializationMapEntry& entry, const void* value, size_t size);
+
+    const std::vector<SpecializationConstantData>* reflection = nullptr;
+    std::vector<vk::SpecializationMapEntry> entries;
+    std::vector<char> data;
+    mutable vk::SpecializationInfo info = {};
+};
+
+}
@@ -20,6 +20,33 @@ void Texture::Create(const std::string& path, Device* inOwner)
 {
     IOwned<Device>::CreateOwned(inOwner);
 
+    Decode(path);
+    StageTexture(width * height * 4, MipLevels(width, height));
+}
+
+void Texture::Create(const uint8_t* rgba, int32_t inWidth, int32_t inHeight, Device* inOwner)
+{
+    IOwned<Device>::CreateOwned(inOwner);
+
+    width = inWidth;
+    height = inHeight;
+    channels = 4;
+
+    // Allocated as stbi_load would, so Destroy frees every texture alike
+    const size_t size = (size_t) width * height * 4;
+    pixelData = malloc(size);
+    std::memcpy(pixelData, rgba, size);
+    StageTexture(size, MipLevels(width, height));
+}
+
+void Texture::Create(UploadBatch& batch, Device* inOwner)
+{
+    IOwned<Device>::CreateOwned(inOwner);
+    StageTexture(width * height * 4, MipLevels(width, height), &batch);
+}
+
+bool Texture::Decode(const std::string& path)
+{
     pixelData =
         stbi_load(
             path.c_str(),
@@ -27,15 +54,10 @@ void Texture::Create(const std::string& path, Device* inOwner)
             &height,
             &channels,
             STBI_rgb_alpha);
-
-    vk::DeviceSize imageSize = width * height * 4;
-    uint32_t mipLevels = {
-        static_cast<uint32_t>(std::floor(std::log2(std::max(width, height)))) + 1
-    };
-    StageTexture(imageSize, mipLevels);
+    return pixelData != nullptr;
 }
 
-void Texture::StageTexture(vk::DeviceSize size, uint32_t mipLevels)
+void Texture::StageTexture(vk::DeviceSize size, uint32_t mipLevels, UploadBatch* batch)
 {
     DM_ASSERT_MSG(pixelData != nullptr, "Failed to load texture image");
     DM_ASSERT_MSG(width != 0 && height != 0, "Attempting to stage texture with 0 dimensions");
@@ -47,19 +69,22 @@ void Texture::StageTexture(vk::DeviceSize size, uint32_t mipLevels)
     VmaAllocationCreateInfo stageAllocInfo = {};
     stageAllocInfo.usage = VMA_MEMORY_USAGE_CPU_ONLY;
 
-    Buffer stagingBuffer = {};
-    stagingBuffer.Create(stageInfo, stageAllocInfo, owner);
+    // Shared with the batch, which keeps it alive until its copy has executed
+    auto stagingBuffer = std::make_shared<Buffer>();
+    stagingBuffer->Create(stageInfo, stageAllocInfo, owner);
 
     // TODO: abstract staging buffers
     void* mapped;
     auto allocator = owner->allocator;
     // Map and copy data to the memory, then unmap
-    vmaMapMemory(allocator, stagingBuffer.allocation, &mapped);
+    vmaMapMemory(allocator, stagingBuffer->allocation, &mapped);
     std::memcpy(mapped, pixelData, (size_t) size);
-    vmaUnmapMemory(allocator, stagingBuffer.allocation);
+    vmaUnmapMemory(allocator, stagingBuffer->allocation);
 
-    VmaAllocationCreateInfo allocInfo{};
-    allocInfo.usage = VMA_MEMORY_USAGE_GPU_ONLY;
+    // The transitions and copy are recorded together, into the batch or a single submit
+    auto& commandPool = OwnerGet<Renderer>().commandPool;
+    vk::UniqueCommandBuffer submitted = batch == nullptr ? commandPool.BeginCommandBuffer() : vk::UniqueCommandBuffer();
+    vk::CommandBuffer cmdBuf = batch != nullptr ? batch->GetCommandBuffer() : submitted.get();
 
     image.Create2D(glm::uvec2(width, height),
                    vk::Format::eR8G8B8A8Unorm,
@@ -70,6 +95,7 @@ void Texture::StageTexture(vk::DeviceSize size, uint32_t mipLevels)
                        vk::ImageUsageFlagBits::eSampled,
                    vk::ImageLayout::eTransferDstOptimal,
                    vk::ImageAspectFlagBits::eColor,
+                   cmdBuf,
                    owner);
 
     vk::ImageSubresourceLayers imageSubresource{
@@ -102,20 +128,24 @@ void Texture::StageTexture(vk::DeviceSize size, uint32_t mipLevels)
     imageCopy.imageOffset = vk::Offset3D();
     imageCopy.imageExtent = imageExtent;
 
-    cmdBuf->copyBufferToImage(stagingBuffer.VkType(),
-                              image.VkType(),
-                              vk::ImageLayout::eTransferDstOptimal,
-                              1,
-                              &bufferImageCopy);
-
-    commandPool.EndCommandBuffer(cmdBuf.get());
+    cmdBuf.copyBufferToImage(stagingBuffer->VkType(),
+                             image.VkType(),
+                             vk::ImageLayout::eTransferDstOptimal,
+                             1,
+                             &bufferImageCopy);
 
     // Transition to shader resource
-    image.TransitionLayout(vk::ImageLayout::eTransferDstOptimal,
+    image.TransitionLayout(cmdBuf,
+                           vk::ImageLayout::eTransferDstOptimal,
                            vk::ImageLayout::eShaderReadOnlyOptimal,
                            vk::ImageAspectFlagBits::eColor,
                            mipLevels);
 
+    if (batch != nullptr)
+        batch->Retain(std::move(stagingBuffer));
+    else
+        commandPool.EndCommandBuffer(cmdBuf);
+
     imageView.CreateTexture2DView(image.VkType(), owner);
 
     //    vk::SamplerCreateInfo samplerInfo = {};
@@ -144,9 +174,11 @@ vk::DescriptorImageInfo Texture::GetDescriptor(vk::ImageLayout imageLayout)
 }
 void Texture::Destroy()
 {
-    if (created)
+    // Decoded pixels are held before the texture is created, see Decode
+    if (pixelData != nullptr)
     {
         stbi_image_free(pixelData);
+        pixelData = nullptr;
     }
 }
 
@@ -260,10 +292,7 @@ void FontTexture::Create(const std::string& path, Device* inOwner)
         pixels[i * 4 + 3] = pixel;
     }
 
-    uint32_t mipLevels = {
-        static_cast<uint32_t>(std::floor(std::log2(std::max(width, height)))) + 1
-    };
-    StageTexture(width * height * 4, mipLevels);
+    StageTexture(width * height * 4, MipLevels(width, height));
 }
 
 void FontTexture::GetFontPosition(char c, glm::vec2& uvScale, glm::vec2& uvOffset)
@@ -346,6 +375,7 @@ void FontTexture::Destroy()
     if (created)
     {
         free(pixelData);
+        pixelData = nullptr;
         created = false;
     }
 }
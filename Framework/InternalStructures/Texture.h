@@ -9,7 +9,20 @@ class Texture : public IOwned<Device>
 {
 public:
     void Create(const std::string& path, Device* inOwner);
-    void StageTexture(vk::DeviceSize size, uint32_t mipLevels);
+
+    /// \brief Create from tightly packed RGBA8 pixels, which are copied
+    void Create(const uint8_t* rgba, int32_t inWidth, int32_t inHeight, Device* inOwner);
+
+    /// \brief Create from pixels read by Decode, recording the upload into batch.
+    ///        The texture may be sampled by commands submitted after the batch completes.
+    void Create(UploadBatch& batch, Device* inOwner);
+
+    /// \brief Read the image at path into pixelData without touching the device, so it can run on worker threads
+    /// \return False if the image couldn't be read
+    bool Decode(const std::string& path);
+
+    /// \param batch Optional batch the upload is recorded into, otherwise it's submitted and waited on
+    void StageTexture(vk::DeviceSize size, uint32_t mipLevels, UploadBatch* batch = nullptr);
     virtual void Destroy();
     ~Texture() override;
     vk::DescriptorImageInfo GetDescriptor(vk::ImageLayout imageLayout);
@@ -24,6 +37,11 @@ public:
 
     void* pixelData = nullptr;
 
+protected:
+    [[nodiscard]] static uint32_t MipLevels(int32_t width, int32_t height)
+    {
+        return static_cast<uint32_t>(std::floor(std::log2(std::max(width, height)))) + 1;
+    }
 };
 
 class FontTexture final : public Texture
@@ -0,0 +1,94 @@
+//------------------------------------------------------------------------------
+//
+// File Name:	UploadBatch.cpp
+// Author(s):	Jonathan Bourim (j.bourim)
+// Date:        10/19/2026
+//
+//------------------------------------------------------------------------------
+
+#include "UploadBatch.h"
+
+namespace dm
+{
+
+UploadBatch::~UploadBatch() noexcept
+{
+    Destroy();
+}
+
+void UploadBatch::Create(Device* inOwner)
+{
+    Destroy();
+    IOwned::CreateOwned(inOwner);
+
+    vk::CommandBufferAllocateInfo allocateInfo(OwnerGet<Renderer>().commandPool.VkType(),
+                                               vk::CommandBufferLevel::ePrimary, 1);
+    DM_ASSERT_VK(owner->allocateCommandBuffers(&allocateInfo, &commandBuffer));
+
+    vk::CommandBufferBeginInfo beginInfo(vk::CommandBufferUsageFlagBits::eOneTimeSubmit);
+    DM_ASSERT_VK(commandBuffer.begin(&beginInfo));
+
+    vk::FenceCreateInfo fenceCreateInfo;
+    DM_ASSERT_VK(owner->createFence(&fenceCreateInfo, nullptr, &fence));
+}
+
+void UploadBatch::Destroy()
+{
+    if (!created)
+        return;
+
+    // The batch's command buffer and staging can't be released while the queue reads them
+    if (submitted)
+        DM_ASSERT_VK(owner->waitForFences(1, &fence, VK_TRUE, std::numeric_limits<uint64_t>::max()));
+
+    owner->freeCommandBuffers(OwnerGet<Renderer>().commandPool.VkType(), 1, &commandBuffer);
+    commandBuffer = nullptr;
+    owner->destroyFence(fence);
+    fence = nullptr;
+    staging.clear();
+    stagedBytes = 0;
+    submitted = false;
+    created = false;
+}
+
+void UploadBatch::Stage(Buffer& buffer)
+{
+    DM_ASSERT_MSG(!submitted, "Attempting to stage into a submitted upload batch");
+    DM_ASSERT_MSG(buffer.stagingBuffer != nullptr, "Buffers staged into a batch are created by CreateStaged");
+
+    Buffer::StageTransfer(*buffer.stagingBuffer, buffer, buffer.bufferCI.size, commandBuffer, *owner);
+    stagedBytes += buffer.bufferCI.size;
+}
+
+void UploadBatch::Retain(std::shared_ptr<Buffer> buffer)
+{
+    stagedBytes += buffer->bufferCI.size;
+    staging.push_back(std::move(buffer));
+}
+
+void UploadBatch::Submit()
+{
+    DM_ASSERT_MSG(created && !submitted, "Upload batches are submitted once");
+
+    // Commands submitted later on the queue are in the barrier's second scope
+    vk::MemoryBarrier barrier(vk::AccessFlagBits::eTransferWrite,
+                              vk::AccessFlagBits::eVertexAttributeRead | vk::AccessFlagBits::eIndexRead |
+                              vk::AccessFlagBits::eUniformRead | vk::AccessFlagBits::eShaderRead |
+                              vk::AccessFlagBits::eIndirectCommandRead);
+    commandBuffer.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer, vk::PipelineStageFlagBits::eAllCommands,
+                                  {}, 1, &barrier, 0, nullptr, 0, nullptr);
+    commandBuffer.end();
+
+    vk::SubmitInfo submitInfo;
+    submitInfo.commandBufferCount = 1;
+    submitInfo.pCommandBuffers = &commandBuffer;
+    DM_ASSERT_VK(owner->graphicsQueue.submit(1, &submitInfo, fence));
+    submitted = true;
+}
+
+bool UploadBatch::IsComplete() const
+{
+    return submitted && owner->getFenceStatus(fence) == vk::Result::eSuccess;
+}
+
+}
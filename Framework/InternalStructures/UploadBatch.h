@@ -0,0 +1,58 @@
+//------------------------------------------------------------------------------
+//
+// File Name:	UploadBatch.h
+// Author(s):	Jonathan Bourim (j.bourim)
+// Date:        10/19/2026
+//
+//------------------------------------------------------------------------------
+#pragma once
+
+namespace dm
+{
+
+class Buffer;
+
+/**
+ * Transfers recorded into one command buffer and submitted together without waiting on the queue,
+ * the asynchronous counterpart of CommandPool::BeginCommandBuffer and EndCommandBuffer.
+ * Resources staged into a batch may be used by commands submitted after the batch completes.
+ */
+class UploadBatch : public IOwned<Device>
+{
+public:
+DM_TYPE_OWNED_BODY(UploadBatch, IOwned<Device>)
+    ~UploadBatch() noexcept override;
+
+    /// \brief Allocate and begin the batch's command buffer from the renderer's command pool
+    void Create(Device* inOwner);
+
+    /// \brief Wait for the batch if it was submitted, then release its command buffer and staging
+    void Destroy();
+
+    /// \brief Record the copy of a buffer created by CreateStaged without submitting to the GPU
+    void Stage(Buffer& buffer);
+
+    /// \brief Keep a staging buffer read by the batch's commands alive until the batch is destroyed
+    void Retain(std::shared_ptr<Buffer> staging);
+
+    /// \brief End the batch and submit it to the graphics queue, making its transfers visible to later commands
+    void Submit();
+
+    /// \brief Whether the batch was submitted and has finished executing, never blocks
+    [[nodiscard]] bool IsComplete() const;
+
+    [[nodiscard]] vk::CommandBuffer GetCommandBuffer() const { return commandBuffer; }
+    [[nodiscard]] bool IsSubmitted() const { return submitted; }
+
+    /// \brief Bytes copied by the batch's commands so far
+    [[nodiscard]] vk::DeviceSize StagedBytes() const { return stagedBytes; }
+
+private:
+    vk::CommandBuffer commandBuffer = {};
+    vk::Fence fence = {};
+    std::vector<std::shared_ptr<Buffer>> staging;
+    vk::DeviceSize stagedBytes = 0;
+    bool submitted = false;
+};
+
+}
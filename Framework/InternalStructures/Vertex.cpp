@@ -7,6 +7,179 @@
 //------------------------------------------------------------------------------
 #include "Vertex.h"
 
+namespace dm
+{
 
+namespace
+{
 
+int16_t PackSnorm16(float value)
+{
+	return (int16_t) std::round(glm::clamp(value, -1.0f, 1.0f) * 32767.0f);
+}
 
+uint16_t PackUnorm16(float value)
+{
+	return (uint16_t) std::round(glm::clamp(value, 0.0f, 1.0f) * 65535.0f);
+}
+
+// PackSnorm16 never produces -32768, so it's free to mark a missing normal
+constexpr int16_t missingNormal = -32768;
+
+// Projects the normal onto an octahedron, folding the lower half over the upper
+void PackOctahedral(const glm::vec3& normal, int16_t* packed)
+{
+	const float length = std::abs(normal.x) + std::abs(normal.y) + std::abs(normal.z);
+	if (length <= 0.0f)
+	{
+		packed[0] = missingNormal;
+		packed[1] = missingNormal;
+		return;
+	}
+
+	glm::vec2 encoded = glm::vec2(normal.x, normal.y) / length;
+	if (normal.z < 0.0f)
+	{
+		encoded = glm::vec2(
+			(1.0f - std::abs(encoded.y)) * (encoded.x >= 0.0f ? 1.0f : -1.0f),
+			(1.0f - std::abs(encoded.x)) * (encoded.y >= 0.0f ? 1.0f : -1.0f)
+		);
+	}
+	packed[0] = PackSnorm16(encoded.x);
+	packed[1] = PackSnorm16(encoded.y);
+}
+
+glm::vec3 UnpackOctahedral(const int16_t* packed)
+{
+	if (packed[0] == missingNormal && packed[1] == missingNormal)
+		return glm::vec3(0.0f);
+
+	const glm::vec2 encoded(std::max(packed[0] / 32767.0f, -1.0f), std::max(packed[1] / 32767.0f, -1.0f));
+	glm::vec3 normal(encoded, 1.0f - std::abs(encoded.x) - std::abs(encoded.y));
+	if (normal.z < 0.0f)
+	{
+		normal.x = (1.0f - std::abs(encoded.y)) * (encoded.x >= 0.0f ? 1.0f : -1.0f);
+		normal.y = (1.0f - std::abs(encoded.x)) * (encoded.y >= 0.0f ? 1.0f : -1.0f);
+	}
+	const float length = glm::length(normal);
+	return length > 0.0f ? normal / length : normal;
+}
+
+// Normals of zero length, such as those of models without normals, are kept
+glm::vec3 TransformNormal(const glm::vec3& normal, const glm::mat3& normalMatrix)
+{
+	const glm::vec3 transformed = normalMatrix * normal;
+	const float length = glm::length(transformed);
+	return length > 0.0f ? transformed / length : transformed;
+}
+
+template<class CompactType>
+void PackCompactAttributes(const Vertex& vertex, CompactType& compact)
+{
+	PackOctahedral(vertex.normal, compact.normal);
+	for (int i = 0; i < 3; ++i)
+		compact.color[i] = (uint8_t) std::round(glm::clamp(vertex.color[i], 0.0f, 1.0f) * 255.0f);
+
+	const uint32_t texPos = glm::packHalf2x16(vertex.texPos);
+	compact.texPos[0] = (uint16_t) (texPos & 0xFFFF);
+	compact.texPos[1] = (uint16_t) (texPos >> 16);
+}
+
+}
+
+VertexQuantization VertexQuantization::FromVertices(const std::vector<Vertex>& vertices)
+{
+	VertexQuantization quantization;
+	if (vertices.empty())
+		return quantization;
+
+	glm::vec3 boundsMin = vertices[0].pos;
+	glm::vec3 boundsMax = vertices[0].pos;
+	for (const Vertex& vertex : vertices)
+	{
+		boundsMin = glm::min(boundsMin, vertex.pos);
+		boundsMax = glm::max(boundsMax, vertex.pos);
+	}
+
+	quantization.offset = boundsMin;
+	quantization.scale = boundsMax - boundsMin;
+	for (int i = 0; i < 3; ++i)
+	{
+		// Flat axes quantize to 0, any scale dequantizes them
+		if (quantization.scale[i] <= 0.0f)
+			quantization.scale[i] = 1.0f;
+	}
+	return quantization;
+}
+
+glm::mat4 VertexQuantization::DequantizeTransform() const
+{
+	glm::mat4 transform(1.0f);
+	transform[0][0] = scale.x;
+	transform[1][1] = scale.y;
+	transform[2][2] = scale.z;
+	transform[3] = glm::vec4(offset, 1.0f);
+	return transform;
+}
+
+glm::mat3 VertexQuantization::NormalMatrix(const glm::mat4& dequantizedModel) const
+{
+	// Undo the dequantize scale, leaving the inverse transpose of the mesh's own model matrix
+	glm::mat3 model = glm::mat3(dequantizedModel);
+	for (int i = 0; i < 3; ++i)
+		model[i] /= scale[i];
+	return glm::transpose(glm::inverse(model));
+}
+
+CompactVertex CompactVertex::FromVertex(const Vertex& vertex)
+{
+	CompactVertex compact;
+	compact.pos = vertex.pos;
+	PackCompactAttributes(vertex, compact);
+	return compact;
+}
+
+QuantizedVertex QuantizedVertex::FromVertex(const Vertex& vertex, const VertexQuantization& quantization)
+{
+	QuantizedVertex quantized;
+	const glm::vec3 normalized = (vertex.pos - quantization.offset) / quantization.scale;
+	for (int i = 0; i < 3; ++i)
+		quantized.pos[i] = PackUnorm16(normalized[i]);
+	PackCompactAttributes(vertex, quantized);
+	return quantized;
+}
+
+Vertex TransformVertex(const Vertex& vertex, const glm::mat4& model, const glm::mat3& normalMatrix)
+{
+	Vertex transformed = vertex;
+	transformed.pos = glm::vec3(model * glm::vec4(vertex.pos, 1.0f));
+	transformed.normal = TransformNormal(vertex.normal, normalMatrix);
+	return transformed;
+}
+
+CompactVertex TransformVertex(const CompactVertex& vertex, const glm::mat4& model, const glm::mat3& normalMatrix)
+{
+	CompactVertex transformed = vertex;
+	transformed.pos = glm::vec3(model * glm::vec4(vertex.pos, 1.0f));
+	PackOctahedral(TransformNormal(UnpackOctahedral(vertex.normal), normalMatrix), transformed.normal);
+	return transformed;
+}
+
+std::vector<CompactVertex> ToCompactVertices(const std::vector<Vertex>& vertices)
+{
+	std::vector<CompactVertex> compact(vertices.size());
+	for (size_t i = 0; i < vertices.size(); ++i)
+		compact[i] = CompactVertex::FromVertex(vertices[i]);
+	return compact;
+}
+
+std::vector<QuantizedVertex> ToQuantizedVertices(const std::vector<Vertex>& vertices, VertexQuantization& quantization)
+{
+	quantization = VertexQuantization::FromVertices(vertices);
+	std::vector<QuantizedVertex> quantized(vertices.size());
+	for (size_t i = 0; i < vertices.size(); ++i)
+		quantized[i] = QuantizedVertex::FromVertex(vertices[i], quantization);
+	return quantized;
+}
+
+}
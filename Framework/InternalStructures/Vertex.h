@@ -8,10 +8,49 @@
 #pragma once
 namespace dm
 {
+
+// Vertex buffer bindings produced by shader reflection
+enum VertexBindingIndex : uint32_t
+{
+	VertexStream    = 0,
+	InstanceStream  = 1,
+	AttributeStream = 2		//< Non-position attributes of split vertex layouts, see SplitVertex
+};
+
+/**
+ * Storage format of a single shader input location within a vertex or instance structure.
+ * Structures declare these in location order through a static Attributes() function,
+ * matrices and arrays take one attribute per location they consume.
+ */
+struct VertexAttribute
+{
+	vk::Format format = vk::Format::eUndefined;
+	uint32_t offset = 0;
+};
+
+using VertexAttributes = std::vector<VertexAttribute>;
+
+inline void AppendMatrixAttributes(
+	VertexAttributes& attributes,
+	vk::Format columnFormat,
+	uint32_t columnCount,
+	uint32_t offset,
+	uint32_t columnStride
+)
+{
+	for (uint32_t column = 0; column < columnCount; ++column)
+		attributes.push_back({ columnFormat, offset + column * columnStride });
+}
+
 struct PosVertex
 {
 	glm::vec3 pos = glm::vec3(0.0f);
 	inline static const uint32_t NUM_ATTRIBS = 1;
+
+	static VertexAttributes Attributes()
+	{
+		return { { vk::Format::eR32G32B32Sfloat, offsetof(PosVertex, pos) } };
+	}
 };
 
 struct ColorVertex
@@ -20,6 +59,14 @@ struct ColorVertex
 	glm::vec3 color;
 
 	inline static const uint32_t NUM_ATTRIBS = 2;
+
+	static VertexAttributes Attributes()
+	{
+		return {
+			{ vk::Format::eR32G32B32Sfloat, offsetof(ColorVertex, pos) },
+			{ vk::Format::eR32G32B32Sfloat, offsetof(ColorVertex, color) }
+		};
+	}
 };
 
 struct TexVertex
@@ -28,6 +75,14 @@ struct TexVertex
 	glm::vec2 texPos;
 
 	inline static const uint32_t NUM_ATTRIBS = 2;
+
+	static VertexAttributes Attributes()
+	{
+		return {
+			{ vk::Format::eR32G32B32Sfloat, offsetof(TexVertex, pos) },
+			{ vk::Format::eR32G32Sfloat, offsetof(TexVertex, texPos) }
+		};
+	}
 };
 
 struct Vertex
@@ -43,6 +98,145 @@ struct Vertex
 	}
 
 	inline static const uint32_t NUM_ATTRIBS = 4;
+
+	static VertexAttributes Attributes()
+	{
+		return {
+			{ vk::Format::eR32G32B32Sfloat, offsetof(Vertex, pos) },
+			{ vk::Format::eR32G32B32Sfloat, offsetof(Vertex, normal) },
+			{ vk::Format::eR32G32B32Sfloat, offsetof(Vertex, color) },
+			{ vk::Format::eR32G32Sfloat, offsetof(Vertex, texPos) }
+		};
+	}
+};
+
+/**
+ * Pipeline layout of VertexType deinterleaved into two streams, passed to ReadShader in place of VertexType.
+ * The first attribute, the position, is sourced tightly packed from VertexStream and the remaining ones
+ * from AttributeStream, so pipelines only reading positions fetch nothing else. Meshes are created
+ * in this layout through Mesh::CreateSplit.
+ */
+template<class VertexType>
+struct SplitVertex
+{
+	using Type = VertexType;
+
+	// Bytes of each vertex in the position stream, the rest lie in the attribute stream
+	static uint32_t PositionStride()
+	{
+		const VertexAttributes attributes = VertexType::Attributes();
+		DM_ASSERT_MSG(!attributes.empty() && attributes[0].offset == 0, "Split vertex layouts must start with their position");
+		return attributes.size() > 1 ? attributes[1].offset : (uint32_t) sizeof(VertexType);
+	}
+};
+
+/**
+ * Maps QuantizedVertex positions back to the mesh's local space, position = offset + scale * unorm.
+ */
+struct VertexQuantization
+{
+	glm::vec3 offset = glm::vec3(0.0f);
+	glm::vec3 scale = glm::vec3(1.0f);
+
+	// Covers the bounds of vertices
+	static VertexQuantization FromVertices(const std::vector<Vertex>& vertices);
+
+	// Applied before the mesh's model matrix, so shaders read quantized positions as regular ones
+	[[nodiscard]] glm::mat4 DequantizeTransform() const;
+
+	// Normal matrix of a model matrix DequantizeTransform was folded into. Normals aren't quantized,
+	// so the folded matrix's own inverse transpose would skew them by non-uniform bounds.
+	[[nodiscard]] glm::mat3 NormalMatrix(const glm::mat4& dequantizedModel) const;
+};
+
+/**
+ * 24 byte Vertex with full precision positions, locations match Vertex's.
+ * Normals are octahedral encoded into a vec2 input, decoded with:
+ *
+ *     vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+ *     n.xy = n.z < 0.0 ? (1.0 - abs(n.yx)) * vec2(n.x >= 0.0 ? 1.0 : -1.0, n.y >= 0.0 ? 1.0 : -1.0) : n.xy;
+ *     n = normalize(n);
+ */
+struct CompactVertex
+{
+	glm::vec3 pos = {};
+	int16_t normal[2] = {};					//< Octahedral, snorm16. -32768 in both marks a missing normal, decoded as -Z
+	uint8_t color[4] = { 255, 255, 255, 255 };
+	uint16_t texPos[2] = {};				//< Half floats
+
+	inline static const uint32_t NUM_ATTRIBS = 4;
+
+	static VertexAttributes Attributes()
+	{
+		return {
+			{ vk::Format::eR32G32B32Sfloat, offsetof(CompactVertex, pos) },
+			{ vk::Format::eR16G16Snorm, offsetof(CompactVertex, normal) },
+			{ vk::Format::eR8G8B8A8Unorm, offsetof(CompactVertex, color) },
+			{ vk::Format::eR16G16Sfloat, offsetof(CompactVertex, texPos) }
+		};
+	}
+
+	static CompactVertex FromVertex(const Vertex& vertex);
+};
+
+/**
+ * 20 byte CompactVertex with positions quantized within the mesh's bounds, see VertexQuantization.
+ * Quantizing is the final step of a mesh's import: OptimizeMesh, GenerateLods, BuildMeshlets,
+ * BuildStaticBatch and MeshCache read positions as vec3s, so run them on Vertex data and convert the result.
+ */
+struct QuantizedVertex
+{
+	uint16_t pos[4] = {};					//< unorm16 xyz, w is padding
+	int16_t normal[2] = {};
+	uint8_t color[4] = { 255, 255, 255, 255 };
+	uint16_t texPos[2] = {};
+
+	inline static const uint32_t NUM_ATTRIBS = 4;
+
+	static VertexAttributes Attributes()
+	{
+		return {
+			{ vk::Format::eR16G16B16A16Unorm, offsetof(QuantizedVertex, pos) },
+			{ vk::Format::eR16G16Snorm, offsetof(QuantizedVertex, normal) },
+			{ vk::Format::eR8G8B8A8Unorm, offsetof(QuantizedVertex, color) },
+			{ vk::Format::eR16G16Sfloat, offsetof(QuantizedVertex, texPos) }
+		};
+	}
+
+	static QuantizedVertex FromVertex(const Vertex& vertex, const VertexQuantization& quantization);
+};
+
+// Convert vertices produced by Mesh<Vertex>::LoadModel
+std::vector<CompactVertex> ToCompactVertices(const std::vector<Vertex>& vertices);
+std::vector<QuantizedVertex> ToQuantizedVertices(const std::vector<Vertex>& vertices, VertexQuantization& quantization);
+
+// Vertex baked into the space of a model matrix, normalMatrix being the inverse transpose of its upper 3x3.
+// Positions are transformed and other attributes copied, vertex types with normals overload it.
+template<class VertexType>
+VertexType TransformVertex(const VertexType& vertex, const glm::mat4& model, const glm::mat3& normalMatrix)
+{
+	VertexType transformed = vertex;
+	transformed.pos = glm::vec3(model * glm::vec4(vertex.pos, 1.0f));
+	return transformed;
+}
+
+Vertex TransformVertex(const Vertex& vertex, const glm::mat4& model, const glm::mat3& normalMatrix);
+CompactVertex TransformVertex(const CompactVertex& vertex, const glm::mat4& model, const glm::mat3& normalMatrix);
+
+// Positions are quantized within each mesh's bounds, transform Vertex meshes and quantize the result instead
+QuantizedVertex TransformVertex(const QuantizedVertex& vertex, const glm::mat4& model, const glm::mat3& normalMatrix) = delete;
+
+// Per-instance model matrix, read by shaders through an i_ prefixed mat4 input
+struct InstanceModel
+{
+	glm::mat4 model = glm::mat4(1.0f);
+
+	static VertexAttributes Attributes()
+	{
+		VertexAttributes attributes;
+		AppendMatrixAttributes(attributes, vk::Format::eR32G32B32A32Sfloat, 4, offsetof(InstanceModel, model), sizeof(glm::vec4));
+		return attributes;
+	}
 };
 
 }
\ No newline at end of file
@@ -21,14 +21,18 @@ IRenderingContext::IRenderingContext(Renderer& inRenderer)
 
 void Renderer::Create(std::weak_ptr<Window> inWindow)
 {
+    threadPool.Create();
     instance.Create(std::move(inWindow));
     physicalDevice.Create(this);
     CreateDevice();
+    pipelineLibrary.Create(&device);
     descriptors.Create(&device);
     CreateSwapchain();
  //   device.setsToFree.resize(ImageCount());
     CreateSync();
     CreateCommandPool();
+    geometryPool.Create(&device);
+    assetLoader.Create(&device, threadPool);
     CreateCommandBuffers();
     CreateDescriptorPool();
     InitializeMeshStatics(&device);
@@ -38,6 +42,7 @@ void Renderer::Create(std::weak_ptr<Window> inWindow)
 void Renderer::Update(float dt)
 {
     device.Update(dt);
+    assetLoader.Update();
 
     for (auto& [id, context] : renderingContexts)
     {
@@ -152,16 +157,42 @@ void Renderer::CreateDevice()
     //deviceFeatures.wideLines = VK_TRUE;
     //deviceFeatures.fillModeNonSolid = VK_TRUE;
 
+    // Used by GPU driven draws, see GpuScene
+    deviceFeatures.multiDrawIndirect = physicalDevice.supportedFeatures.multiDrawIndirect;
+    deviceFeatures.drawIndirectFirstInstance = physicalDevice.supportedFeatures.drawIndirectFirstInstance;
+
     vk::DeviceCreateInfo createInfo(
         {},
         (uint32_t) queueCreateInfos.size(),
         queueCreateInfos.data(),
         0,
         {},
-        (uint32_t) deviceExtensions.size(),
-        deviceExtensions.data(),
+        (uint32_t) physicalDevice.enabledExtensions.size(),
+        physicalDevice.enabledExtensions.data(),
         &deviceFeatures);
 
+#ifdef VK_EXT_graphics_pipeline_library
+    vk::PhysicalDeviceGraphicsPipelineLibraryFeaturesEXT libraryFeatures = {};
+    if (physicalDevice.graphicsPipelineLibrary)
+    {
+        libraryFeatures.graphicsPipelineLibrary = VK_TRUE;
+        libraryFeatures.pNext = const_cast<void*>(createInfo.pNext);
+        createInfo.pNext = &libraryFeatures;
+    }
+#endif
+
+    // Used by meshlet drawing, see MeshletDrawer
+#ifdef VK_EXT_mesh_shader
+    vk::PhysicalDeviceMeshShaderFeaturesEXT meshShaderFeatures = {};
+    if (physicalDevice.meshShader)
+    {
+        meshShaderFeatures.taskShader = VK_TRUE;
+        meshShaderFeatures.meshShader = VK_TRUE;
+        meshShaderFeatures.pNext = const_cast<void*>(createInfo.pNext);
+        createInfo.pNext = &meshShaderFeatures;
+    }
+#endif
+
     device.Create(createInfo, &physicalDevice);
 }
 
@@ -87,9 +87,13 @@ struct Renderer : public BaseDeviceRenderer
 
     [[nodiscard]] int ImageCount() const;
 
+    ThreadPool threadPool;              //< Workers for sorting, importing and other CPU side parallel work
     CommandPool commandPool;
+    GeometryPool geometryPool;          //< Shared vertex and index buffers for static meshes
+    AssetLoader assetLoader;            //< Background model and texture loads, advanced by Update
     DescriptorPool descriptorPool;
     Descriptors descriptors;
+    PipelineLibrary pipelineLibrary;
     CommandBufferVector commandBuffers;
 
     // Swapchain objects
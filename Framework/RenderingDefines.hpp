@@ -12,12 +12,21 @@
 #include <fstream>
 #include <stdexcept>
 #include <set>
+#include <map>
 #include <cstdlib>
 #include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <future>
+#include <atomic>
+#include <chrono>
+#include <functional>
 #include <optional>
 #include <memory>
 #include <vector>
 #include <unordered_map>
+#include <unordered_set>
+#include <numeric>
 #include <array>
 #include <queue>
 #include <algorithm>
@@ -29,6 +38,19 @@
 #include <variant>
 #include <typeindex>
 
+// SIMD code paths, AVX2 when built with DAMASCUS_AVX2 and SSE2 on every x86-64 target
+#if defined(__AVX2__)
+#define DM_SIMD_AVX2 1
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define DM_SIMD_SSE2 1
+#endif
+#if defined(DM_SIMD_AVX2)
+#include <immintrin.h>
+#elif defined(DM_SIMD_SSE2)
+#include <emmintrin.h>
+#endif
+
 namespace dm
 {
 
@@ -44,14 +66,16 @@ struct UBOColor
 
 constexpr static glm::mat4 identityMatrix{};
 
+// Stage flags must cover every stage of the layout's push constant range, see IGraphicsPipeline::pushConstantRange
 inline void PushIdentityModel(
     vk::CommandBuffer commandBuffer,
-    vk::PipelineLayout pipelineLayout
+    vk::PipelineLayout pipelineLayout,
+    vk::ShaderStageFlags stageFlags = vk::ShaderStageFlagBits::eVertex
 )
 {
     commandBuffer.pushConstants(
         pipelineLayout,
-        vk::ShaderStageFlagBits::eVertex,
+        stageFlags,
         0, sizeof(glm::mat4), &identityMatrix
     );
 }
@@ -71,6 +95,23 @@ const std::vector<const char*> deviceExtensions = {
 #endif
 };
 
+// Enabled only when supported by the physical device, see PhysicalDevice::IsExtensionEnabled
+const std::vector<const char*> optionalDeviceExtensions = {
+#ifdef VK_EXT_graphics_pipeline_library
+    VK_KHR_PIPELINE_LIBRARY_EXTENSION_NAME,
+    VK_EXT_GRAPHICS_PIPELINE_LIBRARY_EXTENSION_NAME,
+#endif
+#ifdef VK_KHR_draw_indirect_count
+    VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME,
+#endif
+#ifdef VK_EXT_mesh_shader
+    // Mesh shaders are SPIR-V 1.4, which a 1.1 instance needs these for
+    VK_KHR_SHADER_FLOAT_CONTROLS_EXTENSION_NAME,
+    VK_KHR_SPIRV_1_4_EXTENSION_NAME,
+    VK_EXT_MESH_SHADER_EXTENSION_NAME,
+#endif
+};
+
 #ifdef __aarch64__
 #define DM_BREAKPOINT() asm("brk #0")
 #else
@@ -10,11 +10,16 @@
 
 // clang-format off
 #include <vk_mem_alloc.h>
+#include "Threading/ThreadPool.h"
 #include "InternalStructures/Instance.h"
 #include "InternalStructures/PhysicalDevice.h"
 #include "InternalStructures/Device.h"
+#include "InternalStructures/CommandRecorder.h"
+#include "InternalStructures/UploadBatch.h"
 #include "InternalStructures/Vertex.h"
 #include "InternalStructures/Buffer.h"
+#include "Geometry/GeometryPool.h"
+#include "Geometry/VertexDeduplication.h"
 #include "Sorting/RenderSortKey.h"
 #include "Sorting/ElementSortKeys.h"
 #include "InternalStructures/Mesh.h"
@@ -23,17 +28,37 @@
 #include "InternalStructures/ImageView.h"
 #include "InternalStructures/FrameBufferAttachment.h"
 #include "InternalStructures/Swapchain.h"
+#include "InternalStructures/EmbeddedShader.h"
 #include "InternalStructures/ShaderModule.h"
 #include "InternalStructures/Texture.h"
 #include "InternalStructures/RenderPass.h"
 #include "InternalStructures/FrameBuffer.h"
 #include "InternalStructures/Semaphore.h"
 #include "InternalStructures/Fence.h"
+#include "InternalStructures/ShaderReflection.h"
 #include "InternalStructures/Descriptors.h"
 #include "InternalStructures/CommandBuffer.h"
 #include "InternalStructures/CommandPool.h"
+#include "InternalStructures/RecordCache.h"
+#include "InternalStructures/PipelineLibrary.h"
 #include "InternalStructures/Pipeline.h"
+#include "Primitives/Primitives.h"
+#include "Geometry/MeshOptimizer.h"
+#include "Geometry/MeshSimplifier.h"
+#include "Geometry/Meshlets.h"
+#include "Geometry/MeshCache.h"
+#include "Culling/Frustum.h"
+#include "Culling/FrustumCulling.h"
+#include "Culling/OcclusionCulling.h"
+#include "Culling/GpuScene.h"
+#include "Culling/MeshletCulling.h"
+#include "Geometry/StaticBatch.h"
+#include "Sorting/RadixSort.h"
+#include "Sorting/DrawBucket.h"
+#include "Batching/InstanceBatcher.h"
+#include "Batching/IndirectDrawBuilder.h"
 #include "InternalStructures/Model.h"
+#include "Assets/AssetLoader.h"
 #include "Window/Window.h"
 #include "Renderer/Renderer.h"
 // clang-format on
@@ -0,0 +1,66 @@
+//------------------------------------------------------------------------------
+//
+// File Name:	DrawBucket.cpp
+// Author(s):	Jonathan Bourim (j.bourim)
+// Date:		10/19/2026
+//
+//------------------------------------------------------------------------------
+
+#include "DrawBucket.h"
+
+namespace dm
+{
+
+void DrawBucket::Reserve(std::size_t packetCount, std::size_t dataSize)
+{
+    packets.reserve(packetCount);
+    order.reserve(packetCount);
+    payloads.reserve((dataSize + sizeof(Block) - 1) / sizeof(Block));
+}
+
+void DrawBucket::Sort(ThreadPool* pool)
+{
+    // Entries are in submission order, which the stable radix sort keeps for equal keys
+    RadixSort(order, sortScratch, keyMask, pool);
+    sorted = true;
+}
+
+void DrawBucket::Record(CommandRecorder& recorder)
+{
+    if (!sorted)
+        Sort();
+
+    stats = {};
+    const CommandRecorder::Stats before = recorder.GetStats();
+    for (const SortEntry& entry : order)
+    {
+        const Packet& packet = packets[entry.index];
+        if (packet.pipeline && packet.pipeline != recorder.GetBoundPipeline())
+        {
+            recorder.BindPipeline(packet.pipeline, packet.layout);
+            ++stats.pipelineBinds;
+        }
+
+        packet.invoke(recorder, &payloads[packet.dataOffset]);
+        ++stats.packets;
+    }
+
+    stats.commands.issued = recorder.GetStats().issued - before.issued;
+    stats.commands.elided = recorder.GetStats().elided - before.elided;
+}
+
+void DrawBucket::Record(vk::CommandBuffer commandBuffer)
+{
+    CommandRecorder recorder(commandBuffer);
+    Record(recorder);
+}
+
+void DrawBucket::Clear()
+{
+    packets.clear();
+    order.clear();
+    payloads.clear();
+    sorted = true;
+}
+
+} // namespace dm
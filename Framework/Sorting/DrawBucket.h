@@ -0,0 +1,138 @@
+//------------------------------------------------------------------------------
+//
+// File Name:	DrawBucket.h
+// Author(s):	Jonathan Bourim (j.bourim)
+// Date:		10/19/2026
+//
+//------------------------------------------------------------------------------
+
+#pragma once
+
+namespace dm
+{
+
+/// \brief Collects draw packets tagged with a RenderSortKey, sorts them and records them in key order.
+///        Packet data is copied into the bucket, so it only needs to be valid for the duration of Submit.
+class DrawBucket
+{
+public:
+    template<class T>
+    using RecordFunction = void (*)(CommandRecorder& recorder, const T& data);
+
+    struct Stats
+    {
+        std::uint32_t packets = 0;          //< Packets recorded in the last Record
+        std::uint32_t pipelineBinds = 0;    //< Pipelines bound in the last Record
+        CommandRecorder::Stats commands;    //< Commands issued and elided by the recorder in the last Record
+    };
+
+    /// \brief Reserve space for a frame's worth of packets, avoiding reallocation while submitting.
+    /// \param packetCount Number of packets
+    /// \param dataSize Bytes of packet data
+    void Reserve(std::size_t packetCount, std::size_t dataSize = 0);
+
+    /// \brief Submit a draw packet.
+    /// \param key Sort key of the draw, see OpaqueSortKey and TranslucentSortKey
+    /// \param pipeline Pipeline bound before recording the packet if it differs from the previous packet's, null if the packet binds its own
+    /// \param record Records the packet's commands
+    /// \param data Packet data passed to record
+    /// \param layout Layout of pipeline, lets descriptor sets and push constants stay bound across pipeline changes
+    template<class T>
+    void Submit(RenderSortKey key, vk::Pipeline pipeline, RecordFunction<T> record, const T& data,
+                vk::PipelineLayout layout = {})
+    {
+        static_assert(std::is_trivially_copyable<T>::value && std::is_trivially_destructible<T>::value,
+                      "Draw packet data is copied into the bucket and never destroyed");
+        static_assert(alignof(Payload<T>) <= sizeof(Block), "Draw packet data is over-aligned");
+
+        const auto offset = static_cast<std::uint32_t>(payloads.size());
+        payloads.resize(payloads.size() + (sizeof(Payload<T>) + sizeof(Block) - 1) / sizeof(Block));
+        new (&payloads[offset]) Payload<T>{ record, data };
+
+        packets.push_back({ pipeline, layout, &Invoke<T>, offset });
+        order.push_back({ key, static_cast<std::uint32_t>(packets.size() - 1) });
+        sorted = false;
+    }
+
+    /// \brief Submit a mesh, bound and drawn by the packet.
+    template<class VertexType>
+    void SubmitMesh(RenderSortKey key, vk::Pipeline pipeline, const Mesh<VertexType>& mesh,
+                    vk::PipelineLayout layout = {})
+    {
+        const Mesh<VertexType>* meshPtr = &mesh;
+        Submit<const Mesh<VertexType>*>(key, pipeline, &RecordMesh<VertexType>, meshPtr, layout);
+    }
+
+    /// \brief Restrict sorting to the bits used by the given layouts, skipping radix passes over the rest.
+    ///        Every submitted key must then be composed through one of these layouts.
+    template<class... Layouts>
+    void SetKeyLayouts()
+    {
+        keyMask = (Layouts::usedMask | ...);
+    }
+
+    /// \brief Sort packets by key, packets with equal keys keep their submission order.
+    /// \param pool Optional thread pool to sort with
+    void Sort(ThreadPool* pool = nullptr);
+
+    /// \brief Record every packet in key order, sorting first if needed.
+    ///        Redundant binds between packets are elided by the recorder.
+    void Record(CommandRecorder& recorder);
+    void Record(vk::CommandBuffer commandBuffer);
+
+    /// \brief Remove all packets, keeping allocated memory for the next frame.
+    void Clear();
+
+    [[nodiscard]] std::size_t Size() const { return packets.size(); }
+    [[nodiscard]] const Stats& GetStats() const { return stats; }
+
+    using SortEntry = RenderSortEntry;     //< Index is the packet's submission index
+
+    /// \brief Packets in their current order, key order after Sort.
+    [[nodiscard]] const std::vector<SortEntry>& GetOrder() const { return order; }
+
+private:
+    struct alignas(16) Block
+    {
+        unsigned char bytes[16];
+    };
+
+    template<class T>
+    struct Payload
+    {
+        RecordFunction<T> record;
+        T data;
+    };
+
+    struct Packet
+    {
+        vk::Pipeline pipeline;
+        vk::PipelineLayout layout;
+        void (*invoke)(CommandRecorder& recorder, const void* payload);
+        std::uint32_t dataOffset;   //< Offset of the packet's payload in blocks
+    };
+
+    template<class T>
+    static void Invoke(CommandRecorder& recorder, const void* payload)
+    {
+        const auto& typed = *static_cast<const Payload<T>*>(payload);
+        typed.record(recorder, typed.data);
+    }
+
+    template<class VertexType>
+    static void RecordMesh(CommandRecorder& recorder, const Mesh<VertexType>* const& mesh)
+    {
+        mesh->Bind(recorder);
+        mesh->Draw(recorder);
+    }
+
+    std::vector<Packet> packets;
+    std::vector<SortEntry> order;
+    std::vector<SortEntry> sortScratch;
+    std::uint64_t keyMask = ~std::uint64_t(0);
+    std::vector<Block> payloads;   //< Packet data, each payload starts on a block boundary
+    Stats stats;
+    bool sorted = true;
+};
+
+} // namespace dm
@@ -10,6 +10,31 @@ namespace dm
     template<class T>
     using DepthSortKey = RenderSortKeyElement<T, 8, 8 + 10>;
 
+    template<class T>
+    using MaterialSortKey = RenderSortKeyElement<T, 40, 40 + 16>;
+
+    template<class T>
+    using PipelineSortKey = RenderSortKeyElement<T, 56, 56 + 7>;
+
+    /// \brief Most significant bit, sorts every opaque draw before any translucent one
+    using TranslucencySortKey = RenderSortKeyElement<struct TranslucencySortTag, 63, 64>;
+
+    /// \brief Opaque draws group by state first, then roughly front to back
+    using OpaqueSortKeyLayout = RenderSortKeyLayout<
+        TranslucencySortKey,
+        PipelineSortKey<struct OpaqueSortTag>,
+        MaterialSortKey<struct OpaqueSortTag>,
+        DepthSortKey<struct OpaqueSortTag>,
+        MeshSortKey<struct OpaqueSortTag>>;
+
+    /// \brief Translucent draws must blend back to front, so depth precedes state
+    using TranslucentSortKeyLayout = RenderSortKeyLayout<
+        TranslucencySortKey,
+        RenderSortKeyElement<struct TranslucentDepthSortTag, 53, 53 + 10>,
+        RenderSortKeyElement<struct TranslucentPipelineSortTag, 46, 46 + 7>,
+        RenderSortKeyElement<struct TranslucentMaterialSortTag, 30, 30 + 16>,
+        MeshSortKey<struct TranslucentSortTag>>;
+
     // Adapted from: https://aras-p.info/blog/2014/01/16/rough-sorting-by-depth/
 
     /// \brief Flips the bits of unsigned int (float val) and makes them sortable
@@ -32,4 +57,25 @@ namespace dm
         std::uint16_t b = f2i.i >> 22;  // Takes the highest 10 bits
         return b;
     }
+
+    /// \brief Compose the key of an opaque draw.
+    /// \param pipeline Pipeline sort key
+    /// \param material Material sort key
+    /// \param mesh Mesh sort key
+    /// \param depth View depth of the draw
+    inline RenderSortKey OpaqueSortKey(std::uint8_t pipeline, std::uint16_t material, std::uint8_t mesh, float depth)
+    {
+        return OpaqueSortKeyLayout::Compose(0, pipeline, material, DepthToBits(depth), mesh);
+    }
+
+    /// \brief Compose the key of a translucent draw, with depth inverted so the furthest draws come first.
+    /// \param pipeline Pipeline sort key
+    /// \param material Material sort key
+    /// \param mesh Mesh sort key
+    /// \param depth View depth of the draw
+    inline RenderSortKey TranslucentSortKey(std::uint8_t pipeline, std::uint16_t material, std::uint8_t mesh, float depth)
+    {
+        std::uint16_t invertedDepth = ~DepthToBits(depth) & 0x3FFu;
+        return TranslucentSortKeyLayout::Compose(1, invertedDepth, pipeline, material, mesh);
+    }
 }
\ No newline at end of file
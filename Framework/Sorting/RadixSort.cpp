@@ -0,0 +1,159 @@
+//------------------------------------------------------------------------------
+//
+// File Name:	RadixSort.cpp
+// Author(s):	Jonathan Bourim (j.bourim)
+// Date:		10/19/2026
+//
+//------------------------------------------------------------------------------
+
+#include "RadixSort.h"
+
+namespace dm
+{
+
+namespace
+{
+
+constexpr std::size_t RadixBuckets = 256;
+constexpr std::size_t KeyBytes = sizeof(std::uint64_t);
+constexpr std::size_t ComparisonSortThreshold = 256;    //< Below this, setting up passes costs more than it saves
+constexpr std::size_t MinEntriesPerChunk = 16384;       //< Below this per thread, synchronization outweighs the work
+
+using Histogram = std::array<std::uint32_t, RadixBuckets>;
+
+inline std::uint32_t KeyByte(const RenderSortEntry& entry, std::size_t byte)
+{
+    return static_cast<std::uint32_t>(entry.key.key >> (byte * 8)) & 0xFFu;
+}
+
+}
+
+void RadixSort(
+    std::vector<RenderSortEntry>& entries,
+    std::vector<RenderSortEntry>& scratch,
+    std::uint64_t keyMask,
+    ThreadPool* pool
+)
+{
+    const std::size_t count = entries.size();
+    if (count < ComparisonSortThreshold)
+    {
+        std::stable_sort(entries.begin(), entries.end(), [](const RenderSortEntry& a, const RenderSortEntry& b)
+        {
+            return a.key.key < b.key.key;
+        });
+        return;
+    }
+
+    scratch.resize(count);
+
+    // Split into contiguous chunks, each owning its slice of every bucket so scatter stays stable
+    std::size_t chunkCount = 1;
+    if (pool != nullptr)
+        chunkCount = std::clamp<std::size_t>(count / MinEntriesPerChunk, 1, pool->GetConcurrency());
+    const std::size_t chunkSize = (count + chunkCount - 1) / chunkCount;
+
+    auto dispatch = [pool, chunkCount](const std::function<void(std::uint32_t)>& func)
+    {
+        if (chunkCount > 1)
+            pool->Dispatch(static_cast<std::uint32_t>(chunkCount), func);
+        else
+            func(0);
+    };
+
+    // Histogram every candidate byte in one read, any byte with a single populated bucket is constant
+    std::vector<std::array<Histogram, KeyBytes>> chunkHistograms(chunkCount);
+    dispatch([&](std::uint32_t chunk)
+    {
+        auto& histograms = chunkHistograms[chunk];
+        for (auto& histogram : histograms)
+            histogram.fill(0);
+
+        const std::size_t begin = chunk * chunkSize;
+        const std::size_t end = std::min(begin + chunkSize, count);
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            const std::uint64_t key = entries[i].key.key;
+            for (std::size_t byte = 0; byte < KeyBytes; ++byte)
+                ++histograms[byte][(key >> (byte * 8)) & 0xFFu];
+        }
+    });
+
+    std::array<bool, KeyBytes> activeBytes = {};
+    for (std::size_t byte = 0; byte < KeyBytes; ++byte)
+    {
+        if (((keyMask >> (byte * 8)) & 0xFFu) == 0)
+            continue;
+
+        const std::uint32_t first = KeyByte(entries[0], byte);
+        std::size_t total = 0;
+        for (const auto& histograms : chunkHistograms)
+            total += histograms[byte][first];
+
+        activeBytes[byte] = total != count;
+    }
+
+    // Per chunk write offsets, reused between passes
+    std::vector<Histogram> offsets(chunkCount);
+    std::vector<Histogram> passHistograms(chunkCount);
+    std::vector<RenderSortEntry>* source = &entries;
+    std::vector<RenderSortEntry>* destination = &scratch;
+    bool firstPass = true;
+
+    for (std::size_t byte = 0; byte < KeyBytes; ++byte)
+    {
+        if (!activeBytes[byte])
+            continue;
+
+        // The initial histograms describe the original order, later passes count the permuted chunks again
+        if (firstPass)
+        {
+            for (std::size_t chunk = 0; chunk < chunkCount; ++chunk)
+                passHistograms[chunk] = chunkHistograms[chunk][byte];
+        }
+        else
+        {
+            dispatch([&](std::uint32_t chunk)
+            {
+                Histogram& histogram = passHistograms[chunk];
+                histogram.fill(0);
+
+                const std::size_t begin = chunk * chunkSize;
+                const std::size_t end = std::min(begin + chunkSize, count);
+                for (std::size_t i = begin; i < end; ++i)
+                    ++histogram[KeyByte((*source)[i], byte)];
+            });
+        }
+
+        // Bucket major, chunk minor prefix sum keeps equal keys in chunk order
+        std::uint32_t offset = 0;
+        for (std::size_t bucket = 0; bucket < RadixBuckets; ++bucket)
+        {
+            for (std::size_t chunk = 0; chunk < chunkCount; ++chunk)
+            {
+                offsets[chunk][bucket] = offset;
+                offset += passHistograms[chunk][bucket];
+            }
+        }
+
+        dispatch([&](std::uint32_t chunk)
+        {
+            Histogram& chunkOffsets = offsets[chunk];
+            const std::size_t begin = chunk * chunkSize;
+            const std::size_t end = std::min(begin + chunkSize, count);
+            const RenderSortEntry* in = source->data();
+            RenderSortEntry* out = destination->data();
+            for (std::size_t i = begin; i < end; ++i)
+                out[chunkOffsets[KeyByte(in[i], byte)]++] = in[i];
+        });
+
+        std::swap(source, destination);
+        firstPass = false;
+    }
+
+    // Odd number of passes leaves the result in scratch
+    if (source != &entries)
+        entries.swap(scratch);
+}
+
+} // namespace dm
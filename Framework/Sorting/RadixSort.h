@@ -0,0 +1,36 @@
+//------------------------------------------------------------------------------
+//
+// File Name:	RadixSort.h
+// Author(s):	Jonathan Bourim (j.bourim)
+// Date:		10/19/2026
+//
+//------------------------------------------------------------------------------
+
+#pragma once
+
+namespace dm
+{
+
+class ThreadPool;
+
+/// \brief RenderSortKey paired with the index of the payload it sorts.
+struct RenderSortEntry
+{
+    RenderSortKey key;
+    std::uint32_t index;    //< Index of the payload, typically in submission order
+};
+
+/// \brief Stable LSD radix sort of entries by key, one pass per key byte.
+///        Bytes outside of keyMask, and bytes every key shares, are skipped entirely.
+/// \param entries Entries to sort, sorted in place
+/// \param scratch Scratch storage, resized to match entries and reusable across frames
+/// \param keyMask Bits that may vary between keys, e.g. RenderSortKeyLayout::usedMask. Bits outside must be equal in all keys.
+/// \param pool Optional thread pool for the histogram and scatter phases
+void RadixSort(
+    std::vector<RenderSortEntry>& entries,
+    std::vector<RenderSortEntry>& scratch,
+    std::uint64_t keyMask = ~std::uint64_t(0),
+    ThreadPool* pool = nullptr
+);
+
+} // namespace dm
@@ -9,6 +9,8 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
+#include <type_traits>
 
 namespace dm
 {
@@ -34,10 +36,14 @@ using UIntSelector = typename std::conditional<NumBytes == 1, std::uint8_t, type
 template<typename T, std::uint8_t BitStart, std::uint8_t BitEnd>
 struct RenderSortKeyElement
 {
-    using keyType = UIntSelector<(BitEnd - BitStart) / 8>; //< Type of our key based on the num of bits required.
+    static_assert(BitStart < BitEnd && BitEnd <= 64, "RenderSortKeyElement range must be non-empty and fit in 64 bits");
+
+    using keyType = UIntSelector<(BitEnd - BitStart + 7) / 8>; //< Type of our key based on the num of bits required, rounded up to whole bytes.
 
     static constexpr std::uint8_t offset = { BitStart };                  //< Offset in bits from the least significant bit in RenderSortKey.
     static constexpr std::uint64_t mask = { BitRange(BitStart, BitEnd) }; //< RenderSortKey Visibility bitmask for this RenderSortKeyElement.
+    static constexpr std::uint8_t bits = { BitEnd - BitStart };            //< Number of bits this element occupies.
+    static constexpr std::uint64_t maxKey = { mask >> BitStart };          //< Largest key representable in this element's range.
 
     /// \brief Generate a unique key for this element.
     /// \return Unique key.
@@ -93,7 +99,18 @@ struct RenderSortKey
     void Set(T element)
     {
         std::uint64_t elementKey = (std::uint64_t) element.key;
-        key = (key & (~T::mask)) | (elementKey << T::offset);
+        key = (key & (~T::mask)) | ((elementKey << T::offset) & T::mask);
+    }
+
+    /// \brief Read back a given element of the render sort key.
+    /// \tparam T Render Sort Key Element Type
+    /// \return Element key stored in the render sort key
+    template<typename T>
+    [[nodiscard]] T Get() const
+    {
+        T element;
+        element.key = static_cast<typename T::keyType>((key & T::mask) >> T::offset);
+        return element;
     }
 
     operator std::uint64_t () const
@@ -104,5 +121,59 @@ struct RenderSortKey
     std::uint64_t key = { 0 };  //< Sorting key for bucketing rendering
 };
 
+/// \brief Check that no two ranges in a set of element masks overlap.
+/// \param masks Element masks
+/// \param count Number of masks
+/// \return True if every bit is claimed by at most one mask
+constexpr bool RenderSortKeyMasksDisjoint(const std::uint64_t* masks, std::size_t count)
+{
+    std::uint64_t used = 0;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        if ((used & masks[i]) != 0)
+            return false;
+        used |= masks[i];
+    }
+    return true;
+}
+
+/// \brief Check that element offsets are strictly descending.
+/// \param offsets Element offsets
+/// \param count Number of offsets
+/// \return True if each offset is greater than the next
+constexpr bool RenderSortKeyOffsetsDescending(const std::uint8_t* offsets, std::size_t count)
+{
+    for (std::size_t i = 1; i < count; ++i)
+    {
+        if (offsets[i - 1] <= offsets[i])
+            return false;
+    }
+    return true;
+}
+
+/// \brief Compile-time validated composition of RenderSortKeyElements into a RenderSortKey.
+///        Elements are listed from most to least significant, which is asserted along with their ranges not overlapping.
+/// \tparam Elements Render Sort Key Element Types making up the key
+template<typename... Elements>
+struct RenderSortKeyLayout
+{
+    static constexpr std::uint64_t masks[] = { Elements::mask... };
+    static constexpr std::uint8_t offsets[] = { Elements::offset... };
+    static constexpr std::uint64_t usedMask = { (Elements::mask | ...) };  //< Bits any key of this layout may set
+
+    static_assert(sizeof...(Elements) > 0, "RenderSortKeyLayout requires at least one element");
+    static_assert(RenderSortKeyMasksDisjoint(masks, sizeof...(Elements)), "RenderSortKeyLayout elements have overlapping bit ranges");
+    static_assert(RenderSortKeyOffsetsDescending(offsets, sizeof...(Elements)), "RenderSortKeyLayout elements must be listed from most to least significant");
+
+    /// \brief Compose a key from each element's key, in the order of the layout's elements.
+    /// \return Composed render sort key
+    static RenderSortKey Compose(typename Elements::keyType... keys)
+    {
+        RenderSortKey result;
+        (result.Set(Elements{ keys }), ...);
+        return result;
+    }
+};
+
 
 } // namespace dm
\ No newline at end of file
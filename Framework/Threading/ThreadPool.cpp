@@ -0,0 +1,113 @@
+//------------------------------------------------------------------------------
+//
+// File Name:	ThreadPool.cpp
+// Author(s):	Jonathan Bourim (j.bourim)
+// Date:		10/19/2026
+//
+//------------------------------------------------------------------------------
+#include "ThreadPool.h"
+
+namespace dm
+{
+
+void ThreadPool::Create(uint32_t workerCount)
+{
+    DM_ASSERT_MSG(workers.empty(), "Creating an existing thread pool");
+    stopping = false;
+    workers.reserve(workerCount);
+    for (uint32_t i = 0; i < workerCount; ++i)
+        workers.emplace_back(&ThreadPool::RunWorker, this);
+}
+
+void ThreadPool::Destroy()
+{
+    {
+        std::lock_guard<std::mutex> lock(taskMutex);
+        stopping = true;
+    }
+    taskCondition.notify_all();
+
+    for (auto& worker : workers)
+        worker.join();
+    workers.clear();
+}
+
+ThreadPool::~ThreadPool()
+{
+    Destroy();
+}
+
+void ThreadPool::Dispatch(uint32_t taskCount, const std::function<void(uint32_t)>& func)
+{
+    if (taskCount == 0)
+        return;
+
+    const uint32_t helperCount = std::min(static_cast<uint32_t>(workers.size()), taskCount - 1);
+    if (helperCount == 0)
+    {
+        for (uint32_t i = 0; i < taskCount; ++i)
+            func(i);
+        return;
+    }
+
+    // Helpers and the caller pull task indices until all are claimed. Completion is tracked per task rather
+    // than per helper, so helpers still queued behind other work never hold up the caller (or nested dispatches).
+    struct State
+    {
+        std::atomic<uint32_t> next = 0;
+        std::atomic<uint32_t> completed = 0;
+        uint32_t taskCount = 0;
+        const std::function<void(uint32_t)>* func = nullptr;
+        std::mutex mutex;
+        std::condition_variable condition;
+    };
+
+    auto state = std::make_shared<State>();
+    state->taskCount = taskCount;
+    state->func = &func;
+
+    auto run = [state]()
+    {
+        for (uint32_t i = state->next++; i < state->taskCount; i = state->next++)
+        {
+            (*state->func)(i);
+            if (++state->completed == state->taskCount)
+            {
+                std::lock_guard<std::mutex> lock(state->mutex);
+                state->condition.notify_all();
+            }
+        }
+    };
+
+    {
+        std::lock_guard<std::mutex> lock(taskMutex);
+        for (uint32_t i = 0; i < helperCount; ++i)
+            tasks.emplace(run);
+    }
+    taskCondition.notify_all();
+
+    run();
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->condition.wait(lock, [&state]() { return state->completed == state->taskCount; });
+}
+
+void ThreadPool::RunWorker()
+{
+    while (true)
+    {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(taskMutex);
+            taskCondition.wait(lock, [this]() { return stopping || !tasks.empty(); });
+            if (stopping && tasks.empty())
+                return;
+
+            task = std::move(tasks.front());
+            tasks.pop();
+        }
+
+        task();
+    }
+}
+
+}
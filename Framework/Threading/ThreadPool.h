@@ -0,0 +1,67 @@
+//------------------------------------------------------------------------------
+//
+// File Name:	ThreadPool.h
+// Author(s):	Jonathan Bourim (j.bourim)
+// Date:        10/19/2026
+//
+//------------------------------------------------------------------------------
+#pragma once
+
+namespace dm
+{
+
+/**
+ * Fixed set of worker threads for fork/join work (Dispatch) and background tasks (Submit).
+ * The calling thread participates in Dispatch, so a pool created with no workers runs everything inline.
+ */
+class ThreadPool
+{
+public:
+    ThreadPool() = default;
+    ThreadPool(const ThreadPool& other) = delete;
+    ThreadPool& operator=(const ThreadPool& other) = delete;
+    ~ThreadPool();
+
+    /// \brief Start the worker threads.
+    /// \param workerCount Number of threads in addition to the caller, defaults to one per remaining hardware thread
+    void Create(uint32_t workerCount = std::max(std::thread::hardware_concurrency(), 1u) - 1);
+    void Destroy();
+
+    /// \brief Run func(taskIndex) for every taskIndex in [0, taskCount), returning once all have completed.
+    void Dispatch(uint32_t taskCount, const std::function<void(uint32_t)>& func);
+
+    /// \brief Run func on a worker thread, inline if the pool has no workers.
+    template <class Func>
+    auto Submit(Func&& func) -> std::future<decltype(func())>
+    {
+        using Result = decltype(func());
+        auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<Func>(func));
+        std::future<Result> result = task->get_future();
+        if (workers.empty())
+        {
+            (*task)();
+            return result;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(taskMutex);
+            tasks.emplace([task]() { (*task)(); });
+        }
+        taskCondition.notify_one();
+        return result;
+    }
+
+    /// \brief Number of threads participating in Dispatch, including the caller.
+    [[nodiscard]] uint32_t GetConcurrency() const { return static_cast<uint32_t>(workers.size()) + 1; }
+
+private:
+    void RunWorker();
+
+    std::vector<std::thread> workers;
+    std::queue<std::function<void()>> tasks;
+    std::mutex taskMutex;
+    std::condition_variable taskCondition;
+    bool stopping = false;
+};
+
+}